@@ -6,6 +6,8 @@
 
 #include "libcineon/Cineon.h"
 
+#include "../dpx.imageio/dpx_pvt.h"
+
 #include <OpenImageIO/dassert.h>
 #include <OpenImageIO/imageio.h>
 #include <OpenImageIO/strutil.h>
@@ -25,6 +27,8 @@ public:
     bool close() override;
     bool read_native_scanline(int subimage, int miplevel, int y, int z,
                               void* data) override;
+    bool read_native_scanlines(int subimage, int miplevel, int ybegin, int yend,
+                               int z, void* data) override;
 
 private:
     InStream* m_stream = nullptr;
@@ -43,6 +47,10 @@ private:
         m_userBuf.clear();
     }
 
+    /// Is the image 10-bit filled data that read_native_scanlines can
+    /// unpack itself, rather than a scanline at a time through libcineon?
+    bool is_10bit_filled() const;
+
     /// Helper function - retrieve string for libcineon descriptor
     ///
     char* get_descriptor_string(cineon::Descriptor c);
@@ -386,6 +394,58 @@ CineonInput::read_native_scanline(int subimage, int miplevel, int y, int /*z*/,
 
 
 
+bool
+CineonInput::is_10bit_filled() const
+{
+    const cineon::Header& h(m_cin.header);
+    if (h.ComponentDataSize(0) != cineon::kWord || h.EndOfLinePadding() != 0
+        || (h.ImagePacking() != cineon::kLongWordLeft
+            && h.ImagePacking() != cineon::kLongWordRight))
+        return false;
+    for (int i = 0; i < h.NumberOfElements(); i++)
+        if (h.BitDepth(i) != 10 || h.PixelsPerLine(i) != h.Width())
+            return false;
+    return true;
+}
+
+
+
+bool
+CineonInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
+                                   int yend, int z, void* data)
+{
+    lock_guard lock(*this);
+    if (!seek_subimage(subimage, miplevel))
+        return false;
+    if (!is_10bit_filled() || yend - ybegin < 2)
+        return ImageInput::read_native_scanlines(subimage, miplevel, ybegin,
+                                                 yend, z, data);
+
+    // The whole range of scanlines is contiguous in the file, so read it
+    // with one call and unpack it in parallel, rather than seeking, reading
+    // and unpacking one datum at a time for each scanline.
+    const size_t datums    = size_t(m_spec.width) * m_spec.nchannels;
+    const size_t linebytes = DPX_pvt::filled_10bit_line_bytes(datums);
+    const size_t nlines    = size_t(yend - ybegin);
+    const size_t bytes     = nlines * linebytes;
+    std::unique_ptr<uint32_t[]> buf(new uint32_t[bytes / 4]);
+    long offset = long(m_cin.header.ImageOffset() + ybegin * linebytes);
+    if (!m_stream->Seek(offset, InStream::kStart)
+        || m_stream->Read(buf.get(), bytes) != bytes) {
+        errorfmt("Cineon read error: could not read scanlines {}-{}", ybegin,
+                 yend - 1);
+        return false;
+    }
+    int pad = m_cin.header.ImagePacking() == cineon::kLongWordLeft ? 2 : 0;
+    DPX_pvt::unpack_10bit_filled_lines(buf.get(), (uint16_t*)data, nlines,
+                                       datums, pad, false,
+                                       m_cin.header.RequiresByteSwap(),
+                                       threads());
+    return true;
+}
+
+
+
 char*
 CineonInput::get_descriptor_string(cineon::Descriptor c)
 {
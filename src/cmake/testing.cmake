@@ -268,6 +268,7 @@ macro (oiio_add_all_tests)
         if (OIIO_BUILD_PYTHON_PYBIND11)
             oiio_add_tests (
                 docs-examples-python
+                python-channel-subsets
                 python-colorconfig
                 python-deep
                 python-imagebuf
@@ -0,0 +1,158 @@
+// Copyright Contributors to the OpenImageIO project.
+// SPDX-License-Identifier: Apache-2.0
+// https://github.com/AcademySoftwareFoundation/OpenImageIO
+
+#pragma once
+
+#include <cstdint>
+
+#include <OpenImageIO/fmath.h>
+#include <OpenImageIO/imageio.h>
+#include <OpenImageIO/parallel.h>
+#include <OpenImageIO/simd.h>
+
+
+// Fast paths for the 10-bit "filled" layouts used by nearly every DPX and
+// Cineon file in the wild: three 10-bit datums per 32-bit word, with two
+// pad bits either at the bottom (DPX method A / Cineon "long word left") or
+// at the top (DPX method B / Cineon "long word right") of the word.
+//
+// libdpx and libcineon unpack these one datum at a time, a scanline at a
+// time, with a single-threaded seek+read per line. The helpers here do the
+// same bit shuffling four words at a time with SIMD, and let the plugins
+// split the image into bands of scanlines that are read and unpacked in
+// parallel. They produce bit-identical results to the libraries, including
+// their datum ordering quirks (see the `lowfirst` parameters below), so the
+// plugins can fall back to the library code for anything unusual.
+
+OIIO_PLUGIN_NAMESPACE_BEGIN
+
+namespace DPX_pvt {
+
+// Aim for roughly this many bytes of packed file data per parallel task.
+constexpr size_t parallel_band_bytes = 1 << 20;
+
+
+// Number of bytes in one line of `datums` 10-bit filled values.
+inline size_t
+filled_10bit_line_bytes(size_t datums)
+{
+    return (datums + 2) / 3 * 4;
+}
+
+
+
+// Shift amounts of the three datums within a filled word. With `lowfirst`
+// false, the first datum occupies the most significant bits (the layout
+// the DPX and Cineon specs describe); with it true, the first datum
+// occupies the least significant bits.
+inline void
+filled_10bit_shifts(int pad, bool lowfirst, int shift[3])
+{
+    shift[0] = pad + (lowfirst ? 0 : 20);
+    shift[1] = pad + 10;
+    shift[2] = pad + (lowfirst ? 20 : 0);
+}
+
+
+
+// Unpack `ndatums` 10-bit values from filled words `src` into `dst`,
+// expanding each to 16 bits by bit replication, exactly as libdpx's
+// BaseTypeConvertU10ToU16 does.
+inline void
+unpack_10bit_filled(const uint32_t* src, uint16_t* dst, size_t ndatums,
+                    int pad, bool lowfirst)
+{
+    int shift[3];
+    filled_10bit_shifts(pad, lowfirst, shift);
+    size_t i = 0;
+    // Four words (12 datums) at a time. After the transpose, each vector
+    // holds the three datums of one word in lanes 0-2. The 4-wide stores
+    // overlap by one lane, so stop one datum early to keep the last store
+    // in bounds.
+    const simd::vint4 mask(0x3ff);
+    for (; i + 12 < ndatums; i += 12) {
+        simd::vint4 w((const int*)(src + i / 3));
+        simd::vint4 a = simd::srl(w, shift[0]) & mask;
+        simd::vint4 b = simd::srl(w, shift[1]) & mask;
+        simd::vint4 c = simd::srl(w, shift[2]) & mask;
+        a             = (a << 6) | simd::srl(a, 4);
+        b             = (b << 6) | simd::srl(b, 4);
+        c             = (c << 6) | simd::srl(c, 4);
+        simd::vint4 d = simd::vint4::Zero();
+        simd::transpose(a, b, c, d);
+        a.store(dst + i);
+        b.store(dst + i + 3);
+        c.store(dst + i + 6);
+        d.store(dst + i + 9);
+    }
+    for (; i < ndatums; ++i) {
+        uint32_t v = (src[i / 3] >> shift[i % 3]) & 0x3ff;
+        dst[i]     = uint16_t((v << 6) | (v >> 4));
+    }
+}
+
+
+
+// Pack `ndatums` 16-bit values from `src` into 10-bit filled words `dst`,
+// keeping the top 10 bits of each value. Unused datums of a partial last
+// word are zero.
+inline void
+pack_10bit_filled(const uint16_t* src, uint32_t* dst, size_t ndatums,
+                  int pad, bool lowfirst)
+{
+    int shift[3];
+    filled_10bit_shifts(pad, lowfirst, shift);
+    size_t i = 0;
+    // Gather four words' worth of datums with overlapping 4-wide loads
+    // (lane 3 of each is ignored), then transpose so that each vector holds
+    // the same datum position of four consecutive words.
+    for (; i + 12 < ndatums; i += 12) {
+        simd::vint4 a(src + i), b(src + i + 3), c(src + i + 6), d(src + i + 9);
+        simd::transpose(a, b, c, d);
+        simd::vint4 w = (simd::srl(a, 6) << shift[0])
+                        | (simd::srl(b, 6) << shift[1])
+                        | (simd::srl(c, 6) << shift[2]);
+        w.store((int*)(dst + i / 3));
+    }
+    for (; i < ndatums; i += 3) {
+        uint32_t w = 0;
+        for (size_t k = 0; k < 3 && i + k < ndatums; ++k)
+            w |= uint32_t(src[i + k] >> 6) << shift[k];
+        dst[i / 3] = w;
+    }
+}
+
+
+
+// Unpack `nlines` lines of `datums` values each. Lines in `src` are
+// padded to whole words; lines in `dst` are contiguous. If `swap` is true,
+// the words of `src` are byte swapped in place first. Lines are split into
+// bands that are processed in parallel using up to `nthreads` threads.
+inline void
+unpack_10bit_filled_lines(uint32_t* src, uint16_t* dst, size_t nlines,
+                          size_t datums, int pad, bool lowfirst, bool swap,
+                          int nthreads = 0)
+{
+    size_t linewords = filled_10bit_line_bytes(datums) / 4;
+    size_t bandlines = std::max(size_t(1), parallel_band_bytes
+                                               / (linewords * 4));
+    int64_t nbands   = int64_t((nlines + bandlines - 1) / bandlines);
+    parallel_for_chunked(
+        0, nbands, 1,
+        [&](int64_t b, int64_t e) {
+            for (size_t y = b * bandlines; y < std::min(e * bandlines, nlines);
+                 ++y) {
+                uint32_t* s = src + y * linewords;
+                if (swap)
+                    swap_endian(s, int(linewords));
+                unpack_10bit_filled(s, dst + y * datums, datums, pad,
+                                    lowfirst);
+            }
+        },
+        paropt(nthreads));
+}
+
+}  // namespace DPX_pvt
+
+OIIO_PLUGIN_NAMESPACE_END
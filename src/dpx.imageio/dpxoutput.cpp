@@ -12,6 +12,8 @@
 #include "libdpx/DPX.h"
 #include "libdpx/DPXColorConverter.h"
 
+#include "dpx_pvt.h"
+
 #include <OpenImageIO/color.h>
 #include <OpenImageIO/fmath.h>
 #include <OpenImageIO/imageio.h>
@@ -89,6 +91,10 @@ private:
     // flush the pending buffer
     bool write_buffer();
 
+    // Pack the pending buffer as 10-bit filled data in parallel and write
+    // it, if its layout allows. Returns false if it can't, without writing.
+    bool write_10bit_filled(bool& ok);
+
     bool prep_subimage(int s, bool allocate);
 
     /// Helper function - retrieve libdpx descriptor for string
@@ -563,7 +569,8 @@ DPXOutput::write_buffer()
 
     bool ok = true;
     if (m_write_pending && m_buf.size()) {
-        ok = m_dpx.WriteElement(m_subimage, m_buf.data(), m_datasize);
+        if (!write_10bit_filled(ok))
+            ok = m_dpx.WriteElement(m_subimage, m_buf.data(), m_datasize);
         if (!ok) {
             const char* err = strerror(errno);
             errorfmt("DPX write failed ({})",
@@ -576,6 +583,61 @@ DPXOutput::write_buffer()
 
 
 
+bool
+DPXOutput::write_10bit_filled(bool& ok)
+{
+    const dpx::Header& h(m_dpx.header);
+    const int s          = m_subimage;
+    const dpx::Packing p = h.ImagePacking(s);
+    const int nchannels  = h.ImageElementComponentCount(s);
+    const size_t datums  = size_t(h.Width()) * nchannels;
+    if (h.BitDepth(s) != 10 || m_datasize != dpx::kWord
+        || (p != dpx::kFilledMethodA && p != dpx::kFilledMethodB)
+        || h.ImageEncoding(s) == dpx::kRLE || h.EndOfLinePadding(s) != 0
+        || h.EndOfImagePadding(s) != 0
+        || m_bytes != int64_t(datums * sizeof(uint16_t)))
+        return false;
+
+    // Match libdpx's datum order: it reverses the datums of each word
+    // (writing the first in the high bits) for RGB elements with datum
+    // swapping on, and flips that again for 4-channel elements.
+    bool reverse = h.ImageDescriptor(s) == dpx::kRGB && h.DatumSwap(s);
+    if (nchannels == 4)
+        reverse = !reverse;
+    const int pad          = p == dpx::kFilledMethodA ? 2 : 0;
+    const bool lowfirst    = !reverse;
+    const bool swap        = h.RequiresByteSwap();
+    const size_t height    = h.Height();
+    const size_t linewords = DPX_pvt::filled_10bit_line_bytes(datums) / 4;
+    const uint16_t* src    = (const uint16_t*)m_buf.data();
+    const size_t bandlines = std::max(size_t(1), DPX_pvt::parallel_band_bytes
+                                                     / (linewords * 4));
+    std::unique_ptr<uint32_t[]> packed(new uint32_t[height * linewords]);
+    parallel_for_chunked(
+        0, int64_t((height + bandlines - 1) / bandlines), 1,
+        [&](int64_t b, int64_t e) {
+            size_t yend = std::min(size_t(e) * bandlines, height);
+            for (size_t y = size_t(b) * bandlines; y < yend; ++y) {
+                uint32_t* dst = packed.get() + y * linewords;
+                DPX_pvt::pack_10bit_filled(src + y * datums, dst, datums, pad,
+                                           lowfirst);
+                if (swap)
+                    swap_endian(dst, int(linewords));
+            }
+        },
+        paropt(threads()));
+
+    ok = m_dpx.WriteElement(s, packed.get(),
+                            long(height * linewords * sizeof(uint32_t)));
+    // The raw WriteElement doesn't record the image offset the way the
+    // converting one does.
+    if (ok && s == 0)
+        m_dpx.header.SetImageOffset(h.DataOffset(0));
+    return true;
+}
+
+
+
 bool
 DPXOutput::close()
 {
@@ -1688,6 +1688,25 @@ std::string OIIO_API computePixelHashSHA1 (const ImageBuf &src,
                                            int blocksize = 0, int nthreads=0);
 
 
+/// Compute a fast, non-cryptographic 64-bit hash of all the pixels in the
+/// specified region of the image, returned as a 16-character hexadecimal
+/// string. The `algorithm` may be "xxhash" (XXH64) or "farmhash"
+/// (farmhash Fingerprint64); both are many times faster than SHA-1 and
+/// their results are stable across platforms and releases. The pixels
+/// are hashed as a tree of fixed-size blocks of scanlines, in parallel
+/// using `nthreads` threads (0 means the global OIIO thread count), but the
+/// block layout depends only on the image dimensions, so the result does
+/// not depend on the number of threads. The `extrainfo` provides
+/// additional text that will be incorporated into the hash.
+///
+/// If the algorithm is not recognized, an empty string is returned and an
+/// error message will be retrievable from src.geterror().
+std::string OIIO_API computePixelHash (const ImageBuf &src,
+                                       string_view algorithm = "xxhash",
+                                       string_view extrainfo = "",
+                                       ROI roi={}, int nthreads=0);
+
+
 /// Compute a histogram of `src`, for the given channel and ROI. Return a
 /// vector of length `bins` that contains the counts of how many pixel
 /// values were in each of `bins` equally spaced bins covering the range of
@@ -2316,6 +2335,8 @@ bool OIIO_API repremult (ImageBuf &dst, const ImageBuf &src,
 ///     - `linear` - simple bilinear demosaicing. Fast, but can produce artefacts along sharp edges.
 ///     - `MHC` - Malvar-He-Cutler linear demosaicing algorithm. Slower than `linear`, but produces 
 ///       significantly better results.
+///     - `RCD` - Ratio Corrected Demosaicing. Several times slower than `MHC`,
+///       but with noticeably fewer artefacts around edges and fine detail.
 ///     - `auto` - same as "MHC"
 ///
 ///     The following algorithms are supported for X-Trans-pattern images:
@@ -2422,6 +2443,12 @@ enum MakeTextureMode {
 ///    - `maketx:colorconfig` (string) :
 ///                           Specifies a custom OpenColorIO color config
 ///                           file. Default: ""
+///    - `maketx:colorconfig_ptr` (pointer) :
+///                           A `const ColorConfig*` to use for the color
+///                           conversion instead of loading
+///                           `maketx:colorconfig`, so that a caller making
+///                           many textures can load it only once. It must
+///                           outlive the call. Default: nullptr
 ///    - `maketx:checknan` (int) :  If nonzero, will consider it an error if the
 ///                           input image has any NaN pixels. (0)
 ///    - `maketx:fixnan` (string) : If set to "black" or "box3", will attempt
@@ -2495,6 +2522,11 @@ enum MakeTextureMode {
 ///                           the sake of ImageBuf math. (1)
 ///    - `maketx:hash` (int) :
 ///                           Compute the sha1 hash of the file in parallel. (1)
+///    - `maketx:hashalgorithm` (string) :
+///                           The pixel hash to compute: "sha1", stored as
+///                           "oiio:SHA-1", or the much faster "xxhash" or
+///                           "farmhash", stored as "oiio:PixelHash" in the
+///                           form "xxhash:<hex digits>". ("sha1")
 ///    - `maketx:allow_pixel_shift` (int) :
 ///                           Allow up to a half pixel shift per mipmap level.
 ///                           The fastest path may result in a slight shift
@@ -276,6 +276,12 @@ public:
     /// - `int64 stat:bytes_read` :
     ///           Total size (uncompressed bytes of pixel data) read.
     ///
+    /// - `int64 stat:constant_tiles` ,
+    ///   `int64 stat:constant_tile_bytes_saved` :
+    ///           Number of tiles read whose pixels were all identical, and
+    ///           which were therefore stored as a single pixel, and the
+    ///           tile memory that saved.
+    ///
     /// - `int stat:unique_files` :
     ///           Number of unique files opened.
     ///
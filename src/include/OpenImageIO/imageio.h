@@ -23,7 +23,10 @@
 #    pragma warning(disable : 4251)
 #endif
 
+#include <atomic>
 #include <cmath>
+#include <functional>
+#include <future>
 #include <limits>
 #include <string>
 #include <vector>
@@ -82,6 +85,12 @@ OIIO_NAMESPACE_3_1_BEGIN
 /// bool, which if 'true' will STOP the read or write.
 typedef bool (*ProgressCallback)(void *opaque_data, float portion_done);
 
+/// Function called by `ImageInput::read_image_async()` and
+/// `ImageOutput::write_image_async()` when the operation finishes, with
+/// its success or failure. It is called on the I/O thread that performed
+/// the operation, so it should be brief and thread-safe.
+using CompletionCallback = std::function<void(bool ok)>;
+
 
 
 
@@ -1123,6 +1132,24 @@ public:
     ///        Does this format allow 0x0 sized images, i.e. an image file
     ///        with metadata only and no pixels?
     ///
+    ///  - `"concurrent_reads"` :
+    ///        May the `read_native_scanlines()` and `read_native_tiles()`
+    ///        of an open file be called by several threads at once, with
+    ///        the calls truly overlapping rather than being serialized by
+    ///        the ImageInput's internal mutex? When true, `read_image()`,
+    ///        `read_scanlines()`, and `read_tiles()` will decode several
+    ///        chunks of the image at once. This query was added in
+    ///        OpenImageIO 3.1.
+    ///
+    ///  - `"native_channel_subset"` :
+    ///        When `read_native_scanlines()` or `read_native_tiles()` is
+    ///        asked for a subset of channels, does the reader decode only
+    ///        those channels, rather than reading all of them and
+    ///        discarding the rest? For some formats this depends on the
+    ///        layout of the particular file (for example, TIFF files only
+    ///        benefit with "separate" planar configuration). This query was
+    ///        added in OpenImageIO 3.1.
+    ///
     /// This list of queries may be extended in future releases. Since this
     /// can be done simply by recognizing new query strings, and does not
     /// require any new API entry points, addition of support for new
@@ -1432,6 +1459,41 @@ public:
                           as_image_span_writable_bytes(data));
     }
 
+    /// Begin reading the entire image, as `read_image()` does, but return
+    /// immediately rather than waiting for it to finish. The read runs on
+    /// one of OIIO's dedicated I/O threads (see the `"io_threads"` global
+    /// attribute), so that blocking file I/O does not tie up the threads
+    /// used for computation, while any decompression and data conversion
+    /// that can be parallelized still uses the regular thread pool. This
+    /// makes it easy to overlap reading the next frame with processing
+    /// the current one.
+    ///
+    /// The `ImageInput` and the memory described by `data` must remain
+    /// valid until the operation has finished. Other `read_*` calls that
+    /// take an explicit subimage and miplevel may be made concurrently.
+    /// If the read fails, the error message may be retrieved with
+    /// `geterror()` from any thread once it has finished.
+    ///
+    /// @param  subimage/miplevel/chbegin/chend/format/data
+    ///                     As for `read_image()`.
+    /// @param  cancel      If not null, points to a flag that may be set
+    ///                     to true to abandon the read. It is checked
+    ///                     before the read starts and periodically while
+    ///                     it proceeds; a cancelled read fails with an
+    ///                     error. The flag must remain valid until the
+    ///                     operation has finished.
+    /// @param  completion  If not empty, a function that will be called
+    ///                     with the result when the read finishes.
+    /// @returns            A `std::future<bool>` that will hold `true`
+    ///                     upon success, or `false` upon failure.
+    ///
+    /// This method was added in OpenImageIO 3.1.
+    std::future<bool>
+    read_image_async(int subimage, int miplevel, int chbegin, int chend,
+                     TypeDesc format, const image_span<std::byte>& data,
+                     const std::atomic<bool>* cancel = nullptr,
+                     CompletionCallback completion = {});
+
     /// A version of `read_image()` taking a `span<T>`, which assumes
     /// contiguous strides in all dimensions. This is a convenience wrapper
     /// around the `read_image()` that takes an `image_span<T>`.
@@ -2700,6 +2762,37 @@ public:
                            as_image_span_bytes(data));
     }
 
+    /// Begin writing the entire image, as `write_image()` does, but return
+    /// immediately rather than waiting for it to finish. The write runs on
+    /// one of OIIO's dedicated I/O threads (see the `"io_threads"` global
+    /// attribute), so that blocking file I/O does not tie up the threads
+    /// used for computation, while any data conversion and compression
+    /// that can be parallelized still uses the regular thread pool.
+    ///
+    /// The `ImageOutput` and the memory described by `data` must remain
+    /// valid, and no other calls may be made to this `ImageOutput`, until
+    /// the operation has finished. If the write fails, the error message
+    /// may be retrieved with `geterror()` from any thread once it has
+    /// finished.
+    ///
+    /// @param  format/data As for `write_image()`.
+    /// @param  cancel      If not null, points to a flag that may be set
+    ///                     to true to abandon the write. It is checked
+    ///                     before the write starts and periodically while
+    ///                     it proceeds; a cancelled write fails with an
+    ///                     error, leaving the file incomplete. The flag must
+    ///                     remain valid until the operation has finished.
+    /// @param  completion  If not empty, a function that will be called
+    ///                     with the result when the write finishes.
+    /// @returns            A `std::future<bool>` that will hold `true`
+    ///                     upon success, or `false` upon failure.
+    ///
+    /// This method was added in OpenImageIO 3.1.
+    std::future<bool>
+    write_image_async(TypeDesc format, const image_span<const std::byte>& data,
+                      const std::atomic<bool>* cancel = nullptr,
+                      CompletionCallback completion = {});
+
     /// A version of `write_image()` taking a `cspan<T>`, which assumes
     /// contiguous strides in all dimensions. This is a convenience wrapper
     /// around the `write_image()` that takes an `image_span<const T>`.
@@ -3778,6 +3871,15 @@ OIIO_API std::string geterror(bool clear = true);
 ///    many threads as the amount of hardware concurrency detected. Note
 ///    that this is separate from the OIIO `"threads"` attribute.
 ///
+/// - `int io_threads`
+///
+///    The number of threads dedicated to performing the blocking file I/O
+///    of `ImageInput::read_image_async()` and
+///    `ImageOutput::write_image_async()`, which is also the maximum number
+///    of such operations that will run at once. The default is 4. A change
+///    takes effect once any asynchronous operations already underway have
+///    finished. (Added in OpenImageIO 3.1.)
+///
 /// - `string font_searchpath`
 ///
 ///    Colon-separated (or semicolon-separated) list of directories to search
@@ -3868,6 +3970,8 @@ OIIO_API std::string geterror(bool clear = true);
 ///
 ///    When nonzero, use the new "OpenEXR core C library" when available.
 ///    The default is 1 for OpenEXR >= 3.1.10, 0 for older OpenEXR releases.
+///    This applies to reading, and also to writing non-deep files, whose
+///    chunks the core library lets OIIO compress in parallel.
 ///
 /// - `int jpeg:com_attributes`
 ///
@@ -3884,6 +3988,13 @@ OIIO_API std::string geterror(bool clear = true);
 ///    For more information, please see OpenImageIO's documentation on the
 ///    built-in PNG format support.
 ///
+/// - `int png:multithread` (1)
+///
+///    If nonzero (the default), the PNG writer will filter and compress
+///    large images in parallel bands using the thread pool, and the PNG
+///    reader will undo row filters in parallel when reading many scanlines
+///    at once. Setting it to zero forces libpng's serial code paths.
+///
 /// - `int limits:channels` (1024)
 ///
 ///    When nonzero, the maximum number of color channels in an image. Image
@@ -3968,6 +4079,15 @@ OIIO_API std::string geterror(bool clear = true);
 ///   enable globally in an environment where security is a higher priority
 ///   than being tolerant of partially broken image files.
 ///
+/// - `imagebufalgo:yee_decimate` (int: 0)
+///
+///   If nonzero, `ImageBufAlgo::compare_Yee()` builds a true Gaussian
+///   pyramid, halving the resolution at each level and upsampling the
+///   levels bilinearly as it compares them, instead of keeping every level
+///   at full resolution. This is much faster and uses much less memory for
+///   large images, but the results are not identical, because the coarser
+///   levels are blurrier. (Added in OpenImageIO 3.1.)
+///
 /// - `ustring:cleanup` (int: 0)
 ///
 ///    If nonzero, upon exit, do a thorough (and possibly expensive) teardown
@@ -4713,6 +4833,7 @@ using v3_1::openimageio_version;
 using v3_1::parallel_convert_image;
 using v3_1::premult;
 using v3_1::ProgressCallback;
+using v3_1::CompletionCallback;
 using v3_1::roi_intersection;
 using v3_1::roi_union;
 using v3_1::set_colorspace;
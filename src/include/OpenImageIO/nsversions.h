@@ -167,6 +167,7 @@ class ErrorHandler;
 class Filter1D;
 class Filter2D;
 class FilterDesc;
+class FilterTable;
 class ParamValue;
 class ParamValueList;
 class ParamValueSpan;
@@ -213,6 +214,7 @@ using v3_1::ErrorHandler;
 using v3_1::Filter1D;
 using v3_1::Filter2D;
 using v3_1::FilterDesc;
+using v3_1::FilterTable;
 using v3_1::ParamValue;
 using v3_1::ParamValueList;
 using v3_1::ParamValueSpan;
@@ -495,7 +495,10 @@ public:
     ///             will have only the requested subset loaded, in order to
     ///             save cache space (but at the possible wasted expense of
     ///             separate tiles that overlap their channel ranges). The
-    ///             default is 5.
+    ///             default is 5. Regardless of this setting, for files
+    ///             whose channels are grouped into named layers (such as
+    ///             "diffuse.R", "diffuse.G", "diffuse.B"), a lookup that
+    ///             falls within one layer caches tiles of just that layer.
     /// - `int max_mip_res` :
     ///             **NEW 2.1** Sets the maximum MIP-map resolution for
     ///             filtered texture lookups. The MIP levels used will be
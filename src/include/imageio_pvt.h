@@ -29,6 +29,7 @@ extern std::recursive_mutex imageio_mutex;
 
 extern atomic_int oiio_threads;
 extern atomic_int oiio_read_chunk;
+extern atomic_int oiio_io_threads;
 extern atomic_int oiio_try_all_readers;
 extern ustring font_searchpath;
 extern ustring plugin_searchpath;
@@ -43,12 +44,14 @@ extern int oiio_log_times;
 extern int openexr_core;
 extern int jpeg_com_attributes;
 extern int png_linear_premult;
+extern int png_multithread;
 extern int enable_hwy;
 extern int limit_channels;
 extern int limit_imagesize_MB;
 extern int imagebuf_print_uncaught_errors;
 extern int imagebuf_use_imagecache;
 extern int imageinput_strict;
+extern int yee_decimate;
 extern atomic_ll IB_local_mem_current;
 extern atomic_ll IB_local_mem_peak;
 extern std::atomic<float> IB_total_open_time;
@@ -72,6 +75,13 @@ OIIO_API const std::string
 font_filename(string_view family, string_view style = "");
 
 
+// The thread pool that runs the asynchronous reads and writes of
+// ImageInput::read_image_async() and ImageOutput::write_image_async(), kept
+// separate from default_thread_pool() so that threads blocked on file I/O
+// never hold up computation. Its size is the "io_threads" attribute.
+thread_pool*
+io_thread_pool();
+
 // Make sure all plugins are inventoried. For internal use only.
 void
 catalog_all_plugins(std::string searchpath);
@@ -1363,6 +1363,7 @@ pvt::check_texture_metadata_sanity(ImageSpec& spec)
         spec.erase_attribute("oiio::ConstantColor");
         spec.erase_attribute("oiio::AverageColor");
         spec.erase_attribute("oiio:SHA-1");
+        spec.erase_attribute("oiio:PixelHash");
         return true;
     }
     return false;
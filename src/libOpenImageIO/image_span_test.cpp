@@ -627,6 +627,10 @@ main(int argc, char* argv[])
     test_image_span_convert_image<uint8_t, uint16_t>();
     test_image_span_convert_image<uint16_t, half>();
     test_image_span_convert_image<half, uint16_t>();
+    test_image_span_convert_image<float, uint32_t>();
+    test_image_span_convert_image<uint32_t, float>();
+    test_image_span_convert_image<float, double>();
+    test_image_span_convert_image<double, float>();
 
     test_image_span_within_span();
 
@@ -248,9 +248,11 @@ ImageBufAlgo::IBAprep(ROI& roi, ImageBuf* dst, const ImageBuf* A,
             // Since we're altering pixels, be sure that any existing SHA
             // hash of dst's pixel values is erased.
             spec.erase_attribute("oiio:SHA-1");
+            spec.erase_attribute("oiio:PixelHash");
             std::string desc = spec.get_string_attribute("ImageDescription");
             if (desc.size()) {
                 Strutil::excise_string_after_head(desc, "oiio:SHA-1=");
+                Strutil::excise_string_after_head(desc, "oiio:PixelHash=");
                 spec.attribute("ImageDescription", desc);
             }
         }
@@ -531,9 +533,11 @@ ImageBufAlgo::IBAprep(ROI& roi, ImageBuf& dst, cspan<const ImageBuf*> srcs,
             // Since we're altering pixels, be sure that any existing SHA
             // hash of dst's pixel values is erased.
             spec.erase_attribute("oiio:SHA-1");
+            spec.erase_attribute("oiio:PixelHash");
             std::string desc = spec.get_string_attribute("ImageDescription");
             if (desc.size()) {
                 Strutil::excise_string_after_head(desc, "oiio:SHA-1=");
+                Strutil::excise_string_after_head(desc, "oiio:PixelHash=");
                 spec.attribute("ImageDescription", desc);
             }
         }
@@ -893,6 +893,94 @@ ImageBufAlgo::computePixelHashSHA1(const ImageBuf& src, string_view extrainfo,
 
 
 
+namespace {
+
+// Hash `size` bytes with the 64-bit function selected by `algo` (0 =
+// xxhash, 1 = farmhash). Both are stable across platforms and releases.
+inline uint64_t
+pixelhash64(int algo, const void* data, size_t size)
+{
+    if (algo == 0)
+        return xxhash::XXH64(data, size, 0);
+    return farmhash::Fingerprint64((const char*)data, size);
+}
+
+}  // namespace
+
+
+
+std::string
+ImageBufAlgo::computePixelHash(const ImageBuf& src, string_view algorithm,
+                               string_view extrainfo, ROI roi, int nthreads)
+{
+    OIIO::pvt::LoggedTimer logtimer("IBA::computePixelHash");
+    int algo = -1;
+    if (Strutil::iequals(algorithm, "xxhash"))
+        algo = 0;
+    else if (Strutil::iequals(algorithm, "farmhash"))
+        algo = 1;
+    else {
+        src.errorfmt("computePixelHash: unknown hash algorithm \"{}\"",
+                     algorithm);
+        return {};
+    }
+    if (!roi.defined())
+        roi = get_roi(src.spec());
+    roi.chbegin = 0;
+    roi.chend   = src.nchannels();
+
+    // Tree hash: split each z slice of the region into blocks of whole
+    // scanlines (about 1 MB each), hash the blocks independently and in
+    // parallel, then hash the list of block hashes. The block size depends
+    // only on the image dimensions, never on the number of threads, so the
+    // result is reproducible everywhere.
+    const imagesize_t scanline_bytes = imagesize_t(roi.width())
+                                       * src.spec().pixel_bytes();
+    const int blockrows = std::max(1, int(std::min(
+                                          imagesize_t(1 << 20)
+                                              / std::max(scanline_bytes,
+                                                         imagesize_t(1)),
+                                          imagesize_t(roi.height()))));
+    const int64_t slice_blocks = (roi.height() + blockrows - 1) / blockrows;
+    const int64_t nblocks      = slice_blocks * roi.depth();
+    const bool direct = src.localpixels() && src.contiguous()
+                        && roi.xbegin == src.xbegin() && roi.xend == src.xend();
+    std::vector<uint64_t> leaves(nblocks);
+    parallel_for_chunked(
+        0, nblocks, 1,
+        [&](int64_t bbegin, int64_t bend) {
+            std::vector<std::byte> tmp;
+            for (int64_t b = bbegin; b < bend; ++b) {
+                int z  = roi.zbegin + int(b / slice_blocks);
+                int y  = roi.ybegin + int(b % slice_blocks) * blockrows;
+                int y1 = std::min(y + blockrows, roi.yend);
+                size_t size = size_t(scanline_bytes) * (y1 - y);
+                const void* data;
+                if (direct) {
+                    data = src.pixeladdr(roi.xbegin, y, z);
+                } else {
+                    tmp.resize(size);
+                    src.get_pixels(ROI(roi.xbegin, roi.xend, y, y1, z, z + 1),
+                                   src.spec().format, tmp.data());
+                    data = tmp.data();
+                }
+                leaves[b] = pixelhash64(algo, data, size);
+                if (bigendian())
+                    swap_endian(&leaves[b]);
+            }
+        },
+        paropt(nthreads));
+
+    // Root: hash the leaf hashes followed by the extra info.
+    std::string root((const char*)leaves.data(),
+                     leaves.size() * sizeof(uint64_t));
+    root.append(extrainfo.data(), extrainfo.size());
+    return Strutil::fmt::format("{:016x}",
+                                pixelhash64(algo, root.data(), root.size()));
+}
+
+
+
 template<class Atype>
 static bool
 histogram_impl(const ImageBuf& src, int channel, std::vector<imagesize_t>& hist,
@@ -5,9 +5,14 @@
 /// \file
 /// Implementation of ImageBufAlgo demosaic algorithms
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagebufalgo_util.h>
+#include <OpenImageIO/simd.h>
 
 #include "imagebufalgo_demosaic_prv.h"
 #include "imageio_pvt.h"
@@ -222,13 +227,26 @@ protected:
     std::string error;
 
 public:
-    bool process(ImageBuf& dst, const ImageBuf& src,
-                 const float (&white_balance)[4], ROI roi, int nthreads)
+    /// If the layout could not be recognized, report it as an error on
+    /// `dst` and return false.
+    bool check_layout(ImageBuf& dst) const
     {
         if (error.length() > 0) {
             dst.errorfmt("Demosaic::process() {}", error);
             return false;
         }
+        return true;
+    }
+
+    /// Offset of the layout relative to the canonical pattern.
+    int layout_x_offset() const { return x_offset; }
+    int layout_y_offset() const { return y_offset; }
+
+    bool process(ImageBuf& dst, const ImageBuf& src,
+                 const float (&white_balance)[4], ROI roi, int nthreads)
+    {
+        if (!check_layout(dst))
+            return false;
 
         ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
             ImageBuf::Iterator<Rtype> it(dst, roi);
@@ -408,15 +426,14 @@ public:
     };
 };
 
-template<class Rtype, class Atype>
-class MHCBayerDemosaicing : public BayerDemosaicing<Rtype, Atype, 5> {
-private:
-    using Window = typename MHCBayerDemosaicing<Rtype, Atype>::Window;
-
-    inline static void mix1(Window& w, float& out_mix1, float& out_mix2)
+/// The Malvar-He-Cutler filters, for any value type and any window type
+/// that returns values by w(row, col), with (2,2) the center pixel. Shared by
+/// MHCBayerDemosaicing and the SIMD strip kernel.
+struct MHCMix {
+    template<class W, class T> static void mix1(W& w, T& out_mix1, T& out_mix2)
     {
-        float tmp = w(0, 2) + w(4, 2) + w(2, 0) + w(2, 4);
-        out_mix1  = (8.0f * w(2, 2)
+        T tmp    = w(0, 2) + w(4, 2) + w(2, 0) + w(2, 4);
+        out_mix1 = (8.0f * w(2, 2)
                     + 4.0f * (w(1, 2) + w(3, 2) + w(2, 1) + w(2, 3))
                     - 2.0f * tmp)
                    / 16.0f;
@@ -426,9 +443,9 @@ private:
                    / 16.0f;
     }
 
-    inline static void mix2(Window& w, float& out_mix1, float& out_mix2)
+    template<class W, class T> static void mix2(W& w, T& out_mix1, T& out_mix2)
     {
-        float tmp = w(1, 1) + w(1, 3) + w(3, 1) + w(3, 3);
+        T tmp = w(1, 1) + w(1, 3) + w(3, 1) + w(3, 3);
 
         out_mix1 = (10.0f * w(2, 2) + 8.0f * (w(2, 1) + w(2, 3))
                     - 2.0f * (tmp + w(2, 0) + w(2, 4))
@@ -439,7 +456,11 @@ private:
                     + 1.0f * (w(2, 0) + w(2, 4)))
                    / 16.0f;
     }
+};
 
+template<class Rtype, class Atype>
+class MHCBayerDemosaicing : public BayerDemosaicing<Rtype, Atype, 5> {
+private:
     using Context = typename MHCBayerDemosaicing<Rtype, Atype>::Context;
 
 
@@ -451,7 +472,7 @@ private:
         if (MHCBayerDemosaicing::template check_and_decode<check>(c, [&c, &w,
                                                                       ch]() {
                 float val1, val2;
-                mix1(w, val1, val2);
+                MHCMix::mix1(w, val1, val2);
 
                 c.out[ch + 0] = w(2, 2);
                 c.out[ch + 1] = val1;
@@ -462,7 +483,7 @@ private:
         if (MHCBayerDemosaicing::template check_and_decode<check>(c, [&c, &w,
                                                                       ch]() {
                 float val1, val2;
-                mix2(w, val1, val2);
+                MHCMix::mix2(w, val1, val2);
 
                 c.out[ch + 0] = val1;
                 c.out[ch + 1] = w(2, 2);
@@ -479,7 +500,7 @@ private:
         if (MHCBayerDemosaicing::template check_and_decode<check>(c, [&c, &w,
                                                                       ch]() {
                 float val1, val2;
-                mix2(w, val1, val2);
+                MHCMix::mix2(w, val1, val2);
 
                 c.out[ch + 0] = val2;
                 c.out[ch + 1] = w(2, 2);
@@ -490,7 +511,7 @@ private:
         if (MHCBayerDemosaicing::template check_and_decode<check>(c, [&c, &w,
                                                                       ch]() {
                 float val1, val2;
-                mix1(w, val1, val2);
+                MHCMix::mix1(w, val1, val2);
 
                 c.out[ch + 0] = val2;
                 c.out[ch + 1] = val1;
@@ -927,6 +948,637 @@ public:
 };
 
 
+/// Modulo that is never negative, for CFA phase arithmetic.
+inline int
+cfa_mod(int a, int b)
+{
+    int m = a % b;
+    return m < 0 ? m + b : m;
+}
+
+/// Division that rounds toward negative infinity.
+inline int
+cfa_floordiv(int a, int b)
+{
+    return (a - cfa_mod(a, b)) / b;
+}
+
+
+
+/// Reads rows of a single channel CFA image as white balanced floats, over
+/// any range of columns and rows. Pixels outside the image are taken from
+/// the nearest whole pattern period inside it, just as the sliding Window
+/// does, so the strip and tile implementations below agree with the
+/// per-pixel ones at the image edges.
+template<class Atype, int pattern_size> class CFAReader {
+public:
+    CFAReader(const ImageBuf& src,
+              const size_t (&channel_map)[pattern_size][pattern_size],
+              int x_offset, int y_offset, const float (&white_balance)[4],
+              int xbegin, int xend)
+        : m_src(src)
+        , m_channel_map(channel_map)
+        , m_white_balance(white_balance)
+        , m_x_offset(x_offset)
+        , m_y_offset(y_offset)
+        , m_xbegin(xbegin)
+        , m_xend(xend)
+    {
+        const ImageSpec& spec = src.spec();
+        m_src_xbegin          = spec.x;
+        m_src_xend            = spec.x + spec.width;
+        m_src_ybegin          = spec.y;
+        m_src_yend            = spec.y + spec.height;
+
+        // The range of source columns that [xbegin,xend) maps onto.
+        m_lo = std::max(xbegin, m_src_xbegin);
+        m_hi = std::min(xend, m_src_xend);
+        if (xbegin < m_src_xbegin)
+            m_hi = std::max(m_hi, std::min(m_src_xbegin + pattern_size,
+                                           m_src_xend));
+        if (xend > m_src_xend)
+            m_lo = std::min(m_lo, std::max(m_src_xend - pattern_size,
+                                           m_src_xbegin));
+        m_line.resize(m_hi - m_lo);
+    }
+
+    /// Read row `y`, columns [xbegin,xend), into `out`.
+    void read(int y, float* out)
+    {
+        int sy = wrap(y, m_src_ybegin, m_src_yend);
+        ImageBuf::ConstIterator<Atype> it(m_src, m_lo, m_hi, sy, sy + 1);
+        for (float& v : m_line) {
+            v = it[0];
+            ++it;
+        }
+
+        const size_t* channels = m_channel_map[cfa_mod(sy + m_y_offset,
+                                                       pattern_size)];
+        float wb[pattern_size];
+        for (int i = 0; i < pattern_size; i++) {
+            int c = cfa_mod(m_xbegin + i + m_x_offset, pattern_size);
+            wb[i] = m_white_balance[channels[c]];
+        }
+        for (int x = m_xbegin, i = 0; x < m_xend; x++, i++) {
+            int sx = wrap(x, m_src_xbegin, m_src_xend);
+            out[i] = m_line[sx - m_lo] * wb[i % pattern_size];
+        }
+    }
+
+private:
+    static int wrap(int v, int begin, int end)
+    {
+        while (v < begin)
+            v += pattern_size;
+        while (v > end - 1)
+            v -= pattern_size;
+        return v;
+    }
+
+    const ImageBuf& m_src;
+    const size_t (&m_channel_map)[pattern_size][pattern_size];
+    const float (&m_white_balance)[4];
+    int m_x_offset, m_y_offset;
+    int m_xbegin, m_xend;
+    int m_src_xbegin, m_src_xend, m_src_ybegin, m_src_yend;
+    int m_lo, m_hi;
+    std::vector<float> m_line;
+};
+
+
+
+/// Can the strip and tile implementations below handle this case? They
+/// need a 2D image at least one pattern period across and room for the
+/// three output channels.
+static bool
+demosaic_strips_ok(const ImageBuf& dst, const ImageBuf& src, ROI roi,
+                   int pattern_size)
+{
+    const ImageSpec& spec = src.spec();
+    return !src.deep() && spec.depth == 1 && roi.depth() == 1
+           && spec.width >= pattern_size && spec.height >= pattern_size
+           && roi.chbegin + 3 <= dst.nchannels();
+}
+
+
+
+/// Window of a strip kernel: w(row, col) returns the four values at that
+/// window position for the four pixels of the current vector.
+template<int window_size> struct StripWindow {
+    const float* taps[window_size][window_size];
+    int q;
+
+    simd::vfloat4 operator()(int row, int col) const
+    {
+        return simd::vfloat4(taps[row][col] + q);
+    }
+};
+
+
+
+/// Malvar-He-Cutler Bayer kernel for demosaic_strips.
+struct MHCBayerKernel {
+    static constexpr int pattern_size = 2;
+    static constexpr int radius       = 2;
+    static constexpr const size_t (&channel_map)[2][2] = bayer_channel_map;
+
+    template<class W, class T>
+    static void pixel(int row, int col, W& w, T (&out)[3])
+    {
+        T val1, val2;
+        if (row == col) {
+            // R or B site
+            MHCMix::mix1(w, val1, val2);
+            out[0] = row == 0 ? w(2, 2) : val2;
+            out[1] = val1;
+            out[2] = row == 0 ? val2 : w(2, 2);
+        } else {
+            // G site, in an RG or a GB row
+            MHCMix::mix2(w, val1, val2);
+            out[0] = row == 0 ? val1 : val2;
+            out[1] = w(2, 2);
+            out[2] = row == 0 ? val2 : val1;
+        }
+    }
+};
+
+
+
+/// Linear X-Trans kernel for demosaic_strips. It is the same
+/// interpolation as LinearXTransDemosaicing, but described by a table of
+/// neighborhood shapes and taps so that it can be evaluated for any pixel
+/// position at run time.
+struct LinearXTransKernel {
+    static constexpr int pattern_size = 6;
+    static constexpr int radius       = 2;
+    static constexpr const size_t (&channel_map)[6][6] = xtrans_channel_map;
+
+    /// The neighborhood shapes of LinearXTransDemosaicing: copy the center,
+    /// cross(), triangle(), pentagon(), and square().
+    enum Shape { copy, cross, tri, pent, sqr };
+
+    /// One output channel at one pattern position: the shape and the window
+    /// positions (row, col) of its taps, in the helper's argument order.
+    struct Taps {
+        Shape shape;
+        int pos[5][2];
+    };
+
+    /// Rows 3-5 of the pattern are rows 0-2 shifted by three columns, so
+    /// only the first three rows are tabulated.
+    // clang-format off
+    static constexpr Taps taps[3][6][3] = {
+    {   // row 0
+        { { cross, {{0,2}, {2,1}, {2,3}, {4,2}} },
+          { copy, {{2,2}} },
+          { cross, {{2,0}, {1,2}, {3,2}, {2,4}} } },
+        { { copy, {{2,2}} },
+          { pent, {{2,1}, {1,2}, {3,2}, {1,3}, {3,3}} },
+          { tri,  {{2,3}, {1,1}, {3,1}} } },
+        { { tri,  {{2,1}, {1,3}, {3,3}} },
+          { pent, {{2,3}, {1,2}, {3,2}, {1,1}, {3,1}} },
+          { copy, {{2,2}} } },
+        { { cross, {{2,0}, {1,2}, {3,2}, {2,4}} },
+          { copy, {{2,2}} },
+          { cross, {{0,2}, {2,1}, {2,3}, {4,2}} } },
+        { { tri,  {{2,3}, {1,1}, {3,1}} },
+          { pent, {{2,1}, {1,2}, {3,2}, {1,3}, {3,3}} },
+          { copy, {{2,2}} } },
+        { { copy, {{2,2}} },
+          { pent, {{2,3}, {1,2}, {3,2}, {1,1}, {3,1}} },
+          { tri,  {{2,1}, {1,3}, {3,3}} } },
+    },
+    {   // row 1
+        { { tri,  {{3,2}, {1,1}, {1,3}} },
+          { pent, {{1,2}, {2,1}, {2,3}, {3,1}, {3,3}} },
+          { copy, {{2,2}} } },
+        { { sqr,  {{1,2}, {3,1}, {2,4}, {4,3}} },
+          { copy, {{2,2}} },
+          { sqr,  {{2,1}, {1,3}, {4,2}, {3,4}} } },
+        { { sqr,  {{2,3}, {1,1}, {4,2}, {3,0}} },
+          { copy, {{2,2}} },
+          { sqr,  {{1,2}, {3,3}, {2,0}, {4,1}} } },
+        { { copy, {{2,2}} },
+          { pent, {{1,2}, {2,1}, {2,3}, {3,1}, {3,3}} },
+          { tri,  {{3,2}, {1,1}, {1,3}} } },
+        { { sqr,  {{2,1}, {1,3}, {4,2}, {3,4}} },
+          { copy, {{2,2}} },
+          { sqr,  {{1,2}, {3,1}, {2,4}, {4,3}} } },
+        { { sqr,  {{1,2}, {3,3}, {2,0}, {4,1}} },
+          { copy, {{2,2}} },
+          { sqr,  {{2,3}, {1,1}, {4,2}, {3,0}} } },
+    },
+    {   // row 2
+        { { copy, {{2,2}} },
+          { pent, {{3,2}, {2,1}, {2,3}, {1,1}, {1,3}} },
+          { tri,  {{1,2}, {3,1}, {3,3}} } },
+        { { sqr,  {{2,1}, {3,3}, {0,2}, {1,4}} },
+          { copy, {{2,2}} },
+          { sqr,  {{3,2}, {1,1}, {2,4}, {0,3}} } },
+        { { sqr,  {{3,2}, {1,3}, {2,0}, {3,4}} },
+          { copy, {{2,2}} },
+          { sqr,  {{2,3}, {3,1}, {0,2}, {1,0}} } },
+        { { tri,  {{1,2}, {3,1}, {3,3}} },
+          { pent, {{3,2}, {2,1}, {2,3}, {1,1}, {1,3}} },
+          { copy, {{2,2}} } },
+        { { sqr,  {{3,2}, {1,1}, {2,4}, {0,3}} },
+          { copy, {{2,2}} },
+          { sqr,  {{2,1}, {3,3}, {0,2}, {1,4}} } },
+        { { sqr,  {{2,3}, {3,1}, {0,2}, {1,0}} },
+          { copy, {{2,2}} },
+          { sqr,  {{3,2}, {1,3}, {2,0}, {3,4}} } },
+    },
+    };
+    // clang-format on
+
+    template<class W, class T> static T eval(const Taps& t, W& w)
+    {
+        constexpr float s  = float(M_SQRT1_2);
+        constexpr float r5 = 0.44721359549995793928f;  // 1/sqrt(5)
+        auto v = [&](int i) { return w(t.pos[i][0], t.pos[i][1]); };
+        switch (t.shape) {
+        case cross: return (v(0) + v(3) + (v(1) + v(2)) * 2.0f) / 6.0f;
+        case tri: return (v(0) + (v(1) + v(2)) * s) / (1.0f + s + s);
+        case pent:
+            return (v(0) + v(1) + v(2) + (v(3) + v(4)) * s) / (3.0f + s + s);
+        case sqr:
+            return (v(0) + v(1) * s + v(2) * 0.5f + v(3) * r5)
+                   / (1.5f + s + r5);
+        default: return v(0);
+        }
+    }
+
+    template<class W, class T>
+    static void pixel(int row, int col, W& w, T (&out)[3])
+    {
+        const Taps* t = taps[row % 3][(col + 3 * (row / 3)) % 6];
+        for (int c = 0; c < 3; c++)
+            out[c] = eval<W, T>(t[c], w);
+    }
+};
+
+
+
+/// Demosaic `roi` of `dst` with `Kernel` one row at a time, four output
+/// pixels per SIMD operation. Each source row is split into one array per
+/// column of the pattern (for Bayer, the two columns of each 2x2 quad), so
+/// that pixels with the same pattern position, and each of their window
+/// neighbors, are contiguous and can be loaded four at a time. A ring of
+/// rows covers the window vertically.
+template<class Rtype, class Atype, class Kernel>
+static bool
+demosaic_strips(ImageBuf& dst, const ImageBuf& src, int x_offset,
+                int y_offset, const float (&white_balance)[4], ROI roi,
+                int nthreads)
+{
+    using namespace simd;
+    constexpr int P = Kernel::pattern_size;
+    constexpr int R = Kernel::radius;
+    constexpr int N = 2 * R + 1;
+
+    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        // Columns are split into groups of P pixels, the first group starting
+        // at x0, aligned to the pattern. `pad` groups on either side of the
+        // ones being computed hold the edges of the window.
+        constexpr int pad = (R + P - 1) / P;
+        int x0 = roi.xbegin - cfa_mod(roi.xbegin + x_offset, P) - pad * P;
+        int q0 = pad;
+        int q1 = (roi.xend - 1 - x0) / P + 1;
+        int nq = q0 + round_to_multiple(q1 - q0, 4) + pad;
+
+        CFAReader<Atype, P> reader(src, Kernel::channel_map, x_offset,
+                                   y_offset, white_balance, x0, x0 + nq * P);
+        std::vector<float> line(size_t(nq) * P);
+        std::vector<float> rows(size_t(N) * nq * P);
+        std::vector<float> out(size_t(nq) * P * 3);
+        auto load_row = [&](int y) {
+            reader.read(y, line.data());
+            float* r = &rows[size_t(cfa_mod(y, N)) * nq * P];
+            for (int q = 0; q < nq; q++)
+                for (int c = 0; c < P; c++)
+                    r[c * nq + q] = line[q * P + c];
+        };
+
+        for (int y = roi.ybegin - R; y < roi.ybegin + R; y++)
+            load_row(y);
+        for (int y = roi.ybegin; y < roi.yend; y++) {
+            load_row(y + R);
+            int row = cfa_mod(y + y_offset, P);
+            for (int col = 0; col < P; col++) {
+                // Point each window position at the array and group holding
+                // that neighbor of the first pixel of this column phase.
+                StripWindow<N> w;
+                for (int i = 0; i < N; i++) {
+                    const float* r = &rows[size_t(cfa_mod(y + i - R, N)) * nq
+                                           * P];
+                    for (int j = 0; j < N; j++)
+                        w.taps[i][j] = r + cfa_mod(col + j - R, P) * nq
+                                       + cfa_floordiv(col + j - R, P);
+                }
+                for (w.q = q0; w.q < q1; w.q += 4) {
+                    vfloat4 rgb[3];
+                    Kernel::pixel(row, col, w, rgb);
+                    float* o = &out[(size_t(w.q) * P + col) * 3];
+                    for (int i = 0; i < 4; i++, o += P * 3) {
+                        o[0] = rgb[0][i];
+                        o[1] = rgb[1][i];
+                        o[2] = rgb[2][i];
+                    }
+                }
+            }
+
+            const float* o = &out[size_t(roi.xbegin - x0) * 3];
+            ImageBuf::Iterator<Rtype> d(dst, roi.xbegin, roi.xend, y, y + 1,
+                                        roi.zbegin, roi.zend);
+            for (; !d.done(); ++d, o += 3) {
+                d[roi.chbegin + 0] = o[0];
+                d[roi.chbegin + 1] = o[1];
+                d[roi.chbegin + 2] = o[2];
+            }
+        }
+    });
+    return true;
+}
+
+
+
+/// Ratio Corrected Demosaicing (RCD, Luis Sanz Rodriguez) of one tile of a
+/// Bayer image. RCD picks between vertical and horizontal (and, for red
+/// and blue, between the two diagonal) interpolations using local
+/// high-pass energy, estimates green at red and blue sites from ratios of a
+/// low-pass filtered image, and then red and blue from color differences.
+/// It holds up much better than MHC on fine detail and edges, at a few
+/// times the cost.
+///
+/// `cfa` holds width * height white balanced samples, with an R site at the
+/// top left. Results are only accurate `rcd_border` pixels in from the
+/// edges.
+struct RCDTile {
+    static constexpr int rcd_border = 9;
+
+    int width  = 0;
+    int height = 0;
+    std::vector<float> cfa, rgb[3];
+
+    void resize(int w, int h)
+    {
+        width  = w;
+        height = h;
+        size_t n(size_t(w) * size_t(h));
+        cfa.resize(n);
+        for (auto& plane : rgb)
+            plane.assign(n, 0.0f);
+        vh_dir.assign(n, 0.0f);
+        pq_dir.assign(n, 0.0f);
+        lpf.assign(n, 0.0f);
+        hpf1.assign(n, 0.0f);
+        hpf2.assign(n, 0.0f);
+    }
+
+    void run();
+
+private:
+    std::vector<float> vh_dir, pq_dir, lpf, hpf1, hpf2;
+};
+
+
+
+void
+RCDTile::run()
+{
+    const int w = width, h = height;
+    const int w1 = w, w2 = 2 * w, w3 = 3 * w, w4 = 4 * w;
+    const float eps = 1e-5f, epssq = 1e-10f;
+    const float* cfa = this->cfa.data();
+    float *r = rgb[0].data(), *g = rgb[1].data(), *b = rgb[2].data();
+    auto sqr  = [](float x) { return x * x; };
+    auto intp = [](float a, float b, float c) { return a * (b - c) + c; };
+
+    // Each sample is the channel at its own site: R at even rows and
+    // columns, B at odd rows and columns, G elsewhere.
+    for (int y = 0; y < h; y++)
+        for (int x = 0, i = y * w; x < w; x++, i++)
+            rgb[(x & 1) == (y & 1) ? 2 * (y & 1) : 1][i] = cfa[i];
+
+    // Vertical and horizontal local discrimination: the high-pass energy
+    // along columns versus along rows.
+    for (int y = 3; y < h - 3; y++)
+        for (int x = 0, i = y * w; x < w; x++, i++)
+            hpf1[i] = sqr(cfa[i - w3] - cfa[i - w1] - cfa[i + w1] + cfa[i + w3]
+                          - 3.0f * (cfa[i - w2] + cfa[i + w2]) + 6.0f * cfa[i]);
+    for (int y = 0; y < h; y++)
+        for (int x = 3, i = y * w + 3; x < w - 3; x++, i++)
+            hpf2[i] = sqr(cfa[i - 3] - cfa[i - 1] - cfa[i + 1] + cfa[i + 3]
+                          - 3.0f * (cfa[i - 2] + cfa[i + 2]) + 6.0f * cfa[i]);
+    for (int y = 4; y < h - 4; y++) {
+        for (int x = 4, i = y * w + 4; x < w - 4; x++, i++) {
+            float v   = std::max(epssq, hpf1[i - w1] + hpf1[i] + hpf1[i + w1]);
+            float hz  = std::max(epssq, hpf2[i - 1] + hpf2[i] + hpf2[i + 1]);
+            vh_dir[i] = v / (v + hz);
+        }
+    }
+
+    // Low-pass filter at R and B sites, for the ratio corrections.
+    for (int y = 2; y < h - 2; y++) {
+        for (int x = 2 + (y & 1), i = y * w + x; x < w - 2; x += 2, i += 2) {
+            float l = cfa[i]
+                      + 0.5f
+                            * (cfa[i - w1] + cfa[i + w1] + cfa[i - 1]
+                               + cfa[i + 1])
+                      + 0.25f
+                            * (cfa[i - w1 - 1] + cfa[i - w1 + 1]
+                               + cfa[i + w1 - 1] + cfa[i + w1 + 1]);
+            lpf[i] = std::max(l, 0.0f);
+        }
+    }
+
+    auto vh_disc = [&](int i) {
+        float c = vh_dir[i];
+        float n = 0.25f
+                  * (vh_dir[i - w1 - 1] + vh_dir[i - w1 + 1]
+                     + vh_dir[i + w1 - 1] + vh_dir[i + w1 + 1]);
+        return std::abs(0.5f - c) < std::abs(0.5f - n) ? n : c;
+    };
+
+    // Green at R and B sites.
+    for (int y = 4; y < h - 4; y++) {
+        for (int x = 4 + (y & 1), i = y * w + x; x < w - 4; x += 2, i += 2) {
+            float n_grad = eps + std::abs(cfa[i - w1] - cfa[i + w1])
+                           + std::abs(cfa[i] - cfa[i - w2])
+                           + std::abs(cfa[i - w1] - cfa[i - w3])
+                           + std::abs(cfa[i - w2] - cfa[i - w4]);
+            float s_grad = eps + std::abs(cfa[i - w1] - cfa[i + w1])
+                           + std::abs(cfa[i] - cfa[i + w2])
+                           + std::abs(cfa[i + w1] - cfa[i + w3])
+                           + std::abs(cfa[i + w2] - cfa[i + w4]);
+            float w_grad = eps + std::abs(cfa[i - 1] - cfa[i + 1])
+                           + std::abs(cfa[i] - cfa[i - 2])
+                           + std::abs(cfa[i - 1] - cfa[i - 3])
+                           + std::abs(cfa[i - 2] - cfa[i - 4]);
+            float e_grad = eps + std::abs(cfa[i - 1] - cfa[i + 1])
+                           + std::abs(cfa[i] - cfa[i + 2])
+                           + std::abs(cfa[i + 1] - cfa[i + 3])
+                           + std::abs(cfa[i + 2] - cfa[i + 4]);
+
+            auto ratio = [&](int j) {
+                return 1.0f + (lpf[i] - lpf[j]) / (eps + lpf[i] + lpf[j]);
+            };
+            float n_est = cfa[i - w1] * ratio(i - w2);
+            float s_est = cfa[i + w1] * ratio(i + w2);
+            float w_est = cfa[i - 1] * ratio(i - 2);
+            float e_est = cfa[i + 1] * ratio(i + 2);
+
+            float v_est = (s_grad * n_est + n_grad * s_est) / (n_grad + s_grad);
+            float h_est = (w_grad * e_est + e_grad * w_est) / (e_grad + w_grad);
+            g[i]        = intp(vh_disc(i), h_est, v_est);
+        }
+    }
+
+    // Diagonal local discrimination at R and B sites, reusing the
+    // high-pass buffers.
+    for (int y = 3; y < h - 3; y++) {
+        for (int x = 3 + ((y + 1) & 1), i = y * w + x; x < w - 3;
+             x += 2, i += 2) {
+            hpf1[i] = sqr((cfa[i - w3 - 3] - cfa[i - w1 - 1] - cfa[i + w1 + 1]
+                           + cfa[i + w3 + 3])
+                          - 3.0f * (cfa[i - w2 - 2] + cfa[i + w2 + 2])
+                          + 6.0f * cfa[i]);
+            hpf2[i] = sqr((cfa[i - w3 + 3] - cfa[i - w1 + 1] - cfa[i + w1 - 1]
+                           + cfa[i + w3 - 3])
+                          - 3.0f * (cfa[i - w2 + 2] + cfa[i + w2 - 2])
+                          + 6.0f * cfa[i]);
+        }
+    }
+    for (int y = 4; y < h - 4; y++) {
+        for (int x = 4 + (y & 1), i = y * w + x; x < w - 4; x += 2, i += 2) {
+            float p = std::max(epssq,
+                               hpf1[i - w1 - 1] + hpf1[i] + hpf1[i + w1 + 1]);
+            float q = std::max(epssq,
+                               hpf2[i - w1 + 1] + hpf2[i] + hpf2[i + w1 - 1]);
+            pq_dir[i] = p / (p + q);
+        }
+    }
+
+    // Blue at R sites and red at B sites, from diagonal color differences.
+    for (int y = 4; y < h - 4; y++) {
+        float* c = (y & 1) ? r : b;
+        for (int x = 4 + (y & 1), i = y * w + x; x < w - 4; x += 2, i += 2) {
+            float pq_c = pq_dir[i];
+            float pq_n = 0.25f
+                         * (pq_dir[i - w1 - 1] + pq_dir[i - w1 + 1]
+                            + pq_dir[i + w1 - 1] + pq_dir[i + w1 + 1]);
+            float pq_disc = std::abs(0.5f - pq_c) < std::abs(0.5f - pq_n)
+                                ? pq_n
+                                : pq_c;
+
+            float nw_grad = eps + std::abs(c[i - w1 - 1] - c[i + w1 + 1])
+                            + std::abs(c[i - w1 - 1] - c[i - w3 - 3])
+                            + std::abs(g[i] - g[i - w2 - 2]);
+            float ne_grad = eps + std::abs(c[i - w1 + 1] - c[i + w1 - 1])
+                            + std::abs(c[i - w1 + 1] - c[i - w3 + 3])
+                            + std::abs(g[i] - g[i - w2 + 2]);
+            float sw_grad = eps + std::abs(c[i - w1 + 1] - c[i + w1 - 1])
+                            + std::abs(c[i + w1 - 1] - c[i + w3 - 3])
+                            + std::abs(g[i] - g[i + w2 - 2]);
+            float se_grad = eps + std::abs(c[i - w1 - 1] - c[i + w1 + 1])
+                            + std::abs(c[i + w1 + 1] - c[i + w3 + 3])
+                            + std::abs(g[i] - g[i + w2 + 2]);
+
+            float nw_est = c[i - w1 - 1] - g[i - w1 - 1];
+            float ne_est = c[i - w1 + 1] - g[i - w1 + 1];
+            float sw_est = c[i + w1 - 1] - g[i + w1 - 1];
+            float se_est = c[i + w1 + 1] - g[i + w1 + 1];
+
+            float p_est = (nw_grad * se_est + se_grad * nw_est)
+                          / (nw_grad + se_grad);
+            float q_est = (ne_grad * sw_est + sw_grad * ne_est)
+                          / (ne_grad + sw_grad);
+            c[i] = g[i] + intp(pq_disc, q_est, p_est);
+        }
+    }
+
+    // Red and blue at G sites, from cardinal color differences.
+    for (int y = 4; y < h - 4; y++) {
+        for (int x = 4 + ((y + 1) & 1), i = y * w + x; x < w - 4;
+             x += 2, i += 2) {
+            float disc = vh_disc(i);
+            for (float* c : { r, b }) {
+                float n_grad = eps + std::abs(g[i] - g[i - w2])
+                               + std::abs(c[i - w1] - c[i + w1])
+                               + std::abs(c[i - w1] - c[i - w3]);
+                float s_grad = eps + std::abs(g[i] - g[i + w2])
+                               + std::abs(c[i + w1] - c[i - w1])
+                               + std::abs(c[i + w1] - c[i + w3]);
+                float w_grad = eps + std::abs(g[i] - g[i - 2])
+                               + std::abs(c[i - 1] - c[i + 1])
+                               + std::abs(c[i - 1] - c[i - 3]);
+                float e_grad = eps + std::abs(g[i] - g[i + 2])
+                               + std::abs(c[i + 1] - c[i - 1])
+                               + std::abs(c[i + 1] - c[i + 3]);
+
+                float n_est = c[i - w1] - g[i - w1];
+                float s_est = c[i + w1] - g[i + w1];
+                float w_est = c[i - 1] - g[i - 1];
+                float e_est = c[i + 1] - g[i + 1];
+
+                float v_est = (n_grad * s_est + s_grad * n_est)
+                              / (n_grad + s_grad);
+                float h_est = (e_grad * w_est + w_grad * e_est)
+                              / (e_grad + w_grad);
+                c[i]        = g[i] + intp(disc, h_est, v_est);
+            }
+        }
+    }
+}
+
+
+
+/// RCD demosaic of `roi`, in tiles that are processed in parallel. Each tile
+/// is read with a margin wide enough for RCD's border.
+template<class Rtype, class Atype>
+static bool
+bayer_demosaic_RCD(ImageBuf& dst, const ImageBuf& src, int x_offset,
+                   int y_offset, const float (&white_balance)[4], ROI roi,
+                   int nthreads)
+{
+    constexpr int tile_size = 256;
+    constexpr int margin    = RCDTile::rcd_border + 3;
+
+    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        RCDTile tile;
+        for (int ty = roi.ybegin; ty < roi.yend; ty += tile_size) {
+            for (int tx = roi.xbegin; tx < roi.xend; tx += tile_size) {
+                int tx1 = std::min(tx + tile_size, roi.xend);
+                int ty1 = std::min(ty + tile_size, roi.yend);
+                // Align the tile origin so that its top left is an R site.
+                int x0 = tx - margin - cfa_mod(tx - margin + x_offset, 2);
+                int y0 = ty - margin - cfa_mod(ty - margin + y_offset, 2);
+                tile.resize(tx1 + margin - x0, ty1 + margin - y0);
+
+                CFAReader<Atype, 2> reader(src, bayer_channel_map, x_offset,
+                                           y_offset, white_balance, x0,
+                                           x0 + tile.width);
+                for (int y = 0; y < tile.height; y++)
+                    reader.read(y0 + y, &tile.cfa[size_t(y) * tile.width]);
+                tile.run();
+
+                for (int y = ty; y < ty1; y++) {
+                    size_t i = size_t(y - y0) * tile.width + (tx - x0);
+                    ImageBuf::Iterator<Rtype> d(dst, tx, tx1, y, y + 1,
+                                                roi.zbegin, roi.zend);
+                    for (; !d.done(); ++d, ++i) {
+                        d[roi.chbegin + 0] = tile.rgb[0][i];
+                        d[roi.chbegin + 1] = tile.rgb[1][i];
+                        d[roi.chbegin + 2] = tile.rgb[2][i];
+                    }
+                }
+            }
+        }
+    });
+    return true;
+}
+
+
 template<class Rtype, class Atype>
 static bool
 bayer_demosaic_linear_impl(ImageBuf& dst, const ImageBuf& src,
@@ -945,9 +1597,31 @@ bayer_demosaic_MHC_impl(ImageBuf& dst, const ImageBuf& src,
                         const float (&white_balance)[4], ROI roi, int nthreads)
 {
     MHCBayerDemosaicing<Rtype, Atype> obj(layout);
+    if (!obj.check_layout(dst))
+        return false;
+    if (demosaic_strips_ok(dst, src, roi, 2))
+        return demosaic_strips<Rtype, Atype, MHCBayerKernel>(
+            dst, src, obj.layout_x_offset(), obj.layout_y_offset(),
+            white_balance, roi, nthreads);
     return obj.process(dst, src, white_balance, roi, nthreads);
+}
 
-    return true;
+template<class Rtype, class Atype>
+static bool
+bayer_demosaic_RCD_impl(ImageBuf& dst, const ImageBuf& src,
+                        const std::string& layout,
+                        const float (&white_balance)[4], ROI roi, int nthreads)
+{
+    // RCD has no per-pixel implementation, so images it can't handle get MHC
+    // instead.
+    MHCBayerDemosaicing<Rtype, Atype> obj(layout);
+    if (!obj.check_layout(dst))
+        return false;
+    if (demosaic_strips_ok(dst, src, roi, 2))
+        return bayer_demosaic_RCD<Rtype, Atype>(dst, src, obj.layout_x_offset(),
+                                                obj.layout_y_offset(),
+                                                white_balance, roi, nthreads);
+    return obj.process(dst, src, white_balance, roi, nthreads);
 }
 
 template<class Rtype, class Atype>
@@ -958,6 +1632,12 @@ xtrans_demosaic_linear_impl(ImageBuf& dst, const ImageBuf& src,
                             int nthreads)
 {
     LinearXTransDemosaicing<Rtype, Atype> obj(layout);
+    if (!obj.check_layout(dst))
+        return false;
+    if (demosaic_strips_ok(dst, src, roi, 6))
+        return demosaic_strips<Rtype, Atype, LinearXTransKernel>(
+            dst, src, obj.layout_x_offset(), obj.layout_y_offset(),
+            white_balance, roi, nthreads);
     return obj.process(dst, src, white_balance, roi, nthreads);
 }
 
@@ -1095,13 +1775,19 @@ demosaic(ImageBuf& dst, const ImageBuf& src, KWArgs options, ROI roi,
                                         bayer_demosaic_linear_impl,
                                         dst.spec().format, src.spec().format,
                                         dst, src, layout, white_balance_RGBG,
-                                        dst_roi, 1);
+                                        dst_roi, nthreads);
         } else if (algorithm == "MHC") {
             OIIO_DISPATCH_COMMON_TYPES2(ok, "bayer_demosaic_MHC",
                                         bayer_demosaic_MHC_impl,
                                         dst.spec().format, src.spec().format,
                                         dst, src, layout, white_balance_RGBG,
-                                        dst_roi, 1);
+                                        dst_roi, nthreads);
+        } else if (algorithm == "RCD") {
+            OIIO_DISPATCH_COMMON_TYPES2(ok, "bayer_demosaic_RCD",
+                                        bayer_demosaic_RCD_impl,
+                                        dst.spec().format, src.spec().format,
+                                        dst, src, layout, white_balance_RGBG,
+                                        dst_roi, nthreads);
         } else {
             dst.errorfmt("ImageBufAlgo::demosaic() invalid algorithm");
         }
@@ -1114,7 +1800,7 @@ demosaic(ImageBuf& dst, const ImageBuf& src, KWArgs options, ROI roi,
                                     xtrans_demosaic_linear_impl,
                                     dst.spec().format, src.spec().format, dst,
                                     src, layout, white_balance_RGBG, dst_roi,
-                                    1);
+                                    nthreads);
     } else {
         dst.errorfmt("ImageBufAlgo::demosaic() invalid pattern");
     }
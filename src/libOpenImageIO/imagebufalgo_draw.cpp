@@ -3,8 +3,12 @@
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstring>
 #include <limits>
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -742,6 +746,8 @@ static std::vector<std::string> font_search_dirs;
 static std::vector<std::string> all_font_files;
 static std::vector<std::string> all_fonts;
 static std::unordered_map<std::string, std::string> font_file_map;
+static std::string enumerated_searchpath;     // What they were found with
+static std::atomic<int> font_enumeration(0);  // Bumped by each enumeration
 static std::mutex font_search_mutex;
 static bool fonts_are_enumerated      = false;
 static const char* font_dir_envvars[] = { "OPENIMAGEIO_FONTS",
@@ -753,6 +759,8 @@ static const char* font_dir_suffixes[]
 
 // list of available font families
 static std::vector<std::string> s_font_families;
+// the font_enumeration that the families were read from
+static int s_font_families_enumeration = -1;
 // available font styles per families
 static std::unordered_map<std::string, std::vector<std::string>> s_font_styles;
 // font filenames per family and style (e.g. "Arial Italic")
@@ -802,13 +810,32 @@ fontpath_add_from_dir(const std::string& dir)
 }
 
 
+// The "font_searchpath" attribute and the font environment variables,
+// which together decide which font files a font name may resolve to.
+static std::string
+current_font_searchpath()
+{
+    std::string searchpath = pvt::font_searchpath.string();
+    for (auto s : font_dir_envvars)
+        searchpath += Strutil::fmt::format("\n{}", Sysutil::getenv(s));
+    return searchpath;
+}
+
+
 static void
 enumerate_fonts()
 {
     std::lock_guard<std::mutex> lock(font_search_mutex);
-    if (fonts_are_enumerated)
+    std::string searchpath = current_font_searchpath();
+    if (fonts_are_enumerated && searchpath == enumerated_searchpath)
         return;  // already done
 
+    // Start over if the search path has changed since the last time.
+    font_search_dirs.clear();
+    all_font_files.clear();
+    all_fonts.clear();
+    font_file_map.clear();
+
     // Find all the existing dirs from the font search path to populate
     // font_search_dirs.
     fontpath_add_from_searchpath(pvt::font_searchpath);
@@ -890,8 +917,10 @@ enumerate_fonts()
     for (auto& f : font_set)
         all_fonts.push_back(f);
 
-    // Don't need to do that again
-    fonts_are_enumerated = true;
+    // Don't need to do that again, until the search path changes
+    fonts_are_enumerated  = true;
+    enumerated_searchpath = searchpath;
+    ++font_enumeration;
 }
 
 
@@ -934,33 +963,141 @@ static const char* default_font_name[] = { "DroidSans", "cour", "Courier New",
 
 
 
+// One character rasterized by FreeType: its 8-bit coverage bitmap, packed
+// `width` bytes per row, and the metrics needed to place it.
+struct Glyph {
+    bool ok     = false;  // false if FreeType could not load the character
+    int left    = 0;      // bitmap offset from the pen position
+    int top     = 0;      //   (top is measured upward)
+    int width   = 0;      // bitmap dimensions
+    int rows    = 0;
+    int advance = 0;      // pen advance, in whole pixels
+    std::vector<unsigned char> bitmap;
+};
+
+
+
+// A font file opened at one pixel size, plus every glyph rasterized from it
+// so far. Glyphs are never evicted, so once published they are found with
+// two atomic loads and no locking. Only the first request for a character
+// takes the mutex and renders it, since an FT_Face may not be used by more
+// than one thread at a time.
+class FontFace {
+public:
+    FontFace(FT_Face face, int fontsize)
+        : m_face(face)
+        , m_fontsize(fontsize)
+    {
+        for (auto& p : m_pages)
+            p.store(nullptr, std::memory_order_relaxed);
+    }
+
+    // Faces are only destroyed at exit; ft_library is never freed.
+    ~FontFace() { FT_Done_Face(m_face); }
+
+    FontFace(const FontFace&) = delete;
+    FontFace& operator=(const FontFace&) = delete;
+
+    int fontsize() const { return m_fontsize; }
+
+    // Return the rasterized glyph for character `ch`, rendering and caching
+    // it first if this is the first time it has been asked for.
+    const Glyph& glyph(uint32_t ch)
+    {
+        if (ch < max_char) {
+            const Page* page = m_pages[ch >> page_bits].load(
+                std::memory_order_acquire);
+            if (page) {
+                const Glyph* g = (*page)[ch & page_mask].load(
+                    std::memory_order_acquire);
+                if (g)
+                    return *g;
+            }
+        }
+        return load_glyph(ch);
+    }
+
+private:
+    static constexpr uint32_t page_bits = 8;
+    static constexpr uint32_t page_size = 1 << page_bits;
+    static constexpr uint32_t page_mask = page_size - 1;
+    static constexpr uint32_t max_char  = 0x110000;  // end of Unicode
+    using Page = std::array<std::atomic<const Glyph*>, page_size>;
+
+    const Glyph& load_glyph(uint32_t ch)
+    {
+        lock_guard lock(m_mutex);
+        if (ch >= max_char)
+            return m_bad_glyph;
+        auto& pageptr = m_pages[ch >> page_bits];
+        Page* page    = pageptr.load(std::memory_order_relaxed);
+        if (!page) {
+            m_page_storage.emplace_back(new Page);
+            page = m_page_storage.back().get();
+            for (auto& g : *page)
+                g.store(nullptr, std::memory_order_relaxed);
+            pageptr.store(page, std::memory_order_release);
+        }
+        auto& slot = (*page)[ch & page_mask];
+        if (const Glyph* g = slot.load(std::memory_order_relaxed))
+            return *g;  // another thread got here first
+
+        std::unique_ptr<Glyph> g(new Glyph);
+        if (!FT_Load_Char(m_face, ch, FT_LOAD_RENDER)) {
+            FT_GlyphSlot ftslot = m_face->glyph;
+            g->ok               = true;
+            g->left             = ftslot->bitmap_left;
+            g->top              = ftslot->bitmap_top;
+            g->width            = int(ftslot->bitmap.width);
+            g->rows             = int(ftslot->bitmap.rows);
+            g->advance          = int(ftslot->advance.x >> 6);
+            g->bitmap.resize(size_t(g->width) * size_t(g->rows));
+            for (int j = 0; j < g->rows; ++j)
+                memcpy(g->bitmap.data() + size_t(j) * g->width,
+                       ftslot->bitmap.buffer + ftslot->bitmap.pitch * j,
+                       g->width);
+        }
+        slot.store(g.get(), std::memory_order_release);
+        m_glyphs.push_back(std::move(g));
+        return *m_glyphs.back();
+    }
+
+    FT_Face m_face;
+    int m_fontsize;
+    std::atomic<Page*> m_pages[max_char >> page_bits];
+    mutex m_mutex;  // guards m_face and everything below
+    std::vector<std::unique_ptr<Page>> m_page_storage;
+    std::vector<std::unique_ptr<Glyph>> m_glyphs;
+    Glyph m_bad_glyph;
+};
+
+
+
 // Helper: given unicode and a font face, compute its size
 static ROI
-text_size_from_unicode(cspan<uint32_t> utext, FT_Face face, int fontsize)
+text_size_from_unicode(cspan<uint32_t> utext, FontFace& face)
 {
-    int y = 0;
-    int x = 0;
+    int fontsize = face.fontsize();
+    int y        = 0;
+    int x        = 0;
     ROI size;
     size.xbegin = size.ybegin = std::numeric_limits<int>::max();
     size.xend = size.yend = std::numeric_limits<int>::min();
-    FT_GlyphSlot slot     = face->glyph;
     for (auto ch : utext) {
         if (ch == '\n') {
             x = 0;
             y += fontsize;
             continue;
         }
-        int error = FT_Load_Char(face, ch, FT_LOAD_RENDER);
-        if (error)
+        const Glyph& g = face.glyph(ch);
+        if (!g.ok)
             continue;  // ignore errors
-        size.ybegin = std::min(size.ybegin, y - slot->bitmap_top);
-        size.yend   = std::max(size.yend, y + int(slot->bitmap.rows)
-                                              - int(slot->bitmap_top) + 1);
-        size.xbegin = std::min(size.xbegin, x + int(slot->bitmap_left));
-        size.xend   = std::max(size.xend, x + int(slot->bitmap.width)
-                                              + int(slot->bitmap_left) + 1);
+        size.ybegin = std::min(size.ybegin, y - g.top);
+        size.yend   = std::max(size.yend, y + g.rows - g.top + 1);
+        size.xbegin = std::min(size.xbegin, x + g.left);
+        size.xend   = std::max(size.xend, x + g.width + g.left + 1);
         // increment pen position
-        x += slot->advance.x >> 6;
+        x += g.advance;
     }
     return size;  // Font rendering not supported
 }
@@ -970,10 +1107,6 @@ text_size_from_unicode(cspan<uint32_t> utext, FT_Face face, int fontsize)
 static void
 init_font_families()
 {
-    // skip if already initialized
-    if (!s_font_families.empty())
-        return;
-
     // If we know FT is broken, don't bother trying again
     if (ft_broken)
         return;
@@ -986,11 +1119,19 @@ init_font_families()
         }
     }
 
+    // skip if already initialized from the current font files
+    const std::vector<std::string>& font_files = pvt::font_file_list();
+    if (s_font_families_enumeration == font_enumeration)
+        return;
+    s_font_families_enumeration = font_enumeration;
+    s_font_families.clear();
+    s_font_styles.clear();
+    s_font_filename_per_family.clear();
+
     // read available fonts
     std::unordered_set<std::string> font_family_set;
     std::unordered_map<std::string, std::unordered_set<std::string>>
         font_style_set;
-    const std::vector<std::string>& font_files = pvt::font_file_list();
     for (const std::string& filename : font_files) {
         // Load the font.
         FT_Face face;
@@ -1120,6 +1261,88 @@ resolve_font(string_view font_, std::string& result)
     return true;
 }
 
+
+
+// Faces opened so far, keyed by the resolved font file and the pixel size.
+// Guarded by ft_mutex. Faces are never closed, since other threads may
+// still be rendering with one that is no longer found by name.
+static std::unordered_map<std::string, std::unique_ptr<FontFace>> font_faces;
+
+// The face found for each font name as requested and pixel size, so that
+// repeated text rendering neither resolves the font nor opens the file
+// again. Lookups take only a shared read lock. A name may resolve to a
+// different file once the font search path changes, so then the names are
+// forgotten and resolved again.
+static spin_rw_mutex font_face_mutex;
+static std::unordered_map<std::string, FontFace*> font_face_names;
+static std::string font_face_names_searchpath;
+
+
+// Find or open the face for the font file at the given pixel size. Return
+// nullptr and put an error message in `err` if it can't be done. The caller
+// must hold ft_mutex.
+static FontFace*
+open_font_face(const std::string& font, int fontsize, std::string& err)
+{
+    std::string key = Strutil::fmt::format("{}\n{}", font, fontsize);
+    auto found      = font_faces.find(key);
+    if (found != font_faces.end())
+        return found->second.get();
+    FT_Face face;  // handle to face object
+    if (FT_New_Face(ft_library, font.c_str(), 0 /* face index */, &face)) {
+        err = Strutil::fmt::format("Could not set font face to \"{}\"", font);
+        return nullptr;  // couldn't open the face
+    }
+    if (FT_Set_Pixel_Sizes(face /*handle*/, 0 /*width*/,
+                           fontsize /*height*/)) {
+        FT_Done_Face(face);
+        err = Strutil::fmt::format("Could not set font size to {}", fontsize);
+        return nullptr;  // couldn't set the character size
+    }
+    std::unique_ptr<FontFace> ff(new FontFace(face, fontsize));
+    FontFace* result = ff.get();
+    font_faces[key]  = std::move(ff);
+    return result;
+}
+
+
+// Find or open the face for the named font at the given pixel size. Return
+// nullptr and put an error message in `err` if it can't be done.
+static FontFace*
+find_font_face(string_view font_, int fontsize, std::string& err)
+{
+    std::string searchpath = current_font_searchpath();
+    std::string key        = Strutil::fmt::format("{}\n{}", font_, fontsize);
+    {
+        spin_rw_read_lock lock(font_face_mutex);
+        if (searchpath == font_face_names_searchpath) {
+            auto found = font_face_names.find(key);
+            if (found != font_face_names.end())
+                return found->second;
+        }
+    }
+
+    // Not seen before, or the search path has changed. FT_New_Face and the
+    // font search are serialized by ft_mutex, which also keeps two threads
+    // from opening the same face.
+    lock_guard ft_lock(ft_mutex);
+    std::string font;
+    if (!resolve_font(font_, font)) {
+        err = font.size() ? font : "Font error";
+        return nullptr;
+    }
+    FontFace* result = open_font_face(font, fontsize, err);
+    if (!result)
+        return nullptr;
+    spin_rw_write_lock lock(font_face_mutex);
+    if (searchpath != font_face_names_searchpath) {
+        font_face_names.clear();
+        font_face_names_searchpath = searchpath;
+    }
+    font_face_names[key] = result;
+    return result;
+}
+
 }  // namespace
 #endif
 
@@ -1135,35 +1358,15 @@ ImageBufAlgo::text_size(string_view text, int fontsize, string_view font_)
     OIIO::pvt::LoggedTimer logtime("IBA::text_size");
     ROI size;
 #ifdef USE_FREETYPE
-    // Thread safety
-    lock_guard ft_lock(ft_mutex);
-
-    std::string font;
-    bool ok = resolve_font(font_, font);
-    if (!ok) {
+    std::string err;
+    FontFace* face = find_font_face(font_, fontsize, err);
+    if (!face)
         return size;
-    }
-
-    int error = 0;
-    FT_Face face;  // handle to face object
-    error = FT_New_Face(ft_library, font.c_str(), 0 /* face index */, &face);
-    if (error) {
-        return size;  // couldn't open the face
-    }
-
-    error = FT_Set_Pixel_Sizes(face /*handle*/, 0 /*width*/,
-                               fontsize /*height*/);
-    if (error) {
-        FT_Done_Face(face);
-        return size;  // couldn't set the character size
-    }
 
     std::vector<uint32_t> utext;
     utext.reserve(text.size());
     Strutil::utf8_to_unicode(text, utext);
-    size = text_size_from_unicode(utext, face, fontsize);
-
-    FT_Done_Face(face);
+    size = text_size_from_unicode(utext, *face);
 #endif
 
     return size;  // Font rendering not supported
@@ -1176,7 +1379,7 @@ ImageBufAlgo::render_text(ImageBuf& R, int x, int y, string_view text,
                           int fontsize, string_view font_,
                           cspan<float> textcolor, TextAlignX alignx,
                           TextAlignY aligny, int shadow, ROI roi,
-                          int /*nthreads*/)
+                          int nthreads)
 {
     OIIO::pvt::LoggedTimer logtime("IBA::render_text");
     if (R.spec().depth > 1) {
@@ -1185,34 +1388,15 @@ ImageBufAlgo::render_text(ImageBuf& R, int x, int y, string_view text,
     }
 
 #ifdef USE_FREETYPE
-    // Thread safety
-    lock_guard ft_lock(ft_mutex);
-
-    std::string font;
-    bool ok = resolve_font(font_, font);
-    if (!ok) {
-        std::string err = font.size() ? font : "Font error";
+    // Faces and glyphs are cached and safe to share, so many threads may
+    // render text at once.
+    std::string err;
+    FontFace* face = find_font_face(font_, fontsize, err);
+    if (!face) {
         R.errorfmt("{}", err);
         return false;
     }
 
-    int error = 0;
-    FT_Face face;  // handle to face object
-    error = FT_New_Face(ft_library, font.c_str(), 0 /* face index */, &face);
-    if (error) {
-        R.errorfmt("Could not set font face to \"{}\"", font);
-        return false;  // couldn't open the face
-    }
-
-    error = FT_Set_Pixel_Sizes(face /*handle*/, 0 /*width*/,
-                               fontsize /*height*/);
-    if (error) {
-        FT_Done_Face(face);
-        R.errorfmt("Could not set font size to {}", fontsize);
-        return false;  // couldn't set the character size
-    }
-
-    FT_GlyphSlot slot = face->glyph;  // a small shortcut
     int nchannels(R.nchannels());
     IBA_FIX_PERCHAN_LEN_DEF(textcolor, nchannels);
 
@@ -1235,7 +1419,7 @@ ImageBufAlgo::render_text(ImageBuf& R, int x, int y, string_view text,
     Strutil::utf8_to_unicode(text, utext);
 
     // Compute the size that the text will render as, into an ROI
-    ROI textroi     = text_size_from_unicode(utext, face, fontsize);
+    ROI textroi     = text_size_from_unicode(utext, *face);
     textroi.zbegin  = 0;
     textroi.zend    = 1;
     textroi.chbegin = 0;
@@ -1276,21 +1460,23 @@ ImageBufAlgo::render_text(ImageBuf& R, int x, int y, string_view text,
             y += fontsize;
             continue;
         }
-        int error = FT_Load_Char(face, ch, FT_LOAD_RENDER);
-        if (error)
+        const Glyph& g = face->glyph(ch);
+        if (!g.ok)
             continue;  // ignore errors
-        // now, draw to our target surface
-        for (int j = 0; j < static_cast<int>(slot->bitmap.rows); ++j) {
-            int ry = y + j - slot->bitmap_top;
-            for (int i = 0; i < static_cast<int>(slot->bitmap.width); ++i) {
-                int rx  = x + i + slot->bitmap_left;
-                float b = slot->bitmap.buffer[slot->bitmap.pitch * j + i]
-                          / 255.0f;
-                textimg.setpixel(rx, ry, b);
-            }
+        // now, draw to our target surface, clipped to its bounds
+        int x0     = x + g.left;
+        int y0     = y - g.top;
+        int ibegin = std::max(0, textroi.xbegin - x0);
+        int iend   = std::min(g.width, textroi.xend - x0);
+        int jbegin = std::max(0, textroi.ybegin - y0);
+        int jend   = std::min(g.rows, textroi.yend - y0);
+        for (int j = jbegin; j < jend; ++j) {
+            float* t = (float*)textimg.pixeladdr(x0 + ibegin, y0 + j);
+            for (int i = ibegin; i < iend; ++i)
+                *t++ = g.bitmap[size_t(j) * g.width + i] / 255.0f;
         }
         // increment pen position
-        x += slot->advance.x >> 6;
+        x += g.advance;
     }
 
     // Generate the alpha image -- if drop shadow is requested, dilate,
@@ -1308,20 +1494,16 @@ ImageBufAlgo::render_text(ImageBuf& R, int x, int y, string_view text,
     roi = roi_intersection(textroi, R.roi());
 
     // Now fill in the pixels of our destination image
-    span<float> pixelcolor = OIIO_ALLOCA_SPAN(float, nchannels);
-    ImageBuf::ConstIterator<float> t(textimg, roi, ImageBuf::WrapBlack);
-    ImageBuf::ConstIterator<float> a(alphaimg, roi, ImageBuf::WrapBlack);
-    ImageBuf::Iterator<float> r(R, roi);
-    for (; !r.done(); ++r, ++t, ++a) {
-        float val   = t[0];
-        float alpha = a[0] * textalpha;
-        R.getpixel(r.x(), r.y(), pixelcolor);
-        for (int c = 0; c < nchannels; ++c)
-            pixelcolor[c] = val * textcolor[c] + (1.0f - alpha) * pixelcolor[c];
-        R.setpixel(r.x(), r.y(), pixelcolor);
-    }
-
-    FT_Done_Face(face);
+    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        ImageBuf::ConstIterator<float> t(textimg, roi, ImageBuf::WrapBlack);
+        ImageBuf::ConstIterator<float> a(alphaimg, roi, ImageBuf::WrapBlack);
+        for (ImageBuf::Iterator<float> r(R, roi); !r.done(); ++r, ++t, ++a) {
+            float val   = t[0];
+            float alpha = a[0] * textalpha;
+            for (int c = 0; c < nchannels; ++c)
+                r[c] = val * textcolor[c] + (1.0f - alpha) * r[c];
+        }
+    });
     return true;
 
 #else
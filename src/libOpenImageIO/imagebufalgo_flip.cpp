@@ -167,6 +167,7 @@
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagebufalgo_util.h>
+#include <OpenImageIO/parallel.h>
 #include <OpenImageIO/strutil.h>
 
 using Imath::Color3f;
@@ -467,110 +468,227 @@ build_feature_kernel(float ppd)
 // LDR-FLIP implementation
 // ---------------------------------------------------------------------------
 
-// Run the full LDR-FLIP pipeline.
-// ref and test must be float images with 3 channels.
-// Inputs are in linear Rec.709 RGB, values expected in [0,1].
-// dst is set to a 1-channel float image of the same spatial extent as roi,
-// with pixel values in [0,1].
-// Returns false and sets dst error on failure.
-static bool
-LDR_FLIP(ImageBuf& dst, const ImageBuf& ref, const ImageBuf& test, float ppd,
-         ROI roi, int nthreads)
+// Tone mapping curves that HDR-FLIP may apply before each LDR-FLIP pass.
+// Coefficients from FLIP.h ToneMappingCoefficients, layout:
+//     pixel = (c^2*a[0] + c*a[1] + a[2]) / (c^2*a[3] + c*a[4] + a[5])
+// Reinhard is special-cased (uses luminance-based formula).
+static constexpr float tc_aces[6]
+    = { 0.6f * 0.6f * 2.51f, 0.6f * 0.03f, 0.0f,
+        0.6f * 0.6f * 2.43f, 0.6f * 0.59f, 0.14f };
+static constexpr float tc_hable[6] = { 0.231683f, 0.013791f, 0.0f,
+                                       0.18f,     0.3f,      0.018f };
+
+enum class FlipTonemap { ACES, Hable, Reinhard };
+
+static FlipTonemap
+flip_tonemap(string_view tonemapper)
 {
-    OIIO_ASSERT(ref.nchannels() >= 3);
-    const int w = roi.width();
-    const int h = roi.height();
-    if (w == 0 || h == 0)
-        return true;
+    return tonemapper == "reinhard" ? FlipTonemap::Reinhard
+           : tonemapper == "hable"  ? FlipTonemap::Hable
+                                    : FlipTonemap::ACES;
+}
+
+
+// Tonemap a single float3 channel triple.
+inline float
+tonemap_channel(float c, const float tc[6])
+{
+    float num = c * c * tc[0] + c * tc[1] + tc[2];
+    float den = c * c * tc[3] + c * tc[4] + tc[5];
+    return den > 0.0f ? num / den : 0.0f;
+}
+
+
+inline Color3f
+clamp01(const Color3f& c)
+{
+    return Color3f(OIIO::clamp(c[0], 0.0f, 1.0f), OIIO::clamp(c[1], 0.0f, 1.0f),
+                   OIIO::clamp(c[2], 0.0f, 1.0f));
+}
+
+
+// Apply exposure multiplier `m`, tone map, and clamp to [0,1] -- what
+// HDR-FLIP does to both images for each exposure before running LDR-FLIP.
+inline Color3f
+expose_tonemap_clamp(const Color3f& c, float m, FlipTonemap tonemapper)
+{
+    float r = c[0] * m, g = c[1] * m, b = c[2] * m;
+    if (tonemapper == FlipTonemap::Reinhard) {
+        // Reinhard: out = c / (1 + luminance)
+        float lum = 0.2126f * r + 0.7152f * g + 0.0722f * b;
+        float d   = 1.0f + lum;
+        r /= d;
+        g /= d;
+        b /= d;
+    } else {
+        const float* tc = tonemapper == FlipTonemap::Hable ? tc_hable
+                                                           : tc_aces;
+        r = tonemap_channel(r, tc);
+        g = tonemap_channel(g, tc);
+        b = tonemap_channel(b, tc);
+    }
+    return clamp01(Color3f(r, g, b));
+}
+
+
+
+// Everything about a FLIP comparison that depends on neither the pixels nor
+// the exposure, computed once.
+struct FlipSetup {
+    SpatialKernels sk;
+    FeatureKernel fk;
+    float cmax;    // Maximum color distance
+    float pccmax;  // Knee of the color distance remap
+    int radius;    // Widest filter radius, the halo each tile needs
+    FlipSetup(float ppd)
+        : sk(build_spatial_kernels(ppd))
+        , fk(build_feature_kernel(ppd))
+        , cmax(flip_max_color_distance())
+        , pccmax(FLIP_gpc * cmax)
+        , radius(std::max(sk.radius, fk.radius))
+    {
+    }
+};
+
+
+
+// Scratch space for running LDR-FLIP on one tile. It's reused for all the
+// exposures of a tile and all the tiles that one thread processes.
+struct FlipTileBuffers {
+    std::vector<float> refYCC, tstYCC;      // tile + halo, 3 chans
+    std::vector<float> iRefY, iRefCx, iRefCz1, iRefCz2;
+    std::vector<float> iTstY, iTstCx, iTstCz1, iTstCz2;
+    std::vector<float> colorDiff;           // tile
+    std::vector<float> iFeatRefDx, iFeatRefDdx, iFeatRefG;
+    std::vector<float> iFeatTstDx, iFeatTstDdx, iFeatTstG;
+    std::vector<float> result;              // tile
+};
+
+
+
+// Pixels of the 3-channel float images compared by FLIP, with the
+// scanline stride (in floats) of each.
+struct FlipImages {
+    const float* ref;
+    const float* test;
+    stride_t refystride;
+    stride_t testystride;
+    int w, h;
+};
+
+
+
+// Run the full LDR-FLIP pipeline for the pixels of `tile` (coordinates
+// relative to the image origin), leaving the results in b.result.
+//
+// The filters clamp their lookups to the edges of the whole image, so each
+// tile first converts a halo of `radius` pixels around itself. Every pixel
+// goes through exactly the same arithmetic, in the same order, as it would
+// if the whole image were processed in one piece.
+//
+// If `hdr` is true, pixels are first exposed by multiplier `m` and tone
+// mapped (HDR-FLIP); otherwise they are just clamped to [0,1].
+static void
+LDR_FLIP_tile(const FlipImages& img, const FlipSetup& setup, ROI tile,
+              bool hdr, float m, FlipTonemap tonemapper, FlipTileBuffers& b)
+{
+    const int w  = img.w;
+    const int h  = img.h;
+    const int tw = tile.width();
+    const int th = tile.height();
+    const SpatialKernels& sk(setup.sk);
+    const FeatureKernel& fk(setup.fk);
+    const int sr = sk.radius;
+    const int fr = fk.radius;
+
+    // The tile plus its halo, clamped to the image
+    const int ex0 = std::max(0, tile.xbegin - setup.radius);
+    const int ex1 = std::min(w, tile.xend + setup.radius);
+    const int ey0 = std::max(0, tile.ybegin - setup.radius);
+    const int ey1 = std::min(h, tile.yend + setup.radius);
+    const int ew  = ex1 - ex0;
+    const int eh  = ey1 - ey0;
 
     // ------------------------------------------------------------------
     // Step 1: Convert both images to YCxCz, clamping to [0,1] first.
-    // Stored as flat float arrays [y*w + x]*3.
+    // Stored as flat float arrays [y*ew + x]*3.
     // ------------------------------------------------------------------
-    std::vector<float> refYCC(w * h * 3);
-    std::vector<float> tstYCC(w * h * 3);
-
-    ImageBufAlgo::parallel_image(
-        ROI(roi.xbegin, roi.xend, roi.ybegin, roi.yend, 0, 1, 0, 1), nthreads,
-        [&](ROI r) {
-            ImageBuf::ConstIterator<float> rit(ref, r);
-            ImageBuf::ConstIterator<float> tit(test, r);
-            for (; !rit.done(); ++rit, ++tit) {
-                int lx = rit.x() - roi.xbegin;
-                int ly = rit.y() - roi.ybegin;
-                Color3f rRGB(OIIO::clamp(rit[0], 0.0f, 1.0f),
-                             OIIO::clamp(rit[1], 0.0f, 1.0f),
-                             OIIO::clamp(rit[2], 0.0f, 1.0f));
-                Color3f tRGB(OIIO::clamp(tit[0], 0.0f, 1.0f),
-                             OIIO::clamp(tit[1], 0.0f, 1.0f),
-                             OIIO::clamp(tit[2], 0.0f, 1.0f));
-                Color3f rYCC    = linearRGB_to_YCxCz(rRGB);
-                Color3f tYCC    = linearRGB_to_YCxCz(tRGB);
-                int idx         = (ly * w + lx) * 3;
-                refYCC[idx]     = rYCC[0];
-                refYCC[idx + 1] = rYCC[1];
-                refYCC[idx + 2] = rYCC[2];
-                tstYCC[idx]     = tYCC[0];
-                tstYCC[idx + 1] = tYCC[1];
-                tstYCC[idx + 2] = tYCC[2];
-            }
-        });
+    b.refYCC.resize(ew * eh * 3);
+    b.tstYCC.resize(ew * eh * 3);
+    for (int y = ey0; y < ey1; ++y) {
+        const float* rp = img.ref + y * img.refystride + ex0 * 3;
+        const float* tp = img.test + y * img.testystride + ex0 * 3;
+        float* rYCC     = b.refYCC.data() + (y - ey0) * ew * 3;
+        float* tYCC     = b.tstYCC.data() + (y - ey0) * ew * 3;
+        for (int x = 0; x < ew; ++x, rp += 3, tp += 3, rYCC += 3, tYCC += 3) {
+            Color3f rRGB(rp[0], rp[1], rp[2]);
+            Color3f tRGB(tp[0], tp[1], tp[2]);
+            rRGB       = hdr ? expose_tonemap_clamp(rRGB, m, tonemapper)
+                             : clamp01(rRGB);
+            tRGB       = hdr ? expose_tonemap_clamp(tRGB, m, tonemapper)
+                             : clamp01(tRGB);
+            Color3f rc = linearRGB_to_YCxCz(rRGB);
+            Color3f tc = linearRGB_to_YCxCz(tRGB);
+            rYCC[0]    = rc[0];
+            rYCC[1]    = rc[1];
+            rYCC[2]    = rc[2];
+            tYCC[0]    = tc[0];
+            tYCC[1]    = tc[1];
+            tYCC[2]    = tc[2];
+        }
+    }
 
     // ------------------------------------------------------------------
-    // Step 2: Spatial CSF filter — separable, two kernel variants.
-    //
-    // Intermediate arrays (x-direction pass results):
-    //   iRefY, iRefCx, iRefCz1, iRefCz2  [h*w floats each]
-    //   iTstY, iTstCx, iTstCz1, iTstCz2
+    // Step 2: Spatial CSF filter -- separable, two kernel variants.
+    // x-direction pass over the tile's columns, for the tile's rows plus
+    // the spatial filter radius above and below.
     // ------------------------------------------------------------------
-    SpatialKernels sk = build_spatial_kernels(ppd);
-    const int sr      = sk.radius;
-
-    std::vector<float> iRefY(w * h, 0.0f), iRefCx(w * h, 0.0f);
-    std::vector<float> iRefCz1(w * h, 0.0f), iRefCz2(w * h, 0.0f);
-    std::vector<float> iTstY(w * h, 0.0f), iTstCx(w * h, 0.0f);
-    std::vector<float> iTstCz1(w * h, 0.0f), iTstCz2(w * h, 0.0f);
-
-    // x-direction pass
-    ImageBufAlgo::parallel_image(
-        ROI(roi.xbegin, roi.xend, roi.ybegin, roi.yend, 0, 1, 0, 1), nthreads,
-        [&](ROI r) {
-            for (int gy = r.ybegin; gy < r.yend; ++gy) {
-                int ly = gy - roi.ybegin;
-                for (int lx = 0; lx < w; ++lx) {
-                    float ry = 0, rcx = 0, rcz1 = 0, rcz2 = 0;
-                    float ty = 0, tcx = 0, tcz1 = 0, tcz2 = 0;
-                    for (int ix = -sr; ix <= sr; ++ix) {
-                        int xx    = OIIO::clamp(lx + ix, 0, w - 1);
-                        int fi    = ix + sr;
-                        int idx   = (ly * w + xx) * 3;
-                        float rY  = refYCC[idx];
-                        float rCx = refYCC[idx + 1];
-                        float rCz = refYCC[idx + 2];
-                        float tY  = tstYCC[idx];
-                        float tCx = tstYCC[idx + 1];
-                        float tCz = tstYCC[idx + 2];
-                        ry += sk.wY[fi] * rY;
-                        rcx += sk.wCx[fi] * rCx;
-                        rcz1 += sk.wCz1[fi] * rCz;
-                        rcz2 += sk.wCz2[fi] * rCz;
-                        ty += sk.wY[fi] * tY;
-                        tcx += sk.wCx[fi] * tCx;
-                        tcz1 += sk.wCz1[fi] * tCz;
-                        tcz2 += sk.wCz2[fi] * tCz;
-                    }
-                    int oi      = ly * w + lx;
-                    iRefY[oi]   = ry;
-                    iRefCx[oi]  = rcx;
-                    iRefCz1[oi] = rcz1;
-                    iRefCz2[oi] = rcz2;
-                    iTstY[oi]   = ty;
-                    iTstCx[oi]  = tcx;
-                    iTstCz1[oi] = tcz1;
-                    iTstCz2[oi] = tcz2;
-                }
+    const int sy0 = std::max(0, tile.ybegin - sr);
+    const int sy1 = std::min(h, tile.yend + sr);
+    const int sn  = (sy1 - sy0) * tw;
+    b.iRefY.resize(sn);
+    b.iRefCx.resize(sn);
+    b.iRefCz1.resize(sn);
+    b.iRefCz2.resize(sn);
+    b.iTstY.resize(sn);
+    b.iTstCx.resize(sn);
+    b.iTstCz1.resize(sn);
+    b.iTstCz2.resize(sn);
+    for (int gy = sy0; gy < sy1; ++gy) {
+        int ey = gy - ey0;
+        for (int gx = tile.xbegin; gx < tile.xend; ++gx) {
+            float ry = 0, rcx = 0, rcz1 = 0, rcz2 = 0;
+            float ty = 0, tcx = 0, tcz1 = 0, tcz2 = 0;
+            for (int ix = -sr; ix <= sr; ++ix) {
+                int xx    = OIIO::clamp(gx + ix, 0, w - 1);
+                int fi    = ix + sr;
+                int idx   = (ey * ew + xx - ex0) * 3;
+                float rY  = b.refYCC[idx];
+                float rCx = b.refYCC[idx + 1];
+                float rCz = b.refYCC[idx + 2];
+                float tY  = b.tstYCC[idx];
+                float tCx = b.tstYCC[idx + 1];
+                float tCz = b.tstYCC[idx + 2];
+                ry += sk.wY[fi] * rY;
+                rcx += sk.wCx[fi] * rCx;
+                rcz1 += sk.wCz1[fi] * rCz;
+                rcz2 += sk.wCz2[fi] * rCz;
+                ty += sk.wY[fi] * tY;
+                tcx += sk.wCx[fi] * tCx;
+                tcz1 += sk.wCz1[fi] * tCz;
+                tcz2 += sk.wCz2[fi] * tCz;
             }
-        });
+            int oi        = (gy - sy0) * tw + gx - tile.xbegin;
+            b.iRefY[oi]   = ry;
+            b.iRefCx[oi]  = rcx;
+            b.iRefCz1[oi] = rcz1;
+            b.iRefCz2[oi] = rcz2;
+            b.iTstY[oi]   = ty;
+            b.iTstCx[oi]  = tcx;
+            b.iTstCz1[oi] = tcz1;
+            b.iTstCz2[oi] = tcz2;
+        }
+    }
 
     // ------------------------------------------------------------------
     // Step 3: y-direction pass + compute color difference.
@@ -578,261 +696,248 @@ LDR_FLIP(ImageBuf& dst, const ImageBuf& ref, const ImageBuf& test, float ppd,
     // RGB (clamping), convert to CIELab + Hunt, compute HyAB^gqc,
     // apply piecewise remap to [0,1].
     // ------------------------------------------------------------------
-    const float cmax   = flip_max_color_distance();  // precomputed once
-    const float pccmax = FLIP_gpc * cmax;
-
-    std::vector<float> colorDiff(w * h, 0.0f);
-
-    ImageBufAlgo::parallel_image(
-        ROI(roi.xbegin, roi.xend, roi.ybegin, roi.yend, 0, 1, 0, 1), nthreads,
-        [&](ROI r) {
-            for (int gy = r.ybegin; gy < r.yend; ++gy) {
-                int ly = gy - roi.ybegin;
-                for (int lx = 0; lx < w; ++lx) {
-                    float rY = 0, rCx = 0, rCz1 = 0, rCz2 = 0;
-                    float tY = 0, tCx = 0, tCz1 = 0, tCz2 = 0;
-                    for (int iy = -sr; iy <= sr; ++iy) {
-                        int yy = OIIO::clamp(ly + iy, 0, h - 1);
-                        int fi = iy + sr;
-                        int si = yy * w + lx;
-                        rY += sk.wY[fi] * iRefY[si];
-                        rCx += sk.wCx[fi] * iRefCx[si];
-                        rCz1 += sk.wCz1[fi] * iRefCz1[si];
-                        rCz2 += sk.wCz2[fi] * iRefCz2[si];
-                        tY += sk.wY[fi] * iTstY[si];
-                        tCx += sk.wCx[fi] * iTstCx[si];
-                        tCz1 += sk.wCz1[fi] * iTstCz1[si];
-                        tCz2 += sk.wCz2[fi] * iTstCz2[si];
-                    }
-
-                    // Reconstruct YCxCz, back to linear RGB, clamp, then to CIELab
-                    Color3f rYCxCz(rY, rCx, rCz1 + rCz2);
-                    Color3f tYCxCz(tY, tCx, tCz1 + tCz2);
-                    Color3f rRGB = XYZ_to_linearRGB(YCxCz_to_XYZ(rYCxCz));
-                    Color3f tRGB = XYZ_to_linearRGB(YCxCz_to_XYZ(tYCxCz));
-                    rRGB[0]      = OIIO::clamp(rRGB[0], 0.0f, 1.0f);
-                    rRGB[1]      = OIIO::clamp(rRGB[1], 0.0f, 1.0f);
-                    rRGB[2]      = OIIO::clamp(rRGB[2], 0.0f, 1.0f);
-                    tRGB[0]      = OIIO::clamp(tRGB[0], 0.0f, 1.0f);
-                    tRGB[1]      = OIIO::clamp(tRGB[1], 0.0f, 1.0f);
-                    tRGB[2]      = OIIO::clamp(tRGB[2], 0.0f, 1.0f);
-
-                    Color3f rLab = hunt_adjust(
-                        XYZ_to_CIELab(linearRGB_to_XYZ(rRGB)));
-                    Color3f tLab = hunt_adjust(
-                        XYZ_to_CIELab(linearRGB_to_XYZ(tRGB)));
-
-                    float cd = std::pow(hyab(rLab, tLab), FLIP_gqc);
-
-                    // Piecewise remap [0, cmax] -> [0, 1]
-                    if (cd < pccmax)
-                        cd = cd * FLIP_gpt / pccmax;
-                    else
-                        cd = FLIP_gpt
-                             + (cd - pccmax) / (cmax - pccmax)
-                                   * (1.0f - FLIP_gpt);
-
-                    colorDiff[ly * w + lx] = cd;
-                }
+    const float cmax   = setup.cmax;
+    const float pccmax = setup.pccmax;
+    b.colorDiff.resize(tw * th);
+    for (int gy = tile.ybegin; gy < tile.yend; ++gy) {
+        for (int gx = tile.xbegin; gx < tile.xend; ++gx) {
+            int lx   = gx - tile.xbegin;
+            float rY = 0, rCx = 0, rCz1 = 0, rCz2 = 0;
+            float tY = 0, tCx = 0, tCz1 = 0, tCz2 = 0;
+            for (int iy = -sr; iy <= sr; ++iy) {
+                int yy = OIIO::clamp(gy + iy, 0, h - 1);
+                int fi = iy + sr;
+                int si = (yy - sy0) * tw + lx;
+                rY += sk.wY[fi] * b.iRefY[si];
+                rCx += sk.wCx[fi] * b.iRefCx[si];
+                rCz1 += sk.wCz1[fi] * b.iRefCz1[si];
+                rCz2 += sk.wCz2[fi] * b.iRefCz2[si];
+                tY += sk.wY[fi] * b.iTstY[si];
+                tCx += sk.wCx[fi] * b.iTstCx[si];
+                tCz1 += sk.wCz1[fi] * b.iTstCz1[si];
+                tCz2 += sk.wCz2[fi] * b.iTstCz2[si];
             }
-        });
+
+            // Reconstruct YCxCz, back to linear RGB, clamp, then to CIELab
+            Color3f rYCxCz(rY, rCx, rCz1 + rCz2);
+            Color3f tYCxCz(tY, tCx, tCz1 + tCz2);
+            Color3f rRGB = clamp01(XYZ_to_linearRGB(YCxCz_to_XYZ(rYCxCz)));
+            Color3f tRGB = clamp01(XYZ_to_linearRGB(YCxCz_to_XYZ(tYCxCz)));
+
+            Color3f rLab = hunt_adjust(XYZ_to_CIELab(linearRGB_to_XYZ(rRGB)));
+            Color3f tLab = hunt_adjust(XYZ_to_CIELab(linearRGB_to_XYZ(tRGB)));
+
+            float cd = std::pow(hyab(rLab, tLab), FLIP_gqc);
+
+            // Piecewise remap [0, cmax] -> [0, 1]
+            if (cd < pccmax)
+                cd = cd * FLIP_gpt / pccmax;
+            else
+                cd = FLIP_gpt
+                     + (cd - pccmax) / (cmax - pccmax) * (1.0f - FLIP_gpt);
+
+            b.colorDiff[(gy - tile.ybegin) * tw + lx] = cd;
+        }
+    }
 
     // ------------------------------------------------------------------
-    // Step 4: Feature (edge/point) filter — x-direction pass.
+    // Step 4: Feature (edge/point) filter -- x-direction pass.
     // Operates on the Y channel of YCxCz, normalized to [0,1].
     // Intermediate per pixel: (dx, ddx, gauss_Y).
     // ------------------------------------------------------------------
-    FeatureKernel fk = build_feature_kernel(ppd);
-    const int fr     = fk.radius;
-
-    std::vector<float> iFeatRefDx(w * h, 0.0f), iFeatRefDdx(w * h, 0.0f);
-    std::vector<float> iFeatRefG(w * h, 0.0f);
-    std::vector<float> iFeatTstDx(w * h, 0.0f), iFeatTstDdx(w * h, 0.0f);
-    std::vector<float> iFeatTstG(w * h, 0.0f);
+    const int fy0 = std::max(0, tile.ybegin - fr);
+    const int fy1 = std::min(h, tile.yend + fr);
+    const int fn  = (fy1 - fy0) * tw;
+    b.iFeatRefDx.resize(fn);
+    b.iFeatRefDdx.resize(fn);
+    b.iFeatRefG.resize(fn);
+    b.iFeatTstDx.resize(fn);
+    b.iFeatTstDdx.resize(fn);
+    b.iFeatTstG.resize(fn);
 
     constexpr float oneOver116     = 1.0f / 116.0f;
     constexpr float sixteenOver116 = 16.0f / 116.0f;
 
-    ImageBufAlgo::parallel_image(
-        ROI(roi.xbegin, roi.xend, roi.ybegin, roi.yend, 0, 1, 0, 1), nthreads,
-        [&](ROI r) {
-            for (int gy = r.ybegin; gy < r.yend; ++gy) {
-                int ly = gy - roi.ybegin;
-                for (int lx = 0; lx < w; ++lx) {
-                    float dxR = 0, ddxR = 0, gR = 0;
-                    float dxT = 0, ddxT = 0, gT = 0;
-                    for (int ix = -fr; ix <= fr; ++ix) {
-                        int xx = OIIO::clamp(lx + ix, 0, w - 1);
-                        int fi = ix + fr;
-                        // Y is channel 0 of YCxCz; normalize to [0,1]
-                        float yR = refYCC[(ly * w + xx) * 3] * oneOver116
-                                   + sixteenOver116;
-                        float yT = tstYCC[(ly * w + xx) * 3] * oneOver116
-                                   + sixteenOver116;
-                        dxR += fk.wDG[fi] * yR;
-                        ddxR += fk.wDDG[fi] * yR;
-                        gR += fk.wG[fi] * yR;
-                        dxT += fk.wDG[fi] * yT;
-                        ddxT += fk.wDDG[fi] * yT;
-                        gT += fk.wG[fi] * yT;
-                    }
-                    int oi          = ly * w + lx;
-                    iFeatRefDx[oi]  = dxR;
-                    iFeatRefDdx[oi] = ddxR;
-                    iFeatRefG[oi]   = gR;
-                    iFeatTstDx[oi]  = dxT;
-                    iFeatTstDdx[oi] = ddxT;
-                    iFeatTstG[oi]   = gT;
-                }
+    for (int gy = fy0; gy < fy1; ++gy) {
+        int ey = gy - ey0;
+        for (int gx = tile.xbegin; gx < tile.xend; ++gx) {
+            float dxR = 0, ddxR = 0, gR = 0;
+            float dxT = 0, ddxT = 0, gT = 0;
+            for (int ix = -fr; ix <= fr; ++ix) {
+                int xx  = OIIO::clamp(gx + ix, 0, w - 1);
+                int fi  = ix + fr;
+                int idx = (ey * ew + xx - ex0) * 3;
+                // Y is channel 0 of YCxCz; normalize to [0,1]
+                float yR = b.refYCC[idx] * oneOver116 + sixteenOver116;
+                float yT = b.tstYCC[idx] * oneOver116 + sixteenOver116;
+                dxR += fk.wDG[fi] * yR;
+                ddxR += fk.wDDG[fi] * yR;
+                gR += fk.wG[fi] * yR;
+                dxT += fk.wDG[fi] * yT;
+                ddxT += fk.wDDG[fi] * yT;
+                gT += fk.wG[fi] * yT;
             }
-        });
+            int oi            = (gy - fy0) * tw + gx - tile.xbegin;
+            b.iFeatRefDx[oi]  = dxR;
+            b.iFeatRefDdx[oi] = ddxR;
+            b.iFeatRefG[oi]   = gR;
+            b.iFeatTstDx[oi]  = dxT;
+            b.iFeatTstDdx[oi] = ddxT;
+            b.iFeatTstG[oi]   = gT;
+        }
+    }
 
     // ------------------------------------------------------------------
     // Step 5: Feature filter y-direction pass + final combine.
     // For each pixel: compute edge/point differences, then
     //   flip = colorDiff ^ (1 - featureDiff)
-    // Write directly to the output array, then set_pixels into dst.
     // ------------------------------------------------------------------
     constexpr float normFactor = 1.0f / 1.4142135623730951f;  // 1/sqrt(2)
 
-    std::vector<float> result(w * h, 0.0f);
-
-    ImageBufAlgo::parallel_image(
-        ROI(roi.xbegin, roi.xend, roi.ybegin, roi.yend, 0, 1, 0, 1), nthreads,
-        [&](ROI r) {
-            for (int gy = r.ybegin; gy < r.yend; ++gy) {
-                int ly = gy - roi.ybegin;
-                for (int lx = 0; lx < w; ++lx) {
-                    float dxR = 0, ddxR = 0, dyR = 0, ddyR = 0;
-                    float dxT = 0, ddxT = 0, dyT = 0, ddyT = 0;
-                    for (int iy = -fr; iy <= fr; ++iy) {
-                        int yy = OIIO::clamp(ly + iy, 0, h - 1);
-                        int fi = iy + fr;
-                        int si = yy * w + lx;
-                        // (dx_x, ddx_x) filtered by Gaussian_y:
-                        dxR += fk.wG[fi] * iFeatRefDx[si];
-                        ddxR += fk.wG[fi] * iFeatRefDdx[si];
-                        dxT += fk.wG[fi] * iFeatTstDx[si];
-                        ddxT += fk.wG[fi] * iFeatTstDdx[si];
-                        // Gaussian_x filtered by (dy_y, ddy_y):
-                        dyR += fk.wDG[fi] * iFeatRefG[si];
-                        ddyR += fk.wDDG[fi] * iFeatRefG[si];
-                        dyT += fk.wDG[fi] * iFeatTstG[si];
-                        ddyT += fk.wDDG[fi] * iFeatTstG[si];
-                    }
-                    float edgeR = std::sqrt(dxR * dxR + dyR * dyR);
-                    float edgeT = std::sqrt(dxT * dxT + dyT * dyT);
-                    float ptR   = std::sqrt(ddxR * ddxR + ddyR * ddyR);
-                    float ptT   = std::sqrt(ddxT * ddxT + ddyT * ddyT);
-                    float featDiff
-                        = std::pow(normFactor
-                                       * std::max(std::abs(edgeR - edgeT),
-                                                  std::abs(ptR - ptT)),
-                                   FLIP_gqf);
-                    float flip          = std::pow(colorDiff[ly * w + lx],
-                                                   1.0f - featDiff);
-                    result[ly * w + lx] = flip;
-                }
+    b.result.resize(tw * th);
+    for (int gy = tile.ybegin; gy < tile.yend; ++gy) {
+        for (int gx = tile.xbegin; gx < tile.xend; ++gx) {
+            int lx    = gx - tile.xbegin;
+            float dxR = 0, ddxR = 0, dyR = 0, ddyR = 0;
+            float dxT = 0, ddxT = 0, dyT = 0, ddyT = 0;
+            for (int iy = -fr; iy <= fr; ++iy) {
+                int yy = OIIO::clamp(gy + iy, 0, h - 1);
+                int fi = iy + fr;
+                int si = (yy - fy0) * tw + lx;
+                // (dx_x, ddx_x) filtered by Gaussian_y:
+                dxR += fk.wG[fi] * b.iFeatRefDx[si];
+                ddxR += fk.wG[fi] * b.iFeatRefDdx[si];
+                dxT += fk.wG[fi] * b.iFeatTstDx[si];
+                ddxT += fk.wG[fi] * b.iFeatTstDdx[si];
+                // Gaussian_x filtered by (dy_y, ddy_y):
+                dyR += fk.wDG[fi] * b.iFeatRefG[si];
+                ddyR += fk.wDDG[fi] * b.iFeatRefG[si];
+                dyT += fk.wDG[fi] * b.iFeatTstG[si];
+                ddyT += fk.wDDG[fi] * b.iFeatTstG[si];
             }
-        });
+            float edgeR    = std::sqrt(dxR * dxR + dyR * dyR);
+            float edgeT    = std::sqrt(dxT * dxT + dyT * dyT);
+            float ptR      = std::sqrt(ddxR * ddxR + ddyR * ddyR);
+            float ptT      = std::sqrt(ddxT * ddxT + ddyT * ddyT);
+            float featDiff = std::pow(normFactor
+                                          * std::max(std::abs(edgeR - edgeT),
+                                                     std::abs(ptR - ptT)),
+                                      FLIP_gqf);
+            int oi         = (gy - tile.ybegin) * tw + lx;
+            b.result[oi]   = std::pow(b.colorDiff[oi], 1.0f - featDiff);
+        }
+    }
+}
+
+
+
+// Run FLIP over the whole of `roi`, one tile at a time, in parallel.
+// `exposures` lists the exposure multipliers to evaluate for HDR-FLIP; if
+// it is empty, run plain LDR-FLIP. dst (and exposuremap, if not null) are
+// set to 1-channel float images of the same spatial extent as roi, holding
+// the per-pixel maximum FLIP error over the exposures, and which exposure
+// (normalized to [0,1]) produced it.
+//
+// ref and test must be float images with 3 channels and local pixels.
+static bool
+FLIP_tiled(ImageBuf& dst, ImageBuf* exposuremap, const ImageBuf& ref,
+           const ImageBuf& test, float ppd, cspan<float> exposures,
+           FlipTonemap tonemapper, ROI roi, int nthreads)
+{
+    OIIO_ASSERT(ref.nchannels() == 3 && test.nchannels() == 3
+                && ref.spec().format == TypeFloat
+                && test.spec().format == TypeFloat && ref.localpixels()
+                && test.localpixels());
+    const int w = roi.width();
+    const int h = roi.height();
 
-    // Write result to dst (1-channel float, same spatial origin as roi)
     ImageSpec outspec(w, h, 1, TypeFloat);
     outspec.x = roi.xbegin;
     outspec.y = roi.ybegin;
     dst.reset(outspec);
-    ROI out_roi(roi.xbegin, roi.xend, roi.ybegin, roi.yend, 0, 1, 0, 1);
-    dst.set_pixels(out_roi, TypeFloat, result.data());
-
-    return !dst.has_error();
-}
-
-
+    ImageBufAlgo::zero(dst);
+    if (exposuremap) {
+        exposuremap->reset(outspec);
+        ImageBufAlgo::zero(*exposuremap);
+    }
+    if (w == 0 || h == 0)
+        return true;
 
-// ---------------------------------------------------------------------------
-// HDR-FLIP helpers
-// ---------------------------------------------------------------------------
+    FlipSetup setup(ppd);
+    FlipImages img;
+    img.ref         = (const float*)ref.pixeladdr(roi.xbegin, roi.ybegin);
+    img.test        = (const float*)test.pixeladdr(roi.xbegin, roi.ybegin);
+    img.refystride  = ref.scanline_stride() / stride_t(sizeof(float));
+    img.testystride = test.scanline_stride() / stride_t(sizeof(float));
+    img.w           = w;
+    img.h           = h;
+    float* out      = (float*)dst.localpixels();
+    float* expout   = exposuremap ? (float*)exposuremap->localpixels()
+                                  : nullptr;
+
+    // Keep the halo recomputed around each tile a modest fraction of it.
+    const int tilesize = std::max(128, 8 * setup.radius);
+    const int ntx      = (w + tilesize - 1) / tilesize;
+    const int nty      = (h + tilesize - 1) / tilesize;
+    const bool hdr     = exposures.size() > 0;
+    const int nexp     = hdr ? int(exposures.size()) : 1;
+
+    parallel_for_range(
+        int64_t(0), int64_t(ntx) * nty,
+        [&](int64_t begin, int64_t end) {
+            FlipTileBuffers b;
+            for (int64_t t = begin; t < end; ++t) {
+                int tx = int(t % ntx) * tilesize;
+                int ty = int(t / ntx) * tilesize;
+                ROI tile(tx, std::min(w, tx + tilesize), ty,
+                         std::min(h, ty + tilesize));
+                // Exposures in order, keeping the first that reaches the
+                // maximum, so the exposure map matches a serial evaluation.
+                for (int e = 0; e < nexp; ++e) {
+                    LDR_FLIP_tile(img, setup, tile, hdr,
+                                  hdr ? exposures[e] : 1.0f, tonemapper, b);
+                    float exposureNorm = nexp > 1 ? float(e) / float(nexp - 1)
+                                                  : 0.0f;
+                    const float* r     = b.result.data();
+                    for (int y = tile.ybegin; y < tile.yend; ++y) {
+                        for (int x = tile.xbegin; x < tile.xend; ++x, ++r) {
+                            size_t i = size_t(y) * w + x;
+                            if (*r > out[i]) {
+                                out[i] = *r;
+                                if (expout)
+                                    expout[i] = exposureNorm;
+                            }
+                        }
+                    }
+                }
+            }
+        },
+        paropt(nthreads));
 
-// Apply a multiplicative exposure to an image (in place on a copy).
-// Multiplies all channels by 2^level.
-static void
-apply_exposure(ImageBuf& img, float level)
-{
-    float m = std::pow(2.0f, level);
-    ImageBufAlgo::parallel_image(get_roi(img.spec()), 0, [&](ROI roi) {
-        for (ImageBuf::Iterator<float> it(img, roi); !it.done(); ++it) {
-            it[0] = it[0] * m;
-            it[1] = it[1] * m;
-            it[2] = it[2] * m;
-        }
-    });
+    return !dst.has_error();
 }
 
 
-// Tonemap a single float3 channel triple.
-// Coefficients layout: pixel = (c^2*a[0] + c*a[1] + a[2]) / (c^2*a[3] + c*a[4] + a[5])
-inline float
-tonemap_channel(float c, const float tc[6])
-{
-    float num = c * c * tc[0] + c * tc[1] + tc[2];
-    float den = c * c * tc[3] + c * tc[4] + tc[5];
-    return den > 0.0f ? num / den : 0.0f;
-}
-
 
-// Apply tone mapping to all pixels of img, in place (modifies the float copy).
-static void
-apply_tonemap(ImageBuf& img, string_view tonemapper)
+// Run the full LDR-FLIP pipeline.
+// ref and test must be float images with 3 channels.
+// Inputs are in linear Rec.709 RGB, values expected in [0,1].
+// dst is set to a 1-channel float image of the same spatial extent as roi,
+// with pixel values in [0,1].
+// Returns false and sets dst error on failure.
+static bool
+LDR_FLIP(ImageBuf& dst, const ImageBuf& ref, const ImageBuf& test, float ppd,
+         ROI roi, int nthreads)
 {
-    // Tonemapper coefficients from FLIP.h ToneMappingCoefficients
-    // Reinhard is special-cased (uses luminance-based formula).
-    static constexpr float tc_aces[6]
-        = { 0.6f * 0.6f * 2.51f, 0.6f * 0.03f, 0.0f,
-            0.6f * 0.6f * 2.43f, 0.6f * 0.59f, 0.14f };
-    static constexpr float tc_hable[6] = { 0.231683f, 0.013791f, 0.0f,
-                                           0.18f,     0.3f,      0.018f };
-
-    ImageBufAlgo::parallel_image(get_roi(img.spec()), 0, [&](ROI roi) {
-        for (ImageBuf::Iterator<float> it(img, roi); !it.done(); ++it) {
-            float r = it[0], g = it[1], b = it[2];
-            if (tonemapper == "reinhard") {
-                // Reinhard: out = c / (1 + luminance)
-                float lum = 0.2126f * r + 0.7152f * g + 0.0722f * b;
-                float d   = 1.0f + lum;
-                r /= d;
-                g /= d;
-                b /= d;
-            } else if (tonemapper == "hable") {
-                r = tonemap_channel(r, tc_hable);
-                g = tonemap_channel(g, tc_hable);
-                b = tonemap_channel(b, tc_hable);
-            } else {
-                // Default: ACES
-                r = tonemap_channel(r, tc_aces);
-                g = tonemap_channel(g, tc_aces);
-                b = tonemap_channel(b, tc_aces);
-            }
-            it[0] = r;
-            it[1] = g;
-            it[2] = b;
-        }
-    });
+    return FLIP_tiled(dst, nullptr, ref, test, ppd, {}, FlipTonemap::ACES,
+                      roi, nthreads);
 }
 
 
-// Clamp all three starting channels to [0,1].
-static void
-clamp_rgb(ImageBuf& img)
-{
-    ImageBufAlgo::parallel_image(get_roi(img.spec()), 0, [&](ROI roi) {
-        for (ImageBuf::Iterator<float> it(img, roi); !it.done(); ++it) {
-            it[0] = OIIO::clamp(float(it[0]), 0.0f, 1.0f);
-            it[1] = OIIO::clamp(float(it[1]), 0.0f, 1.0f);
-            it[2] = OIIO::clamp(float(it[2]), 0.0f, 1.0f);
-        }
-    });
-}
 
+// ---------------------------------------------------------------------------
+// HDR-FLIP helpers
+// ---------------------------------------------------------------------------
 
 // Second-degree equation solver: a*x^2 + b*x + c = 0
 static void
@@ -860,11 +965,6 @@ compute_exposures_from_max_and_median(string_view tonemapper,
 {
     // Choose the tonemapper coefficients' "peak" threshold solution.
     // For each tonemapper: find xMax where curve reaches t=0.85.
-    static constexpr float tc_aces[6]
-        = { 0.6f * 0.6f * 2.51f, 0.6f * 0.03f, 0.0f,
-            0.6f * 0.6f * 2.43f, 0.6f * 0.59f, 0.14f };
-    static constexpr float tc_hable[6] = { 0.231683f, 0.013791f, 0.0f,
-                                           0.18f,     0.3f,      0.018f };
     static constexpr float tc_reinhard[6]
         = { 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f };
 
@@ -923,9 +1023,6 @@ HDR_FLIP(ImageBuf& dst, ImageBuf* exposuremap, const ImageBuf& ref,
 {
     OIIO_ASSERT(ref.nchannels() >= 3);
 
-    const int w = roi.width();
-    const int h = roi.height();
-
     bool debug          = options.get_int("debug");
     float max_luminance = options.get_float("maxluminance", 2.0f);
 
@@ -977,70 +1074,19 @@ HDR_FLIP(ImageBuf& dst, ImageBuf* exposuremap, const ImageBuf& ref,
             print("FLIP auto numExposures {}\n", numExposures);
     }
 
-    // Initialize output images
-    ImageSpec outspec(w, h, 1, TypeFloat);
-    outspec.x = roi.xbegin;
-    outspec.y = roi.ybegin;
-    dst.reset(outspec);
-    ImageBufAlgo::zero(dst);
-
-    if (exposuremap) {
-        exposuremap->reset(outspec);
-        ImageBufAlgo::zero(*exposuremap);
-    }
-
-    // Exposure loop
+    // Exposure loop: each exposure level becomes a multiplier of 2^level.
+    // Exposure, tone mapping, and clamping are fused into the first step of
+    // the tiled LDR-FLIP evaluation rather than done to copies of the
+    // images.
     float step = (numExposures > 1)
                      ? (stopExposure - startExposure) / float(numExposures - 1)
                      : 0.0f;
+    std::vector<float> exposures(numExposures);
+    for (int i = 0; i < numExposures; ++i)
+        exposures[i] = std::pow(2.0f, startExposure + i * step);
 
-    for (int i = 0; i < numExposures; ++i) {
-        float exposure = startExposure + i * step;
-
-        // Make float copies of ref and test, apply exposure + tonemap + clamp
-        ImageBuf rCopy, tCopy;
-        ImageBufAlgo::copy(rCopy, ref, TypeFloat);
-        ImageBufAlgo::copy(tCopy, test, TypeFloat);
-        apply_exposure(rCopy, exposure);
-        apply_exposure(tCopy, exposure);
-        apply_tonemap(rCopy, tonemapper);
-        apply_tonemap(tCopy, tonemapper);
-        clamp_rgb(rCopy);
-        clamp_rgb(tCopy);
-
-        // Run LDR-FLIP for this exposure
-        ImageBuf tmp;
-        if (!LDR_FLIP(tmp, rCopy, tCopy, ppd, roi, nthreads))
-            return false;
-
-        // Per-pixel max: if tmp > dst, update dst (and exposuremap)
-        float exposureNorm = (numExposures > 1)
-                                 ? float(i) / float(numExposures - 1)
-                                 : 0.0f;
-        ROI out_roi(roi.xbegin, roi.xend, roi.ybegin, roi.yend, 0, 1, 0, 1);
-        ImageBufAlgo::parallel_image(out_roi, nthreads, [&](ROI r) {
-            ImageBuf::ConstIterator<float> tit(tmp, r);
-            ImageBuf::Iterator<float> dit(dst, r);
-            if (exposuremap) {
-                ImageBuf::Iterator<float> eit(*exposuremap, r);
-                for (; !tit.done(); ++tit, ++dit, ++eit) {
-                    float tv = tit[0];
-                    if (tv > dit[0]) {
-                        dit[0] = tv;
-                        eit[0] = exposureNorm;
-                    }
-                }
-            } else {
-                for (; !tit.done(); ++tit, ++dit) {
-                    float tv = tit[0];
-                    if (tv > dit[0])
-                        dit[0] = tv;
-                }
-            }
-        });
-    }
-
-    return !dst.has_error();
+    return FLIP_tiled(dst, exposuremap, ref, test, ppd, exposures,
+                      flip_tonemap(tonemapper), roi, nthreads);
 }
 
 
@@ -14,6 +14,7 @@
 #include <hwy/highway.h>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 OIIO_NAMESPACE_BEGIN
 
@@ -1526,4 +1527,186 @@ rangeexpand_simd(D d, VecT y)
     return hn::IfThenElse(mask_passthrough, y, result);
 }
 
+// -----------------------------------------------------------------------
+// Per-pixel Ops with per-channel constants
+// -----------------------------------------------------------------------
+
+/// Build a table of the per-channel constants `vals[0..nchannels-1]`, laid
+/// out so that `hn::LoadU(d, table.data() + i % nchannels)` yields the
+/// constants for values i, i+1, ... of a row of interleaved channels whose
+/// first value is channel 0.
+template<class D>
+inline std::vector<hn::TFromD<D>>
+ChannelPatternTable(D d, cspan<float> vals, int nchannels)
+{
+    using MathT = hn::TFromD<D>;
+    std::vector<MathT> table(hn::Lanes(d) + size_t(nchannels));
+    for (size_t i = 0; i < table.size(); ++i)
+        table[i] = static_cast<MathT>(vals[i % size_t(nchannels)]);
+    return table;
+}
+
+/// Execute a unary SIMD operation on an array, like RunHwyUnaryCmd, but
+/// also passing the index of the first value of each vector, so that
+/// `op(d, va, i)` can look up per-channel constants from a
+/// ChannelPatternTable.
+template<typename Rtype, typename Atype, typename OpFunc>
+inline void
+RunHwyUnaryIndexedCmd(Rtype* r, const Atype* a, size_t n, OpFunc op)
+{
+    using MathT = typename SimdMathType<Rtype>::type;
+    const hn::ScalableTag<MathT> d;
+    size_t x     = 0;
+    size_t lanes = hn::Lanes(d);
+    for (; x + lanes <= n; x += lanes) {
+        auto va  = LoadPromote(d, a + x);
+        auto res = op(d, va, x);
+        DemoteStore(d, r + x, res);
+    }
+    size_t remaining = n - x;
+    if (remaining > 0) {
+        auto va  = LoadPromoteN(d, a + x, remaining);
+        auto res = op(d, va, x);
+        DemoteStoreN(d, r + x, res, remaining);
+    }
+}
+
+/// Execute a unary per-pixel HWY operation for interleaved, contiguous
+/// channels, with `op(d, va, i)` as for RunHwyUnaryIndexedCmd. The caller is
+/// responsible for ensuring that the channel range is contiguous for R/A
+/// (i.e. no per-pixel padding, and the ROI channel range covers the full
+/// pixel).
+template<typename Rtype, typename Atype, typename OpFunc>
+inline bool
+hwy_unary_perpixel_op(ImageBuf& R, const ImageBuf& A, ROI roi, int nthreads,
+                      OpFunc op)
+{
+    auto Rv = HwyPixels(R);
+    auto Av = HwyPixels(A);
+    ImageBufAlgo::parallel_image(roi, nthreads, [&, op](ROI roi) {
+        const int nchannels = roi.nchannels();
+        const size_t n      = static_cast<size_t>(roi.width())
+                         * static_cast<size_t>(nchannels);
+        for (int y = roi.ybegin; y < roi.yend; ++y) {
+            Rtype* r_row       = RoiRowPtr<Rtype>(Rv, y, roi);
+            const Atype* a_row = RoiRowPtr<Atype>(Av, y, roi);
+            RunHwyUnaryIndexedCmd<Rtype, Atype>(r_row, a_row, n, op);
+        }
+    });
+    return true;
+}
+
+// -----------------------------------------------------------------------
+// Whole-pixel Ops (ImageBufAlgo, packed RGBA)
+// -----------------------------------------------------------------------
+
+/// Store 4 interleaved channels (RGBA) with type demotion for a partial
+/// vector (count pixels, count <= lanes).
+template<class D, typename DstT, typename VecT>
+inline void
+StoreInterleaved4DemoteN(D d, DstT* ptr, VecT r, VecT g, VecT b, VecT a,
+                         size_t count)
+{
+    DstT r_demoted[hn::MaxLanes(d)];
+    DstT g_demoted[hn::MaxLanes(d)];
+    DstT b_demoted[hn::MaxLanes(d)];
+    DstT a_demoted[hn::MaxLanes(d)];
+    DemoteStoreN(d, r_demoted, r, count);
+    DemoteStoreN(d, g_demoted, g, count);
+    DemoteStoreN(d, b_demoted, b, count);
+    DemoteStoreN(d, a_demoted, a, count);
+    for (size_t i = 0; i < count; ++i) {
+        ptr[i * 4 + 0] = r_demoted[i];
+        ptr[i * 4 + 1] = g_demoted[i];
+        ptr[i * 4 + 2] = b_demoted[i];
+        ptr[i * 4 + 3] = a_demoted[i];
+    }
+}
+
+/// Execute an operation on whole pixels of packed 4-channel images,
+/// computing R from A. `op(d, r, g, b, a)` receives the promoted channel
+/// vectors of A by reference and replaces them with the result. The caller
+/// is responsible for ensuring that R and A are packed RGBA and that the
+/// ROI covers all four channels. R may be the same image as A.
+template<typename Rtype, typename Atype, typename OpFunc>
+inline bool
+hwy_rgba_unary_pixel_op(ImageBuf& R, const ImageBuf& A, ROI roi, int nthreads,
+                        OpFunc op)
+{
+    auto Rv = HwyPixels(R);
+    auto Av = HwyPixels(A);
+    using MathT = typename SimdMathType<Rtype>::type;
+    const hn::ScalableTag<MathT> d;
+    const size_t lanes = hn::Lanes(d);
+    ImageBufAlgo::parallel_image(roi, nthreads, [&, op](ROI roi) {
+        const size_t npixels = static_cast<size_t>(roi.width());
+        for (int y = roi.ybegin; y < roi.yend; ++y) {
+            Rtype* r_row       = RoiRowPtr<Rtype>(Rv, y, roi);
+            const Atype* a_row = RoiRowPtr<Atype>(Av, y, roi);
+            size_t x           = 0;
+            for (; x + lanes <= npixels; x += lanes) {
+                auto [r, g, b, a] = LoadInterleaved4Promote(d, a_row + x * 4);
+                op(d, r, g, b, a);
+                StoreInterleaved4Demote(d, r_row + x * 4, r, g, b, a);
+            }
+            const size_t remaining = npixels - x;
+            if (remaining > 0) {
+                auto [r, g, b, a] = LoadInterleaved4PromoteN(d, a_row + x * 4,
+                                                             remaining);
+                op(d, r, g, b, a);
+                StoreInterleaved4DemoteN(d, r_row + x * 4, r, g, b, a,
+                                         remaining);
+            }
+        }
+    });
+    return true;
+}
+
+/// Execute an operation on whole pixels of packed 4-channel images,
+/// computing R from A and B. `op(d, ar, ag, ab, aa, br, bg, bb, ba)`
+/// receives the promoted channel vectors of A (by reference) and B, and
+/// replaces the A vectors with the result. The caller is responsible for
+/// ensuring that R, A, and B are packed RGBA and that the ROI covers all
+/// four channels.
+template<typename Rtype, typename Atype, typename Btype, typename OpFunc>
+inline bool
+hwy_rgba_binary_pixel_op(ImageBuf& R, const ImageBuf& A, const ImageBuf& B,
+                         ROI roi, int nthreads, OpFunc op)
+{
+    auto Rv = HwyPixels(R);
+    auto Av = HwyPixels(A);
+    auto Bv = HwyPixels(B);
+    using MathT = typename SimdMathType<Rtype>::type;
+    const hn::ScalableTag<MathT> d;
+    const size_t lanes = hn::Lanes(d);
+    ImageBufAlgo::parallel_image(roi, nthreads, [&, op](ROI roi) {
+        const size_t npixels = static_cast<size_t>(roi.width());
+        for (int y = roi.ybegin; y < roi.yend; ++y) {
+            Rtype* r_row       = RoiRowPtr<Rtype>(Rv, y, roi);
+            const Atype* a_row = RoiRowPtr<Atype>(Av, y, roi);
+            const Btype* b_row = RoiRowPtr<Btype>(Bv, y, roi);
+            size_t x           = 0;
+            for (; x + lanes <= npixels; x += lanes) {
+                const size_t off      = x * 4;
+                auto [ar, ag, ab, aa] = LoadInterleaved4Promote(d, a_row + off);
+                auto [br, bg, bb, ba] = LoadInterleaved4Promote(d, b_row + off);
+                op(d, ar, ag, ab, aa, br, bg, bb, ba);
+                StoreInterleaved4Demote(d, r_row + off, ar, ag, ab, aa);
+            }
+            const size_t remaining = npixels - x;
+            if (remaining > 0) {
+                const size_t off      = x * 4;
+                auto [ar, ag, ab, aa] = LoadInterleaved4PromoteN(d, a_row + off,
+                                                                 remaining);
+                auto [br, bg, bb, ba] = LoadInterleaved4PromoteN(d, b_row + off,
+                                                                 remaining);
+                op(d, ar, ag, ab, aa, br, bg, bb, ba);
+                StoreInterleaved4DemoteN(d, r_row + off, ar, ag, ab, aa,
+                                         remaining);
+            }
+        }
+    });
+    return true;
+}
+
 OIIO_NAMESPACE_END
@@ -3,6 +3,7 @@
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
 
 #include <OpenImageIO/half.h>
@@ -11,6 +12,7 @@
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagebufalgo_util.h>
+#include <OpenImageIO/simd.h>
 #include <OpenImageIO/thread.h>
 
 #include "imageio_pvt.h"
@@ -19,6 +21,183 @@
 OIIO_NAMESPACE_3_1_BEGIN
 
 
+// Transpose, in registers, a square block of N = 16/E elements of E bytes
+// each, held as N vint4's with v[i] being column i. On return, v[j] is row
+// j of the block.
+template<int E>
+static OIIO_FORCEINLINE void
+transpose_elements(simd::vint4* v)
+{
+    using simd::vint4;
+    if constexpr (E == 4) {
+        simd::transpose(v[0], v[1], v[2], v[3]);
+    } else if constexpr (E == 2) {
+        // Lane k of t[q][p] gets columns 2p and 2p+1 of row 2k+q, and then
+        // transposing the lanes of each t[q] assembles whole rows.
+        const vint4 lo16(0xffff);
+        vint4 t[2][4];
+        for (int p = 0; p < 4; ++p) {
+            t[0][p] = (v[2 * p] & lo16) | (v[2 * p + 1] << 16);
+            t[1][p] = srl(v[2 * p], 16) | andnot(lo16, v[2 * p + 1]);
+        }
+        for (int q = 0; q < 2; ++q) {
+            simd::transpose(t[q][0], t[q][1], t[q][2], t[q][3]);
+            for (int k = 0; k < 4; ++k)
+                v[2 * k + q] = t[q][k];
+        }
+    } else {
+        // Transpose the 4x4 bytes in each lane of each group of four
+        // columns, so that lane k of t[j][g] gets columns 4g..4g+3 of row
+        // 4k+j, and then transposing the lanes of each t[j] assembles whole
+        // rows.
+        static_assert(E == 1, "unsupported element size");
+        const vint4 lo8(0x00ff00ff), lo16(0xffff);
+        vint4 t[4][4];
+        for (int g = 0; g < 4; ++g) {
+            const vint4* c = v + 4 * g;
+            vint4 a0       = (c[0] & lo8) | andnot(lo8, c[1] << 8);
+            vint4 a1       = (srl(c[0], 8) & lo8) | andnot(lo8, c[1]);
+            vint4 a2       = (c[2] & lo8) | andnot(lo8, c[3] << 8);
+            vint4 a3       = (srl(c[2], 8) & lo8) | andnot(lo8, c[3]);
+            t[0][g]        = (a0 & lo16) | (a2 << 16);
+            t[1][g]        = (a1 & lo16) | (a3 << 16);
+            t[2][g]        = srl(a0, 16) | andnot(lo16, a2);
+            t[3][g]        = srl(a1, 16) | andnot(lo16, a3);
+        }
+        for (int j = 0; j < 4; ++j) {
+            simd::transpose(t[j][0], t[j][1], t[j][2], t[j][3]);
+            for (int k = 0; k < 4; ++k)
+                v[4 * k + j] = t[j][k];
+        }
+    }
+}
+
+
+
+// Copy a w x h block of `PB`-byte pixels for orient_local(). Pixel (x,y)
+// of the block comes from s + x*xstep + y*ystep, and goes to
+// d + x*pb + y*dystride. The PB template parameter is the pixel size if
+// it's one we specialize for, or 0 to use pb.
+template<int PB>
+static void
+orient_block(char* d, stride_t dystride, const char* s, stride_t xstep,
+             stride_t ystep, int w, int h, size_t pb)
+{
+    const size_t n = PB ? PB : pb;
+    int y          = 0;
+    // Pixels of 1, 2, or 4 bytes are transposed in registers when the
+    // pixels of a dst column are adjacent in a src row (as for the
+    // rotations and transpose): N columns of N pixels are loaded, and
+    // stored as N rows. Pixels of 3 channels would first have to be split
+    // into channels and merged again, which with 32-bit lanes costs more
+    // than it saves, so like the bigger pixels they use the copy loop.
+    if constexpr (PB == 1 || PB == 2 || PB == 4) {
+        using simd::vint4;
+        constexpr int N = 16 / PB;
+        if (ystep == PB || ystep == -PB) {
+            // Going up the src row, the loads hold the column backwards,
+            // so the rows come out of the transpose in reverse order.
+            const stride_t back = ystep < 0 ? (N - 1) * PB : 0;
+            for (; y + N <= h; y += N) {
+                int x = 0;
+                for (; x + N <= w; x += N) {
+                    vint4 v[N];
+                    for (int i = 0; i < N; ++i)
+                        v[i].load((const int*)(s + (x + i) * xstep
+                                               + y * ystep - back));
+                    transpose_elements<PB>(v);
+                    for (int j = 0; j < N; ++j) {
+                        int r = ystep < 0 ? N - 1 - j : j;
+                        v[j].store((int*)(d + (y + r) * dystride + x * PB));
+                    }
+                }
+                for (; x < w; ++x)
+                    for (int j = 0; j < N; ++j)
+                        memcpy(d + (y + j) * dystride + x * PB,
+                               s + x * xstep + (y + j) * ystep, PB);
+            }
+        }
+    }
+    for (; y < h; ++y) {
+        char* dp       = d + y * dystride;
+        const char* sp = s + y * ystep;
+        for (int x = 0; x < w; ++x, dp += n, sp += xstep)
+            memcpy(dp, sp, n);
+    }
+}
+
+
+
+// Fast path shared by the orientation operations, for when src and dst
+// hold local pixels of the same type and channels, and every pixel
+// involved exists. Pixel (xbegin,ybegin) of dst_roi is copied from pixel
+// (sx,sy) of src, and moving by one pixel in x (or y) in dst moves by
+// (xdx,xdy) (or (ydx,ydy)) in src. The copy walks dst in cache-sized
+// blocks, so that the src rows it reads from stay in cache even when they
+// are traversed across (as for the rotations and transpose).
+//
+// Return false, having done nothing, if the fast path doesn't apply.
+static bool
+orient_local(ImageBuf& dst, const ImageBuf& src, ROI dst_roi, int sx, int sy,
+             int xdx, int xdy, int ydx, int ydy, int nthreads)
+{
+    const ImageSpec& spec(src.spec());
+    if (!src.localpixels() || !dst.localpixels() || src.deep() || dst.deep()
+        || spec.format != dst.spec().format
+        || spec.nchannels != dst.nchannels() || dst_roi.chbegin != 0
+        || dst_roi.chend < spec.nchannels || !dst.roi().contains(dst_roi))
+        return false;
+    // All four corners of the source region must exist
+    ROI sroi  = src.roi();
+    int xlast = dst_roi.width() - 1, ylast = dst_roi.height() - 1;
+    if (dst_roi.zbegin < sroi.zbegin || dst_roi.zend > sroi.zend)
+        return false;
+    for (int j = 0; j <= 1; ++j)
+        for (int i = 0; i <= 1; ++i)
+            if (!sroi.contains(sx + i * xlast * xdx + j * ylast * ydx,
+                               sy + i * xlast * xdy + j * ylast * ydy,
+                               dst_roi.zbegin))
+                return false;
+
+    size_t pb         = spec.pixel_bytes();
+    stride_t xstep    = xdx * src.pixel_stride() + xdy * src.scanline_stride();
+    stride_t ystep    = ydx * src.pixel_stride() + ydy * src.scanline_stride();
+    stride_t dystride = dst.scanline_stride();
+    auto block        = orient_block<0>;
+    switch (pb) {
+    case 1: block = orient_block<1>; break;
+    case 2: block = orient_block<2>; break;
+    case 3: block = orient_block<3>; break;
+    case 4: block = orient_block<4>; break;
+    case 6: block = orient_block<6>; break;
+    case 8: block = orient_block<8>; break;
+    case 12: block = orient_block<12>; break;
+    case 16: block = orient_block<16>; break;
+    }
+    constexpr int blocksize = 32;
+    ImageBufAlgo::parallel_image(dst_roi, nthreads, [&](ROI roi) {
+        for (int z = roi.zbegin; z < roi.zend; ++z) {
+            for (int by = roi.ybegin; by < roi.yend; by += blocksize) {
+                int bh = std::min(blocksize, roi.yend - by);
+                for (int bx = roi.xbegin; bx < roi.xend; bx += blocksize) {
+                    int bw  = std::min(blocksize, roi.xend - bx);
+                    int dx  = bx - dst_roi.xbegin;
+                    int dy  = by - dst_roi.ybegin;
+                    char* d = (char*)dst.pixeladdr(bx, by, z);
+                    const char* s
+                        = (const char*)src.pixeladdr(sx + dx * xdx + dy * ydx,
+                                                     sy + dx * xdy + dy * ydy,
+                                                     z);
+                    block(d, dystride, s, xstep, ystep, bw, bh, pb);
+                }
+            }
+        }
+    });
+    return true;
+}
+
+
+
 template<class D, class S = D>
 static bool
 flip_(ImageBuf& dst, const ImageBuf& src, ROI dst_roi, int /*nthreads*/)
@@ -60,6 +239,11 @@ ImageBufAlgo::flip(ImageBuf& dst, const ImageBuf& src, ROI roi, int nthreads)
     // the midline of the display window.
     if (!IBAprep(dst_roi, &dst, &src))
         return false;
+    if (orient_local(dst, src, dst_roi, dst_roi.xbegin,
+                     src_roi_full.yend - 1
+                         - (dst_roi.ybegin - dst.roi_full().ybegin),
+                     1, 0, 0, -1, nthreads))
+        return true;
     bool ok;
     OIIO_DISPATCH_COMMON_TYPES2(ok, "flip", flip_, dst.spec().format,
                                 src.spec().format, dst, src, dst_roi, nthreads);
@@ -109,6 +293,11 @@ ImageBufAlgo::flop(ImageBuf& dst, const ImageBuf& src, ROI roi, int nthreads)
     // the midline of the display window.
     if (!IBAprep(dst_roi, &dst, &src))
         return false;
+    if (orient_local(dst, src, dst_roi,
+                     src_roi_full.xend - 1
+                         - (dst_roi.xbegin - dst.roi_full().xbegin),
+                     dst_roi.ybegin, -1, 0, 0, 1, nthreads))
+        return true;
     bool ok;
     OIIO_DISPATCH_COMMON_TYPES2(ok, "flop", flop_, dst.spec().format,
                                 src.spec().format, dst, src, dst_roi, nthreads);
@@ -192,6 +381,10 @@ ImageBufAlgo::rotate90(ImageBuf& dst, const ImageBuf& src, ROI roi,
         return false;
     if (!dst_initialized)
         dst.set_roi_full(dst_roi_full);
+    if (orient_local(dst, src, dst_roi, dst_roi.ybegin,
+                     dst.roi_full().xend - dst_roi.xbegin - 1, 0, -1, 1, 0,
+                     nthreads))
+        return true;
 
     bool ok;
     OIIO_DISPATCH_COMMON_TYPES2(ok, "rotate90", rotate90_, dst.spec().format,
@@ -247,6 +440,14 @@ ImageBufAlgo::rotate180(ImageBuf& dst, const ImageBuf& src, ROI roi,
     // the midline of the display window.
     if (!IBAprep(dst_roi, &dst, &src))
         return false;
+    ROI dst_roi_full = dst.roi_full();
+    if (orient_local(dst, src, dst_roi,
+                     src_roi_full.xend - 1
+                         - (dst_roi.xbegin - dst_roi_full.xbegin),
+                     src_roi_full.yend - 1
+                         - (dst_roi.ybegin - dst_roi_full.ybegin),
+                     -1, 0, 0, -1, nthreads))
+        return true;
     bool ok;
     OIIO_DISPATCH_COMMON_TYPES2(ok, "rotate180", rotate180_, dst.spec().format,
                                 src.spec().format, dst, src, dst_roi, nthreads);
@@ -306,6 +507,10 @@ ImageBufAlgo::rotate270(ImageBuf& dst, const ImageBuf& src, ROI roi,
         return false;
     if (!dst_initialized)
         dst.set_roi_full(dst_roi_full);
+    if (orient_local(dst, src, dst_roi,
+                     dst.roi_full().yend - dst_roi.ybegin - 1, dst_roi.xbegin,
+                     0, 1, -1, 0, nthreads))
+        return true;
 
     bool ok;
     OIIO_DISPATCH_COMMON_TYPES2(ok, "rotate270", rotate270_, dst.spec().format,
@@ -436,6 +641,9 @@ ImageBufAlgo::transpose(ImageBuf& dst, const ImageBuf& src, ROI roi,
                          r.chbegin, r.chend);
         dst.set_roi_full(dst_roi_full);
     }
+    if (orient_local(dst, src, dst_roi, roi.xbegin, roi.ybegin, 0, 1, 1, 0,
+                     nthreads))
+        return true;
     bool ok;
     if (dst.spec().format == src.spec().format) {
         OIIO_DISPATCH_TYPES(ok, "transpose", transpose_, dst.spec().format, dst,
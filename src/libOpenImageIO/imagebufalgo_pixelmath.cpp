@@ -19,6 +19,10 @@
 #include <OpenImageIO/imagebufalgo_util.h>
 #include <OpenImageIO/simd.h>
 
+#if OIIO_USE_HWY
+#    include "imagebufalgo_hwy_pvt.h"
+#endif
+
 #include "imageio_pvt.h"
 
 
@@ -219,11 +223,55 @@ ImageBufAlgo::max(Image_or_Const A, Image_or_Const B, ROI roi, int nthreads)
 
 
 
+#if OIIO_USE_HWY
+template<class D, class S>
+static bool
+clamp_hwy(ImageBuf& dst, const ImageBuf& src, const float* min,
+          const float* max, bool clampalpha01, ROI roi, int nthreads)
+{
+    using MathT = typename SimdMathType<D>::type;
+    const int n = roi.nchannels();
+    // Clamping to [min,max] and then to [0,1] is the same as clamping once
+    // to [clamp(min,0,1), clamp(max,0,1)], so fold the alpha clamp into the
+    // per-channel bounds.
+    float* lo = OIIO_ALLOCA(float, n);
+    float* hi = OIIO_ALLOCA(float, n);
+    for (int c = 0; c < n; ++c) {
+        lo[c] = min[c];
+        hi[c] = max[c];
+    }
+    int a = src.spec().alpha_channel;
+    if (clampalpha01 && a >= 0 && a < n) {
+        lo[a] = OIIO::clamp(lo[a], 0.0f, 1.0f);
+        hi[a] = OIIO::clamp(hi[a], 0.0f, 1.0f);
+    }
+    const hn::ScalableTag<MathT> dm;
+    auto lotable     = ChannelPatternTable(dm, cspan<float>(lo, n), n);
+    auto hitable     = ChannelPatternTable(dm, cspan<float>(hi, n), n);
+    const MathT* lop = lotable.data();
+    const MathT* hip = hitable.data();
+    return hwy_unary_perpixel_op<D, S>(
+        dst, src, roi, nthreads, [=](auto d, auto va, size_t i) {
+            size_t p = i % size_t(n);
+            return hn::Min(hn::Max(va, hn::LoadU(d, lop + p)),
+                           hn::LoadU(d, hip + p));
+        });
+}
+#endif  // OIIO_USE_HWY
+
+
+
 template<class D, class S>
 static bool
 clamp_(ImageBuf& dst, const ImageBuf& src, const float* min, const float* max,
        bool clampalpha01, ROI roi, int nthreads)
 {
+#if OIIO_USE_HWY
+    if (OIIO::pvt::enable_hwy && HwySupports<D>(dst, roi)
+        && HwySupports<S>(src, roi))
+        return clamp_hwy<D, S>(dst, src, min, max, clampalpha01, roi,
+                               nthreads);
+#endif
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
         ImageBuf::ConstIterator<S> s(src, roi);
         for (ImageBuf::Iterator<D> d(dst, roi); !d.done(); ++d, ++s) {
@@ -275,11 +323,46 @@ ImageBufAlgo::clamp(const ImageBuf& src, cspan<float> min, cspan<float> max,
 
 
 
+#if OIIO_USE_HWY
+template<class Rtype, class Atype, class Btype>
+static bool
+absdiff_impl_hwy(ImageBuf& R, const ImageBuf& A, const ImageBuf& B, ROI roi,
+                 int nthreads)
+{
+    auto op = [](auto /*d*/, auto a, auto b) { return hn::Abs(hn::Sub(a, b)); };
+    return hwy_binary_perpixel_op<Rtype, Atype, Btype>(R, A, B, roi, nthreads,
+                                                       op);
+}
+
+template<class Rtype, class Atype>
+static bool
+absdiff_impl_hwy(ImageBuf& R, const ImageBuf& A, cspan<float> b, ROI roi,
+                 int nthreads)
+{
+    using MathT = typename SimdMathType<Rtype>::type;
+    const int n = roi.nchannels();
+    auto btable = ChannelPatternTable(hn::ScalableTag<MathT>(), b, n);
+    const MathT* bp = btable.data();
+    return hwy_unary_perpixel_op<Rtype, Atype>(
+        R, A, roi, nthreads, [=](auto d, auto va, size_t i) {
+            auto vb = hn::LoadU(d, bp + i % size_t(n));
+            return hn::Abs(hn::Sub(va, vb));
+        });
+}
+#endif  // OIIO_USE_HWY
+
+
+
 template<class Rtype, class Atype, class Btype>
 static bool
 absdiff_impl(ImageBuf& R, const ImageBuf& A, const ImageBuf& B, ROI roi,
              int nthreads)
 {
+#if OIIO_USE_HWY
+    if (OIIO::pvt::enable_hwy && HwySupports<Rtype>(R, roi)
+        && HwySupports<Atype>(A, roi) && HwySupports<Btype>(B, roi))
+        return absdiff_impl_hwy<Rtype, Atype, Btype>(R, A, B, roi, nthreads);
+#endif
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
         ImageBuf::Iterator<Rtype> r(R, roi);
         ImageBuf::ConstIterator<Atype> a(A, roi);
@@ -297,6 +380,11 @@ static bool
 absdiff_impl(ImageBuf& R, const ImageBuf& A, cspan<float> b, ROI roi,
              int nthreads)
 {
+#if OIIO_USE_HWY
+    if (OIIO::pvt::enable_hwy && HwySupports<Rtype>(R, roi)
+        && HwySupports<Atype>(A, roi))
+        return absdiff_impl_hwy<Rtype, Atype>(R, A, b, roi, nthreads);
+#endif
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
         ImageBuf::Iterator<Rtype> r(R, roi);
         ImageBuf::ConstIterator<Atype> a(A, roi);
@@ -394,10 +482,45 @@ ImageBufAlgo::abs(const ImageBuf& A, ROI roi, int nthreads)
 
 
 
+#if OIIO_USE_HWY
+template<class Rtype, class Atype>
+static bool
+pow_impl_hwy(ImageBuf& R, const ImageBuf& A, cspan<float> b, ROI roi,
+             int nthreads)
+{
+    using MathT = typename SimdMathType<Rtype>::type;
+    const int n = roi.nchannels();
+    auto btable = ChannelPatternTable(hn::ScalableTag<MathT>(), b, n);
+    const MathT* bp = btable.data();
+    return hwy_unary_perpixel_op<Rtype, Atype>(
+        R, A, roi, nthreads, [=](auto d, auto va, size_t i) {
+            auto vb = hn::LoadU(d, bp + i % size_t(n));
+            // pow(a,b) = exp(b*log(a)) for positive a. Zero and negative
+            // bases have special cases (and partial vectors at the ends of
+            // rows are zero-padded), so punt those vectors to std::pow.
+            if (hn::AllTrue(d, hn::Gt(va, hn::Zero(d))))
+                return hn::Exp(d, hn::Mul(vb, hn::Log(d, va)));
+            MathT av[hn::MaxLanes(d)], bv[hn::MaxLanes(d)];
+            hn::StoreU(va, d, av);
+            hn::StoreU(vb, d, bv);
+            for (size_t j = 0, e = hn::Lanes(d); j < e; ++j)
+                av[j] = std::pow(av[j], bv[j]);
+            return hn::LoadU(d, av);
+        });
+}
+#endif  // OIIO_USE_HWY
+
+
+
 template<class Rtype, class Atype>
 static bool
 pow_impl(ImageBuf& R, const ImageBuf& A, cspan<float> b, ROI roi, int nthreads)
 {
+#if OIIO_USE_HWY
+    if (OIIO::pvt::enable_hwy && HwySupports<Rtype>(R, roi)
+        && HwySupports<Atype>(A, roi))
+        return pow_impl_hwy<Rtype, Atype>(R, A, b, roi, nthreads);
+#endif
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
         ImageBuf::ConstIterator<Atype> a(A, roi);
         for (ImageBuf::Iterator<Rtype> r(R, roi); !r.done(); ++r, ++a)
@@ -500,11 +623,67 @@ ImageBufAlgo::normalize(const ImageBuf& A, float inCenter, float outCenter,
 
 
 
+#if OIIO_USE_HWY
+// Weighted sum of the 4 channels of a packed RGBA image into a
+// 1-channel image.
+template<class D, class S>
+static bool
+channel_sum_hwy(ImageBuf& dst, const ImageBuf& src, cspan<float> weights,
+                ROI roi, int nthreads)
+{
+    using MathT = typename SimdMathType<D>::type;
+    auto Dv     = HwyPixels(dst);
+    auto Sv     = HwyPixels(src);
+    const MathT w0 = weights[0], w1 = weights[1], w2 = weights[2],
+                w3 = weights[3];
+    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
+        const hn::ScalableTag<MathT> d;
+        const size_t lanes   = hn::Lanes(d);
+        const size_t npixels = static_cast<size_t>(roi.width());
+        auto sum             = [&](auto r, auto g, auto b, auto a) {
+            auto v = hn::Mul(r, hn::Set(d, w0));
+            v      = hn::MulAdd(g, hn::Set(d, w1), v);
+            v      = hn::MulAdd(b, hn::Set(d, w2), v);
+            return hn::MulAdd(a, hn::Set(d, w3), v);
+        };
+        ROI droi     = roi;
+        droi.chbegin = 0;
+        droi.chend   = 1;
+        for (int y = roi.ybegin; y < roi.yend; ++y) {
+            D* d_row       = RoiRowPtr<D>(Dv, y, droi);
+            const S* s_row = RoiRowPtr<S>(Sv, y, roi);
+            size_t x       = 0;
+            for (; x + lanes <= npixels; x += lanes) {
+                auto [r, g, b, a] = LoadInterleaved4Promote(d, s_row + x * 4);
+                DemoteStore(d, d_row + x, sum(r, g, b, a));
+            }
+            if (x < npixels) {
+                auto [r, g, b, a] = LoadInterleaved4PromoteN(d, s_row + x * 4,
+                                                             npixels - x);
+                DemoteStoreN(d, d_row + x, sum(r, g, b, a), npixels - x);
+            }
+        }
+    });
+    return true;
+}
+#endif  // OIIO_USE_HWY
+
+
+
 template<class D, class S>
 static bool
 channel_sum_(ImageBuf& dst, const ImageBuf& src, cspan<float> weights, ROI roi,
              int nthreads)
 {
+#if OIIO_USE_HWY
+    ROI dstroi     = roi;
+    dstroi.chbegin = 0;
+    dstroi.chend   = 1;
+    if (OIIO::pvt::enable_hwy && roi.chbegin == 0 && roi.chend == 4
+        && weights.size() >= 4 && HwySupports<D>(dst, dstroi)
+        && HwySupports<S>(src, roi))
+        return channel_sum_hwy<D, S>(dst, src, weights, roi, nthreads);
+#endif
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
         ImageBuf::Iterator<D> d(dst, roi);
         ImageBuf::ConstIterator<S> s(src, roi);
@@ -796,10 +975,51 @@ ImageBufAlgo::rangeexpand(const ImageBuf& src, bool useluma, ROI roi,
 
 
 
+#if OIIO_USE_HWY
+// Can the packed RGBA kernels handle images R and A (and B, if supplied)
+// over the roi: alpha in channel 3, no z, all four channels in the roi?
+template<class Rtype, class Atype, class Btype = Atype>
+static bool
+hwy_rgba_ok(const ImageBuf& R, const ImageBuf& A, ROI roi,
+            const ImageBuf* B = nullptr)
+{
+    auto rgba = [](const ImageBuf& img) {
+        return img.spec().alpha_channel == 3 && img.spec().z_channel < 0;
+    };
+    return OIIO::pvt::enable_hwy && roi.chbegin == 0 && roi.chend == 4
+           && HwySupports<Rtype>(R, roi) && HwySupports<Atype>(A, roi)
+           && rgba(A) && (!B || (HwySupports<Btype>(*B, roi) && rgba(*B)));
+}
+
+
+
+template<class Rtype, class Atype>
+static bool
+unpremult_hwy(ImageBuf& R, const ImageBuf& A, ROI roi, int nthreads)
+{
+    return hwy_rgba_unary_pixel_op<Rtype, Atype>(
+        R, A, roi, nthreads, [](auto d, auto& r, auto& g, auto& b, auto& a) {
+            // Pixels with alpha 0 or 1 pass through unchanged.
+            auto one  = hn::Set(d, 1.0f);
+            auto keep = hn::Or(hn::Eq(a, hn::Zero(d)), hn::Eq(a, one));
+            auto div  = hn::IfThenElse(keep, one, a);
+            r         = hn::Div(r, div);
+            g         = hn::Div(g, div);
+            b         = hn::Div(b, div);
+        });
+}
+#endif  // OIIO_USE_HWY
+
+
+
 template<class Rtype, class Atype>
 static bool
 unpremult_(ImageBuf& R, const ImageBuf& A, ROI roi, int nthreads)
 {
+#if OIIO_USE_HWY
+    if (hwy_rgba_ok<Rtype, Atype>(R, A, roi))
+        return unpremult_hwy<Rtype, Atype>(R, A, roi, nthreads);
+#endif
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
         int alpha_channel = A.spec().alpha_channel;
         int z_channel     = A.spec().z_channel;
@@ -873,11 +1093,39 @@ ImageBufAlgo::unpremult(const ImageBuf& src, ROI roi, int nthreads)
 
 
 
+#if OIIO_USE_HWY
+template<class Rtype, class Atype>
+static bool
+premult_hwy(ImageBuf& R, const ImageBuf& A, bool preserve_alpha0, ROI roi,
+            int nthreads)
+{
+    return hwy_rgba_unary_pixel_op<Rtype, Atype>(
+        R, A, roi, nthreads,
+        [preserve_alpha0](auto d, auto& r, auto& g, auto& b, auto& a) {
+            auto mul = a;
+            if (preserve_alpha0) {
+                // repremult: pixels with alpha 0 pass through unchanged.
+                mul = hn::IfThenElse(hn::Eq(a, hn::Zero(d)), hn::Set(d, 1.0f),
+                                     a);
+            }
+            r = hn::Mul(r, mul);
+            g = hn::Mul(g, mul);
+            b = hn::Mul(b, mul);
+        });
+}
+#endif  // OIIO_USE_HWY
+
+
+
 template<class Rtype, class Atype>
 static bool
 premult_(ImageBuf& R, const ImageBuf& A, bool preserve_alpha0, ROI roi,
          int nthreads)
 {
+#if OIIO_USE_HWY
+    if (hwy_rgba_ok<Rtype, Atype>(R, A, roi))
+        return premult_hwy<Rtype, Atype>(R, A, preserve_alpha0, roi, nthreads);
+#endif
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
         int alpha_channel = A.spec().alpha_channel;
         int z_channel     = A.spec().z_channel;
@@ -997,6 +1245,82 @@ allspan(cspan<T> s, const T& v)
 
 
 
+#if OIIO_USE_HWY
+template<class D, class S>
+static bool
+contrast_remap_hwy(ImageBuf& dst, const ImageBuf& src, cspan<float> black,
+                   cspan<float> white, cspan<float> min, cspan<float> max,
+                   cspan<float> scontrast, cspan<float> sthresh, ROI roi,
+                   int nthreads)
+{
+    using MathT = typename SimdMathType<D>::type;
+    const hn::ScalableTag<MathT> dm;
+    const int n                 = roi.nchannels();
+    const bool same_black_white = (black == white);
+    const bool use_sigmoid      = !allspan(scontrast, 1.0f);
+    const bool do_minmax        = !(allspan(min, 0.0f) && allspan(max, 1.0f));
+    // Per-channel constants, including the parts of the sigmoid that don't
+    // depend on the pixel value.
+    float* bwdiffinv = OIIO_ALLOCA(float, n);
+    float* y         = OIIO_ALLOCA(float, n);
+    float* denom     = OIIO_ALLOCA(float, n);
+    for (int c = 0; c < n; ++c) {
+        bwdiffinv[c] = 1.0f / (white[c] - black[c]);
+        y[c]         = 1.0f / (1.0f + expf(scontrast[c] * sthresh[c]));
+        denom[c] = 1.0f / (1.0f + expf(scontrast[c] * (sthresh[c] - 1.0f)))
+                   - y[c];
+    }
+    auto blackt = ChannelPatternTable(dm, black, n);
+    auto invt   = ChannelPatternTable(dm, cspan<float>(bwdiffinv, n), n);
+    auto mint   = ChannelPatternTable(dm, min, n);
+    auto maxt   = ChannelPatternTable(dm, max, n);
+    auto sct    = ChannelPatternTable(dm, scontrast, n);
+    auto stt    = ChannelPatternTable(dm, sthresh, n);
+    auto yt     = ChannelPatternTable(dm, cspan<float>(y, n), n);
+    auto dent   = ChannelPatternTable(dm, cspan<float>(denom, n), n);
+    const MathT *blackp = blackt.data(), *invp = invt.data(),
+                *minp = mint.data(), *maxp = maxt.data(), *scp = sct.data(),
+                *stp = stt.data(), *yp = yt.data(), *denp = dent.data();
+
+    if (same_black_white) {
+        // Special case -- black & white are the same value, which is just
+        // a binary threshold.
+        return hwy_unary_perpixel_op<D, S>(
+            dst, src, roi, nthreads, [=](auto d, auto va, size_t i) {
+                size_t p = i % size_t(n);
+                return hn::IfThenElse(hn::Lt(va, hn::LoadU(d, blackp + p)),
+                                      hn::LoadU(d, minp + p),
+                                      hn::LoadU(d, maxp + p));
+            });
+    }
+    return hwy_unary_perpixel_op<D, S>(
+        dst, src, roi, nthreads, [=](auto d, auto va, size_t i) {
+            size_t p = i % size_t(n);
+            // First do the linear stretch
+            auto r = hn::Mul(hn::Sub(va, hn::LoadU(d, blackp + p)),
+                             hn::LoadU(d, invp + p));
+            // Apply the sigmoid if needed
+            if (use_sigmoid) {
+                auto one = hn::Set(d, MathT(1));
+                auto e   = hn::Exp(d, hn::Mul(hn::LoadU(d, scp + p),
+                                              hn::Sub(hn::LoadU(d, stp + p),
+                                                      r)));
+                auto x   = hn::Div(one, hn::Add(one, e));
+                r        = hn::Div(hn::Sub(x, hn::LoadU(d, yp + p)),
+                                   hn::LoadU(d, denp + p));
+            }
+            // remap output range if needed
+            if (do_minmax) {
+                auto vmin = hn::LoadU(d, minp + p);
+                r = hn::MulAdd(hn::Sub(hn::LoadU(d, maxp + p), vmin), r, vmin);
+            }
+            return r;
+        });
+}
+#endif  // OIIO_USE_HWY
+
+
+
 template<class D, class S>
 static bool
 contrast_remap_(ImageBuf& dst, const ImageBuf& src, cspan<float> black,
@@ -1004,6 +1328,12 @@ contrast_remap_(ImageBuf& dst, const ImageBuf& src, cspan<float> black,
                 cspan<float> scontrast, cspan<float> sthresh, ROI roi,
                 int nthreads)
 {
+#if OIIO_USE_HWY
+    if (OIIO::pvt::enable_hwy && HwySupports<D>(dst, roi)
+        && HwySupports<S>(src, roi))
+        return contrast_remap_hwy<D, S>(dst, src, black, white, min, max,
+                                        scontrast, sthresh, roi, nthreads);
+#endif
     bool same_black_white = (black == white);
     float* bwdiffinv      = OIIO_ALLOCA(float, roi.chend);
     for (int c = roi.chbegin; c < roi.chend; ++c)
@@ -1113,11 +1443,41 @@ ImageBufAlgo::contrast_remap(const ImageBuf& src, cspan<float> black,
 
 
 
+#if OIIO_USE_HWY
+template<class Rtype, class Atype>
+static bool
+saturate_hwy(ImageBuf& R, const ImageBuf& A, float scale, ROI roi,
+             int nthreads)
+{
+    return hwy_rgba_unary_pixel_op<Rtype, Atype>(
+        R, A, roi, nthreads,
+        [scale](auto d, auto& r, auto& g, auto& b, auto& /*a*/) {
+            // Same linear sRGB luma weights as saturate_
+            auto luma = hn::Mul(r, hn::Set(d, 0.2126f));
+            luma      = hn::MulAdd(g, hn::Set(d, 0.7152f), luma);
+            luma      = hn::MulAdd(b, hn::Set(d, 0.0722f), luma);
+            auto s    = hn::Set(d, scale);
+            r         = hn::MulAdd(hn::Sub(r, luma), s, luma);
+            g         = hn::MulAdd(hn::Sub(g, luma), s, luma);
+            b         = hn::MulAdd(hn::Sub(b, luma), s, luma);
+        });
+}
+#endif  // OIIO_USE_HWY
+
+
+
 template<class Rtype, class Atype>
 static bool
 saturate_(ImageBuf& R, const ImageBuf& A, float scale, int firstchannel,
           ROI roi, int nthreads)
 {
+#if OIIO_USE_HWY
+    // Packed RGBA (or RGB + any fourth channel, which passes through).
+    if (OIIO::pvt::enable_hwy && firstchannel == 0 && roi.chbegin == 0
+        && roi.chend == 4 && HwySupports<Rtype>(R, roi)
+        && HwySupports<Atype>(A, roi))
+        return saturate_hwy<Rtype, Atype>(R, A, scale, roi, nthreads);
+#endif
     ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
         // Gross simplification: assume linear sRGB primaries. Ick -- but
         // what else to do if we don't really know the color space or its
@@ -1653,12 +2013,148 @@ decode_over_channels(const ImageBuf& R, int& nchannels, int& alpha, int& z,
 
 
 
+// Can over_impl_local handle R = A over B for this roi? All three buffers
+// must be local, with contiguous pixels covering the roi, and the roi must
+// span all channels.
+static bool
+over_local_ok(const ImageBuf& R, const ImageBuf& A, const ImageBuf& B, ROI roi)
+{
+    auto ok = [&](const ImageBuf& img) {
+        return img.localpixels() && !img.deep() && img.roi().contains(roi)
+               && img.nchannels() == roi.chend
+               && img.pixel_stride() == stride_t(img.spec().pixel_bytes());
+    };
+    return roi.chbegin == 0 && ok(R) && ok(A) && ok(B);
+}
+
+
+
+// Over (or z-composite) for local buffers of any pixel types and channel
+// layout, such as half or uint8 RGBA, RGBA plus AOVs, or RGBAZ. Each
+// scanline of A and B is converted to float, composited a pixel at a time
+// four channels per SIMD op, and converted back to R's type. The results
+// are the same as the iterator loop in over_impl.
+static bool
+over_impl_local(ImageBuf& R, const ImageBuf& A, const ImageBuf& B, bool zcomp,
+                bool z_zeroisinf, ROI roi, int nthreads)
+{
+    using namespace simd;
+    int nchannels = 0, alpha_channel = 0, z_channel = 0, ncolor_channels = 0;
+    decode_over_channels(R, nchannels, alpha_channel, z_channel,
+                         ncolor_channels);
+    bool has_z = (z_channel >= 0);
+    zcomp &= has_z;
+
+    ImageBufAlgo::parallel_image(roi, nthreads, [=, &R, &A, &B](ROI roi) {
+        const vfloat4 one = vfloat4::One();
+        int w             = roi.width();
+        int n             = w * nchannels;
+        std::unique_ptr<float[]> buf(new float[3 * size_t(n)]);
+        float* abuf = buf.get();
+        float* bbuf = abuf + n;
+        float* rbuf = bbuf + n;
+
+        // Return scanline (y,z) of img as floats, converting into `tmp` if
+        // it isn't already float.
+        auto floatrow = [&](const ImageBuf& img, float* tmp, int y, int z) {
+            const void* p = img.pixeladdr(roi.xbegin, y, z);
+            if (img.spec().format == TypeFloat)
+                return (const float*)p;
+            convert_pixel_values(img.spec().format, p, TypeFloat, tmp, n);
+            return (const float*)tmp;
+        };
+
+        bool rfloat = (R.spec().format == TypeFloat);
+        for (int z = roi.zbegin; z < roi.zend; ++z) {
+            for (int y = roi.ybegin; y < roi.yend; ++y) {
+                const float* arow = floatrow(A, abuf, y, z);
+                const float* brow = floatrow(B, bbuf, y, z);
+                void* rptr        = R.pixeladdr(roi.xbegin, y, z);
+                float* r          = rfloat ? (float*)rptr : rbuf;
+                for (int x = 0; x < w; ++x, r += nchannels) {
+                    const float* a = arow + x * nchannels;
+                    const float* b = brow + x * nchannels;
+                    if (zcomp) {
+                        float az = a[z_channel], bz = b[z_channel];
+                        if (z_zeroisinf) {
+                            if (az == 0.0f)
+                                az = std::numeric_limits<float>::max();
+                            if (bz == 0.0f)
+                                bz = std::numeric_limits<float>::max();
+                        }
+                        if (az > bz)
+                            std::swap(a, b);  // B over A
+                    }
+                    // Grab z first, in case r is the same memory as a or b
+                    float alpha = clamp(a[alpha_channel], 0.0f, 1.0f);
+                    float rz    = has_z ? (alpha != 0.0f ? a[z_channel]
+                                                         : b[z_channel])
+                                        : 0.0f;
+                    vfloat4 one_minus_alpha = one - vfloat4(alpha);
+                    int c                   = 0;
+                    for (; c + 4 <= nchannels; c += 4) {
+                        vfloat4 result = vfloat4(a + c)
+                                         + one_minus_alpha * vfloat4(b + c);
+                        result.store(r + c);
+                    }
+                    if (c < nchannels) {
+                        vfloat4 av, bv;
+                        av.load(a + c, nchannels - c);
+                        bv.load(b + c, nchannels - c);
+                        vfloat4 result = av + one_minus_alpha * bv;
+                        result.store(r + c, nchannels - c);
+                    }
+                    if (has_z)
+                        r[z_channel] = rz;
+                }
+                if (!rfloat)
+                    convert_pixel_values(TypeFloat, rbuf, R.spec().format,
+                                         rptr, n);
+            }
+        }
+    });
+    return true;
+}
+
+
+
+#if OIIO_USE_HWY
+// A over B for packed RGBA images with alpha in channel 3 and no z.
+template<class Rtype, class Atype, class Btype>
+static bool
+over_impl_hwy(ImageBuf& R, const ImageBuf& A, const ImageBuf& B, ROI roi,
+              int nthreads)
+{
+    return hwy_rgba_binary_pixel_op<Rtype, Atype, Btype>(
+        R, A, B, roi, nthreads,
+        [](auto d, auto& ar, auto& ag, auto& ab, auto& aa, auto br, auto bg,
+           auto bb, auto ba) {
+            auto one             = hn::Set(d, 1.0f);
+            auto alpha           = hn::Min(hn::Max(aa, hn::Zero(d)), one);
+            auto one_minus_alpha = hn::Sub(one, alpha);
+            ar                   = hn::MulAdd(one_minus_alpha, br, ar);
+            ag                   = hn::MulAdd(one_minus_alpha, bg, ag);
+            ab                   = hn::MulAdd(one_minus_alpha, bb, ab);
+            aa                   = hn::MulAdd(one_minus_alpha, ba, aa);
+        });
+}
+#endif  // OIIO_USE_HWY
+
+
+
 // Fully type-specialized version of over.
 template<class Rtype, class Atype, class Btype>
 static bool
 over_impl(ImageBuf& R, const ImageBuf& A, const ImageBuf& B, bool zcomp,
           bool z_zeroisinf, ROI roi, int nthreads)
 {
+#if OIIO_USE_HWY
+    if (!zcomp && hwy_rgba_ok<Rtype, Atype, Btype>(R, A, roi, &B))
+        return over_impl_hwy<Rtype, Atype, Btype>(R, A, B, roi, nthreads);
+#endif
+    if (over_local_ok(R, A, B, roi))
+        return over_impl_local(R, A, B, zcomp, z_zeroisinf, roi, nthreads);
+
     // It's already guaranteed that R, A, and B have matching channel
     // ordering, and have an alpha channel.  So just decode one.
     int nchannels = 0, alpha_channel = 0, z_channel = 0, ncolor_channels = 0;
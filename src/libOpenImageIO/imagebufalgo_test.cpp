@@ -4,9 +4,11 @@
 
 
 #include <cstdio>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <thread>
 
 // Must be first to ensure that half is defined before typedesc.h included
 #include <OpenImageIO/half.h>
@@ -387,6 +389,120 @@ test_paste()
 
 
 
+// Test the orientation operations (transpose, rotations, flip, flop). Each
+// is run into an empty dst, which takes the direct copy of local pixels,
+// and into a float dst of the same shape, which forces the general iterator
+// code. The two must agree.
+void
+test_orient()
+{
+    std::cout << "test orient\n";
+    using OrientFunc = std::function<bool(ImageBuf&, const ImageBuf&)>;
+    const std::pair<const char*, OrientFunc> ops[] = {
+        { "transpose",
+          [](ImageBuf& R, const ImageBuf& A) {
+              return ImageBufAlgo::transpose(R, A);
+          } },
+        { "rotate90",
+          [](ImageBuf& R, const ImageBuf& A) {
+              return ImageBufAlgo::rotate90(R, A);
+          } },
+        { "rotate180",
+          [](ImageBuf& R, const ImageBuf& A) {
+              return ImageBufAlgo::rotate180(R, A);
+          } },
+        { "rotate270",
+          [](ImageBuf& R, const ImageBuf& A) {
+              return ImageBufAlgo::rotate270(R, A);
+          } },
+        { "flip",
+          [](ImageBuf& R, const ImageBuf& A) {
+              return ImageBufAlgo::flip(R, A);
+          } },
+        { "flop",
+          [](ImageBuf& R, const ImageBuf& A) {
+              return ImageBufAlgo::flop(R, A);
+          } },
+    };
+    // Pixels with an in-register transpose (1, 2, and 4 bytes, the last
+    // two ways) and without (3, 6, 12, and 16 bytes), and odd sizes that
+    // span one or several 32x32 copy blocks. The data windows (and display
+    // windows) are at zero, offset from zero, and inside a larger display
+    // window. The rotations only keep the pixels within the data window
+    // when the display window's x and y origins are equal.
+    const std::pair<int, TypeDesc> pixels[]
+        = { { 1, TypeUInt8 },  { 2, TypeUInt8 },  { 3, TypeUInt8 },
+            { 4, TypeUInt8 },  { 2, TypeUInt16 }, { 3, TypeUInt16 },
+            { 3, TypeFloat },  { 4, TypeFloat } };
+    const std::pair<ROI, ROI> windows[] = {
+        { ROI(0, 37, 0, 23), ROI(0, 37, 0, 23) },
+        { ROI(-6, 64, -6, 39), ROI(-6, 64, -6, 39) },
+        { ROI(5, 42, -3, 20), ROI(3, 48, -6, 24) },
+    };
+    for (auto pixel : pixels) {
+        for (auto win : windows) {
+            ImageSpec spec(win.first.width(), win.first.height(), pixel.first,
+                           pixel.second);
+            spec.x           = win.first.xbegin;
+            spec.y           = win.first.ybegin;
+            spec.full_x      = win.second.xbegin;
+            spec.full_y      = win.second.ybegin;
+            spec.full_width  = win.second.width();
+            spec.full_height = win.second.height();
+            ImageBuf src(spec);
+            ImageBufAlgo::noise(src, "uniform", 0.0f, 1.0f, false, 42);
+            for (auto& op : ops) {
+                ImageBuf fast;
+                OIIO_CHECK_ASSERT(op.second(fast, src));
+                ImageSpec slowspec = fast.spec();
+                slowspec.set_format(TypeFloat);
+                ImageBuf slow(slowspec);
+                OIIO_CHECK_ASSERT(op.second(slow, src));
+                OIIO_CHECK_EQUAL(fast.spec().format, pixel.second);
+                OIIO_CHECK_EQUAL(fast.roi(), slow.roi());
+                OIIO_CHECK_EQUAL(fast.roi_full(), slow.roi_full());
+                auto cr = ImageBufAlgo::compare(fast, slow, 0.0f, 0.0f);
+                if (cr.nfail || cr.error)
+                    print("  {} {}[{}] {}: {} pixels differ\n", op.first,
+                          pixel.second, pixel.first, win.first, cr.nfail);
+                OIIO_CHECK_ASSERT(cr.nfail == 0 && !cr.error);
+            }
+        }
+    }
+
+    // Timing, against a plain copy of the same pixels
+    Benchmarker bench;
+    bench.trials(ntrials);
+    bench.iterations(iterations);
+#if defined(NDEBUG) || !defined(OIIO_CI)
+    const int rez = 2048;
+#else
+    const int rez = 256;
+#endif
+    const std::pair<int, TypeDesc> benchpixels[]
+        = { { 1, TypeUInt8 },  { 3, TypeUInt8 }, { 4, TypeUInt8 },
+            { 3, TypeUInt16 }, { 4, TypeHalf },  { 3, TypeFloat },
+            { 4, TypeFloat } };
+    for (auto pixel : benchpixels) {
+        ImageBuf src(ImageSpec(rez, rez, pixel.first, pixel.second));
+        ImageBuf dst;
+        std::string type = Strutil::fmt::format("{}[{}]", pixel.second,
+                                                pixel.first);
+        bench(Strutil::fmt::format("  IBA::{:9} {:10} ", "copy", type), [&]() {
+            dst.clear();
+            ImageBufAlgo::copy(dst, src);
+        });
+        for (auto& op : ops)
+            bench(Strutil::fmt::format("  IBA::{:9} {:10} ", op.first, type),
+                  [&]() {
+                      dst.clear();
+                      op.second(dst, src);
+                  });
+    }
+}
+
+
+
 void
 test_channel_append()
 {
@@ -606,6 +722,99 @@ test_hwy_strided_roi_fallback()
 }
 
 
+
+// Compare the Highway and scalar paths of the per-pixel ops of
+// imagebufalgo_pixelmath.cpp, for each of the common pixel data types.
+void
+test_hwy_pixelmath()
+{
+#if OIIO_USE_HWY
+    std::cout << "test hwy pixelmath\n";
+
+    int prev_enable_hwy = 0;
+    OIIO::getattribute("enable_hwy", prev_enable_hwy);
+
+    for (TypeDesc type : { TypeFloat, TypeHalf, TypeUInt8, TypeUInt16 }) {
+        // Allow for rounding differences of the stored result (one step of
+        // the integer types), plus a bit more for ops that use
+        // approximations of exp and log.
+        float typetol = type == TypeUInt8    ? 1.01f / 255.0f
+                        : type == TypeUInt16 ? 2.0f / 65535.0f
+                        : type == TypeHalf   ? 1.0e-3f
+                                             : 1.0e-5f;
+        // Odd width, to exercise the partial vectors at the ends of rows.
+        ImageSpec spec(61, 17, 4, type);
+        spec.alpha_channel = 3;
+        ImageBuf A(spec), B(spec);
+        ImageBufAlgo::fill(A, { 0.0f, 0.25f, 0.5f, 0.0f },
+                           { 1.0f, 0.75f, 0.1f, 0.5f },
+                           { 0.3f, 0.0f, 1.0f, 1.0f },
+                           { 0.9f, 1.0f, 0.0f, 0.7f });
+        ImageBufAlgo::fill(B, { 0.5f, 0.5f, 0.9f, 1.0f },
+                           { 0.1f, 0.2f, 0.3f, 0.0f },
+                           { 1.0f, 0.8f, 0.0f, 0.4f },
+                           { 0.0f, 0.6f, 0.5f, 0.2f });
+
+        auto check = [&](string_view name, bool approx, auto op) {
+            ImageBuf R0, R1;
+            OIIO::attribute("enable_hwy", 0);
+            op(R0);
+            OIIO::attribute("enable_hwy", 1);
+            op(R1);
+            float tol = approx ? std::max(typetol, 1.0e-4f) : typetol;
+            auto comp = ImageBufAlgo::compare(R0, R1, tol, tol);
+            if (comp.maxerror > tol)
+                std::cout << "  " << name << " " << type
+                          << " maxerror=" << comp.maxerror << "\n";
+            OIIO_CHECK_ASSERT(!R0.has_error() && !R1.has_error());
+            OIIO_CHECK_LE(comp.maxerror, tol);
+        };
+
+        check("clamp", false, [&](ImageBuf& R) {
+            ImageBufAlgo::clamp(R, A, { 0.2f, 0.1f, 0.3f, -1.0f },
+                                { 0.8f, 0.9f, 0.6f, 2.0f }, true);
+        });
+        check("absdiff", false,
+              [&](ImageBuf& R) { ImageBufAlgo::absdiff(R, A, B); });
+        check("absdiff const", false, [&](ImageBuf& R) {
+            ImageBufAlgo::absdiff(R, A, { 0.5f, 0.25f, 0.75f, 0.1f });
+        });
+        check("abs", false, [&](ImageBuf& R) { ImageBufAlgo::abs(R, A); });
+        check("pow", true, [&](ImageBuf& R) {
+            ImageBufAlgo::pow(R, A, { 2.2f, 0.5f, 1.0f / 2.2f, 1.0f });
+        });
+        check("contrast_remap linear", false, [&](ImageBuf& R) {
+            ImageBufAlgo::contrast_remap(R, A, { 0.1f }, { 0.9f }, { 0.2f },
+                                         { 0.7f });
+        });
+        check("contrast_remap sigmoid", true, [&](ImageBuf& R) {
+            ImageBufAlgo::contrast_remap(R, A, { 0.0f }, { 1.0f }, { 0.0f },
+                                         { 1.0f }, { 5.0f }, { 0.4f });
+        });
+        check("contrast_remap threshold", false, [&](ImageBuf& R) {
+            ImageBufAlgo::contrast_remap(R, A, { 0.5f }, { 0.5f }, { 0.2f },
+                                         { 0.8f });
+        });
+        check("channel_sum", false, [&](ImageBuf& R) {
+            ImageBufAlgo::channel_sum(R, A, { 0.25f, 0.5f, 0.125f, 0.125f });
+        });
+        check("saturate", false,
+              [&](ImageBuf& R) { ImageBufAlgo::saturate(R, A, 0.5f); });
+        check("premult", false,
+              [&](ImageBuf& R) { ImageBufAlgo::premult(R, A); });
+        check("repremult", false,
+              [&](ImageBuf& R) { ImageBufAlgo::repremult(R, A); });
+        check("unpremult", false,
+              [&](ImageBuf& R) { ImageBufAlgo::unpremult(R, A); });
+        check("over", false,
+              [&](ImageBuf& R) { ImageBufAlgo::over(R, A, B); });
+    }
+
+    OIIO::attribute("enable_hwy", prev_enable_hwy);
+#endif
+}
+
+
 // Tests ImageBufAlgo::min
 void
 test_min()
@@ -705,11 +914,11 @@ test_over(TypeDesc dtype = TypeFloat)
 
 // Test ImageBuf::zover
 void
-test_zover()
+test_zover(TypeDesc dtype = TypeFloat)
 {
-    std::cout << "test zover\n";
+    std::cout << "test zover " << dtype << "\n";
 
-    ImageSpec spec(4, 4, 5, TypeFloat);
+    ImageSpec spec(4, 4, 5, dtype);
     spec.channelnames.assign({ "R", "G", "B", "A", "Z" });
     spec.z_channel = 4;
 
@@ -966,6 +1175,43 @@ test_computePixelStats()
 
 
 
+// Tests ImageBufAlgo::computePixelHash()
+void
+test_computePixelHash()
+{
+    std::cout << "test computePixelHash\n";
+    // Big enough to be split into several hash blocks
+    ImageBuf img(ImageSpec(600, 700, 4, TypeDesc::FLOAT));
+    ImageBufAlgo::noise(img, "uniform", 0.0f, 1.0f, false, 42);
+
+    std::string h1 = ImageBufAlgo::computePixelHash(img, "xxhash", "", {}, 1);
+    std::string h8 = ImageBufAlgo::computePixelHash(img, "xxhash", "", {}, 8);
+    OIIO_CHECK_EQUAL(h1.size(), 16);
+    OIIO_CHECK_EQUAL(h1, h8);
+    OIIO_CHECK_NE(h1, ImageBufAlgo::computePixelHash(img, "farmhash"));
+    std::string f1 = ImageBufAlgo::computePixelHash(img, "farmhash", "", {}, 1);
+    std::string f8 = ImageBufAlgo::computePixelHash(img, "farmhash", "", {}, 8);
+    OIIO_CHECK_EQUAL(f1, f8);
+    OIIO_CHECK_NE(h1, ImageBufAlgo::computePixelHash(img, "xxhash", "salt"));
+
+    // A sub-region hashes the same as a cropped copy of it
+    ROI roi(10, 300, 20, 650);
+    ImageBuf cropped = ImageBufAlgo::cut(img, roi);
+    OIIO_CHECK_EQUAL(ImageBufAlgo::computePixelHash(img, "xxhash", "", roi),
+                     ImageBufAlgo::computePixelHash(cropped));
+
+    // Changing one pixel changes the hash
+    float red[4] = { 1, 0, 0, 1 };
+    img.setpixel(599, 699, make_span(red));
+    OIIO_CHECK_NE(h1, ImageBufAlgo::computePixelHash(img));
+
+    OIIO_CHECK_EQUAL(ImageBufAlgo::computePixelHash(img, "bogus"), "");
+    OIIO_CHECK_ASSERT(img.has_error());
+    img.geterror();
+}
+
+
+
 // Tests histogram computation.
 void
 histogram_computation_test()
@@ -1309,6 +1555,120 @@ test_color_management()
 
 
 
+// Directory of one family of the fonts in the source tree, or "" if it
+// isn't found from where the test runs.
+static std::string
+source_font_dir(string_view family)
+{
+    for (auto dir : { "src/fonts", "../../src/fonts" }) {
+        std::string d = Strutil::fmt::format("{}/{}", dir, family);
+        if (Filesystem::is_directory(d))
+            return d;
+    }
+    return std::string();
+}
+
+
+
+// Test that render_text from many threads at once, while the fonts and
+// glyphs are first being cached, gives the same pixels as a serial render.
+static void
+test_render_text_threads()
+{
+    OIIO::print("Testing render_text from many threads\n");
+    std::string saved_searchpath;
+    OIIO::getattribute("font_searchpath", saved_searchpath);
+    std::string fontdir = source_font_dir("Droid_Sans");
+    if (fontdir.size())
+        OIIO::attribute("font_searchpath", fontdir);
+    if (!ImageBufAlgo::text_size("x", 12).defined()) {
+        OIIO::print("  skipping, no font found\n");
+        OIIO::attribute("font_searchpath", saved_searchpath);
+        return;
+    }
+
+    const int nthreads = 16;
+    ImageSpec spec(160, 40, 3, TypeDesc::FLOAT);
+    auto render = [&](int i, ImageBuf& buf) {
+        buf.reset(spec);
+        ImageBufAlgo::zero(buf);
+        return ImageBufAlgo::render_text(
+            buf, 4, 30, Strutil::fmt::format("Thread {} text {}", i, i * 37),
+            16 + i % 4, "", { 1.0f, 0.5f, 0.25f },
+            ImageBufAlgo::TextAlignX::Left, ImageBufAlgo::TextAlignY::Baseline,
+            i % 2 /*shadow*/, ROI(), 1);
+    };
+
+    std::vector<ImageBuf> threaded(nthreads);
+    std::vector<int> ok(nthreads, 0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nthreads; ++i)
+        threads.emplace_back([&, i]() { ok[i] = render(i, threaded[i]); });
+    for (auto& t : threads)
+        t.join();
+
+    for (int i = 0; i < nthreads; ++i) {
+        ImageBuf serial;
+        OIIO_CHECK_ASSERT(ok[i]);
+        OIIO_CHECK_ASSERT(render(i, serial));
+        auto cr = ImageBufAlgo::compare(threaded[i], serial, 0.0f, 0.0f);
+        OIIO_CHECK_EQUAL(cr.nfail, 0);
+        OIIO_CHECK_EQUAL(cr.maxerror, 0.0);
+    }
+    OIIO::attribute("font_searchpath", saved_searchpath);
+}
+
+
+
+// Test that a font name already used by render_text is resolved again
+// when the font search path changes.
+static void
+test_render_text_searchpath()
+{
+    OIIO::print("Testing render_text after the font search path changes\n");
+    std::string sansdir  = source_font_dir("Droid_Sans");
+    std::string serifdir = source_font_dir("Droid_Serif");
+    if (sansdir.empty() || serifdir.empty()) {
+        OIIO::print("  skipping, source fonts not found\n");
+        return;
+    }
+    std::string saved_searchpath;
+    OIIO::getattribute("font_searchpath", saved_searchpath);
+
+    // A directory where "DroidSans" is really Droid Serif
+    std::string otherdir = Filesystem::temp_directory_path() + "/"
+                           + Filesystem::unique_path("oiio-fonts-%%%%%%%%");
+    std::string otherfont = otherdir + "/DroidSans.ttf";
+    OIIO_CHECK_ASSERT(Filesystem::create_directory(otherdir));
+    OIIO_CHECK_ASSERT(
+        Filesystem::copy(serifdir + "/DroidSerif.ttf", otherfont));
+
+    ImageSpec spec(160, 40, 1, TypeDesc::FLOAT);
+    auto render = [&](string_view font, ImageBuf& buf) {
+        buf.reset(spec);
+        ImageBufAlgo::zero(buf);
+        bool ok = ImageBufAlgo::render_text(buf, 4, 30, "Search path", 21,
+                                            font);
+        OIIO_CHECK_ASSERT(ok);
+    };
+    ImageBuf sans, other, direct;
+    OIIO::attribute("font_searchpath", sansdir);
+    render("DroidSans", sans);
+    OIIO::attribute("font_searchpath", otherdir);
+    render("DroidSans", other);
+    render(otherfont, direct);
+
+    auto cr = ImageBufAlgo::compare(other, direct, 0.0f, 0.0f);
+    OIIO_CHECK_EQUAL(cr.nfail, 0);
+    cr = ImageBufAlgo::compare(other, sans, 0.0f, 0.0f);
+    OIIO_CHECK_GT(cr.nfail, 0);
+
+    OIIO::attribute("font_searchpath", saved_searchpath);
+    Filesystem::remove_all(otherdir);
+}
+
+
+
 static void
 test_yee()
 {
@@ -1323,6 +1683,54 @@ test_yee()
     OIIO_CHECK_EQUAL(n, 1);
     OIIO_CHECK_EQUAL(cr.maxx, 0);
     OIIO_CHECK_EQUAL(cr.maxy, 0);
+
+    // A smooth image, and a copy with a luminance bump, a patch of changed
+    // color, and a patch of fine noise. The expected results are what
+    // compare_Yee reported before its pyramid blurs were made separable,
+    // when each level was made with a 5x5 ImageBufAlgo::convolve. The
+    // separable blurs round differently, so maxerror is checked to within
+    // a small tolerance.
+    const int w = 61, h = 43;
+    ImageBuf A(ImageSpec(w, h, 3, TypeDesc::FLOAT));
+    ImageBuf B(A.spec());
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            float c[3] = { 0.2f + 0.5f * float(x) / w,
+                           0.3f + 0.4f * float(y) / h,
+                           0.25f + 0.2f * sinf(0.3f * x) * cosf(0.2f * y) };
+            A.setpixel(x, y, c);
+            float dx   = x - 20.0f, dy = y - 15.0f;
+            float bump = 0.15f * expf(-(dx * dx + dy * dy) / 30.0f);
+            for (float& v : c)
+                v += bump;
+            if (x >= 40 && x < 50 && y >= 25 && y < 35)
+                c[1] += 0.08f;
+            if (x < 15 && y >= 30)
+                for (float& v : c)
+                    v += ((x + y) & 1) ? 0.02f : -0.02f;
+            B.setpixel(x, y, c);
+        }
+    }
+    n = ImageBufAlgo::compare_Yee(A, B, cr, 100.0f, 10.0f);
+    OIIO_CHECK_EQUAL(n, 205);
+    OIIO_CHECK_EQUAL(cr.nfail, 205);
+    OIIO_CHECK_EQUAL_THRESH(cr.maxerror, 8.78442, 1.0e-3);
+    OIIO_CHECK_EQUAL(cr.maxx, 40);
+    OIIO_CHECK_EQUAL(cr.maxy, 25);
+
+    // The decimated pyramid gives different, but similar, results.
+    int prev_decimate = 0;
+    OIIO::getattribute("imagebufalgo:yee_decimate", prev_decimate);
+    OIIO::attribute("imagebufalgo:yee_decimate", 1);
+    n = ImageBufAlgo::compare_Yee(A, B, cr, 100.0f, 10.0f);
+    OIIO_CHECK_EQUAL(n, 172);
+    OIIO_CHECK_EQUAL(cr.nfail, 172);
+    OIIO_CHECK_EQUAL_THRESH(cr.maxerror, 10.0, 1.0e-3);
+    OIIO_CHECK_EQUAL(cr.maxx, 22);
+    OIIO_CHECK_EQUAL(cr.maxy, 11);
+    n = ImageBufAlgo::compare_Yee(A, A, cr, 100.0f, 10.0f);
+    OIIO_CHECK_EQUAL(n, 0);
+    OIIO::attribute("imagebufalgo:yee_decimate", prev_decimate);
 }
 
 
@@ -1607,6 +2015,7 @@ test_demosaic_algo(const ImageBuf& src_image, const ImageBuf& mosaiced_image,
         = ImageBufAlgo::compare(src_image, demosaiced_image, threshold,
                                 threshold, roi);
     OIIO_CHECK_FALSE(cr.error);
+    OIIO_CHECK_EQUAL(cr.nfail, 0);
 
     if (write_images) {
         auto type        = TypeDescFromC<T>().value();
@@ -1718,6 +2127,22 @@ test_demosaic()
                     0.00049,  // half  threshold
                     4.6e-05,  // int16 threshold
                     0.012     // int8  threshold
+                } },
+              // RCD's ratio correction is regularized with a small
+              // epsilon, so it is not exact on linear gradients. The
+              // largest float error sits in the corner where green falls
+              // to zero; for the integer types, quantization noise in the
+              // flat gradient steers the direction and ratio estimates.
+              // Measured worst cases are 6.7e-06 (float), 6.1e-04 (half),
+              // 5.8e-04 (int16) and 3/255 (int8); the thresholds allow
+              // about twice that, or one more code value for int8.
+              { "RCD",  // name
+                6,      // inset
+                {
+                    1.4e-05,  // float threshold
+                    0.0012,   // half  threshold
+                    0.0012,   // int16 threshold
+                    0.016     // int8  threshold
                 } } } };
 
     // There are 6x6=36 possible permutations of the XTrans pattern,
@@ -1767,6 +2192,100 @@ test_demosaic()
 
 
 
+static void
+benchmark_demosaic()
+{
+    OIIO::print("Timing demosaic of an HD frame\n");
+    Benchmarker bench;
+    bench.trials(ntrials);
+    bench.iterations(iterations);
+    bench.units(Benchmarker::Unit::ms);
+    float wb[4] = { 2.0, 1.1, 1.5, 0.9 };
+    ImageBuf hd_image(ImageSpec(1920, 1080, 3, TypeFloat));
+    ImageBufAlgo::fill(hd_image, { 0.0f, 0.0f, 0.9f }, { 0.0f, 0.9f, 0.0f },
+                       { 0.9f, 0.0f, 0.9f }, { 0.9f, 0.9f, 0.0f });
+    ImageBuf hd_mosaic(ImageSpec(1920, 1080, 1, TypeFloat));
+    struct {
+        const char* pattern;
+        std::vector<const char*> algos;
+    } configs[] = { { "bayer", { "linear", "MHC", "RCD" } },
+                    { "xtrans", { "linear" } } };
+    for (const auto& config : configs) {
+        std::string layout = do_mosaic<float>(hd_mosaic, hd_image, 0, 0,
+                                              config.pattern, wb, 0);
+        for (const char* algo : config.algos) {
+            ParamValueList list;
+            list.push_back(ParamValue("pattern", config.pattern));
+            list.push_back(ParamValue("algorithm", algo));
+            list.push_back(ParamValue("layout", layout));
+            bench(Strutil::fmt::format("  IBA::demosaic HD {} {}",
+                                       config.pattern, algo),
+                  [&]() { ImageBufAlgo::demosaic(hd_mosaic, list); });
+        }
+    }
+}
+
+
+
+// Compare MHC and RCD on a zone plate, with a checkerboard of hard edges
+// on the right. Interpolation errors here come from the detail, not from
+// the borders, so the RMS error away from the edges of the image shows
+// which algorithm resolves it better.
+static void
+test_demosaic_zoneplate()
+{
+    OIIO::print("Testing Demosaicing of a zone plate\n");
+
+    const int width = 512, height = 384;
+    ImageBuf src_image(ImageSpec(width, height, 3, TypeFloat));
+    for (ImageBuf::Iterator<float> it(src_image); !it.done(); ++it) {
+        int x      = it.x();
+        int y      = it.y();
+        float r    = std::hypot(x - width / 2.0f, y - height / 2.0f);
+        float base = 0.5f + 0.4f * std::sin(r * r / 900.0f);
+        if (x > width * 3 / 4)
+            base = ((x / 7 + y / 5) & 1) ? 0.8f : 0.2f;
+        it[0] = base * 0.9f + 0.05f;
+        it[1] = base * 0.8f + 0.1f;
+        it[2] = base * 0.6f + 0.2f;
+    }
+
+    float wb[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    ROI roi     = src_image.roi();
+    roi.xbegin += 10;
+    roi.ybegin += 10;
+    roi.xend -= 10;
+    roi.yend -= 10;
+
+    ImageBuf mosaiced_image(ImageSpec(width, height, 1, TypeFloat));
+    for (int y = 0; y < 2; y++) {
+        for (int x = 0; x < 2; x++) {
+            std::string layout = do_mosaic<float>(mosaiced_image, src_image,
+                                                  x, y, "bayer", wb, 0);
+            double rms_error[2];
+            const char* algos[2] = { "MHC", "RCD" };
+            for (int a = 0; a < 2; a++) {
+                ParamValueList list;
+                list.push_back(ParamValue("pattern", "bayer"));
+                list.push_back(ParamValue("algorithm", algos[a]));
+                list.push_back(ParamValue("layout", layout));
+                ImageBuf result = ImageBufAlgo::demosaic(mosaiced_image,
+                                                         list);
+                auto cr = ImageBufAlgo::compare(src_image, result, 1.0f,
+                                                1.0f, roi);
+                OIIO_CHECK_FALSE(cr.error);
+                rms_error[a] = cr.rms_error;
+            }
+            OIIO::print("  {}: MHC rms error {:.4f}, RCD {:.4f}\n", layout,
+                        rms_error[0], rms_error[1]);
+            // RCD measures 0.49-0.55 of the MHC error, depending on layout.
+            OIIO_CHECK_LT(rms_error[1], 0.6 * rms_error[0]);
+        }
+    }
+}
+
+
+
 // clang-format off
 // Neat trick macro to prefix in front of the calls where we want to
 // run it in both hwy and non-hwy modes. It will loop over both settings.
@@ -1800,32 +2319,39 @@ main(int argc, char** argv)
     test_copy();
     test_crop();
     test_paste();
+    test_orient();
     test_channel_append();
     HWY_TEST test_add();
     HWY_TEST test_sub();
     HWY_TEST test_mul();
     HWY_TEST test_mad();
     test_hwy_strided_roi_fallback();
+    test_hwy_pixelmath();
     test_min();
     test_max();
     test_over(TypeFloat);
     test_over(TypeHalf);
-    test_zover();
+    test_zover(TypeFloat);
+    test_zover(TypeHalf);
     test_resample();
     test_compare();
     test_isConstantColor();
     test_isConstantChannel();
     test_isMonochrome();
     test_computePixelStats();
+    test_computePixelHash();
     histogram_computation_test();
     test_maketx_from_imagebuf();
     test_IBAprep();
     test_validate_st_warp_checks();
     test_opencv();
     test_color_management();
+    test_render_text_threads();
+    test_render_text_searchpath();
     test_yee();
     test_FLIP();
     test_demosaic();
+    test_demosaic_zoneplate();
     test_simple_perpixel<float>();
     test_simple_perpixel<half>();
 
@@ -1834,6 +2360,7 @@ main(int argc, char** argv)
     benchmark_parallel_image(1024, iterations * 4);
 #if defined(NDEBUG) || !defined(OIIO_CI)
     benchmark_parallel_image(2048, iterations);
+    benchmark_demosaic();
 #endif
 
     return unit_test_failures;
@@ -8,6 +8,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 #include <OpenImageIO/Imath.h>
 #include <OpenImageIO/dassert.h>
@@ -15,6 +16,9 @@
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagebufalgo_util.h>
+
+#include "imageio_pvt.h"
+
 using Imath::Color3f;
 
 
@@ -35,42 +39,109 @@ namespace {
 #define PYRAMID_MAX_LEVELS 8
 
 
+// Successively more blurred copies of a 1-channel float image. Each level
+// is the previous one blurred by a 5x5 gaussian with clamped edges, done as
+// two separable 5-tap passes. Ordinarily all levels keep the full
+// resolution (so it's not really a pyramid). If `decimate` is true, each
+// level instead keeps every other pixel of its blurred predecessor in each
+// direction, and is bilinearly upsampled when read back. That costs about
+// a third of one level in memory and blurring, instead of seven full
+// levels, but its coarser levels are blurrier than the full resolution
+// ones, so the results differ.
 class GaussianPyramid {
 public:
-    GaussianPyramid(ImageBuf& image)
+    GaussianPyramid(std::vector<float>& image, int width, int height,
+                    bool decimate, int nthreads)
     {
+        m_width[0]  = width;
+        m_height[0] = height;
         level[0].swap(image);  // swallow the source as the top level
-        ImageBuf kernel = ImageBufAlgo::make_kernel("gaussian", 5, 5);
-        for (int i = 1; i < PYRAMID_MAX_LEVELS; ++i)
-            ImageBufAlgo::convolve(level[i], level[i - 1], kernel);
+        // The 5x5 gaussian kernel is the outer product of this 5x1 one.
+        ImageBuf kernel = ImageBufAlgo::make_kernel("gaussian", 5, 1);
+        const float* k  = (const float*)kernel.localpixels();
+        const int step  = decimate ? 2 : 1;
+        std::vector<float> tmp;
+        for (int i = 1; i < PYRAMID_MAX_LEVELS; ++i) {
+            m_width[i]  = (m_width[i - 1] + step - 1) / step;
+            m_height[i] = (m_height[i - 1] + step - 1) / step;
+            tmp.resize(size_t(m_width[i]) * m_height[i - 1]);
+            level[i].resize(size_t(m_width[i]) * m_height[i]);
+            blur(i, step, tmp.data(), k, nthreads);
+        }
     }
 
     ~GaussianPyramid() {}
 
-    float value(int x, int y, int lev) const
-    {
-        if (lev >= PYRAMID_MAX_LEVELS)
-            return 0.0f;
-        else
-            return level[lev].getchannel(x, y, 0, 0);
-    }
-
-#if 0 /* unused */
-    ImageBuf& operator[](int lev)
+    // Scanline y of level `lev`, as width() floats at the full resolution.
+    // A decimated level is upsampled into `scratch`, which must have room
+    // for width() floats.
+    const float* row(int lev, int y, float* scratch) const
     {
         OIIO_DASSERT(lev < PYRAMID_MAX_LEVELS);
-        return level[lev];
+        const int w = m_width[lev], h = m_height[lev];
+        if (w == m_width[0] && h == m_height[0])
+            return level[lev].data() + imagesize_t(y) * w;
+        // Pixel j of a decimated level lies on pixel 2j of the one before.
+        const float scale = 1.0f / float(1 << lev);
+        int y0;
+        float ty       = floorfrac(y * scale, &y0);
+        const float* a = level[lev].data() + imagesize_t(y0) * w;
+        const float* b = level[lev].data()
+                         + imagesize_t(std::min(y0 + 1, h - 1)) * w;
+        for (int x = 0; x < m_width[0]; ++x) {
+            int x0;
+            float tx   = floorfrac(x * scale, &x0);
+            int x1     = std::min(x0 + 1, w - 1);
+            scratch[x] = bilerp(a[x0], a[x1], b[x0], b[x1], tx, ty);
+        }
+        return scratch;
     }
 
-    float operator()(int x, int y, int lev) const
-    {
-        OIIO_DASSERT(lev < PYRAMID_MAX_LEVELS);
-        return level[lev].getchannel(x, y, 0, 0);
-    }
-#endif
+    int width() const { return m_width[0]; }
 
 private:
-    ImageBuf level[PYRAMID_MAX_LEVELS];
+    std::vector<float> level[PYRAMID_MAX_LEVELS];
+    int m_width[PYRAMID_MAX_LEVELS], m_height[PYRAMID_MAX_LEVELS];
+
+    // Blur level lev-1 into level lev, keeping every step-th pixel in each
+    // direction, and using tmp for the result of the horizontal pass.
+    void blur(int lev, int step, float* tmp, const float* k, int nthreads)
+    {
+        const int sw = m_width[lev - 1], sh = m_height[lev - 1];
+        const int w  = m_width[lev], h = m_height[lev];
+
+        const float* src = level[lev - 1].data();
+        float* dst       = level[lev].data();
+        ImageBufAlgo::parallel_image(ROI(0, w, 0, sh), nthreads, [&](ROI roi) {
+            for (int y = roi.ybegin; y < roi.yend; ++y) {
+                const float* s = src + imagesize_t(y) * sw;
+                float* t       = tmp + imagesize_t(y) * w;
+                for (int x = 0; x < w; ++x) {
+                    float sum = 0.0f;
+                    for (int i = -2; i <= 2; ++i)
+                        sum += k[i + 2]
+                               * s[OIIO::clamp(x * step + i, 0, sw - 1)];
+                    t[x] = sum;
+                }
+            }
+        });
+        ImageBufAlgo::parallel_image(ROI(0, w, 0, h), nthreads, [&](ROI roi) {
+            for (int y = roi.ybegin; y < roi.yend; ++y) {
+                const float* t[5];
+                for (int i = -2; i <= 2; ++i) {
+                    int ty   = OIIO::clamp(y * step + i, 0, sh - 1);
+                    t[i + 2] = tmp + imagesize_t(ty) * w;
+                }
+                float* d = dst + imagesize_t(y) * w;
+                for (int x = 0; x < w; ++x) {
+                    float sum = 0.0f;
+                    for (int i = 0; i < 5; ++i)
+                        sum += k[i] * t[i][x];
+                    d[x] = sum;
+                }
+            }
+        });
+    }
 };
 
 
@@ -87,23 +158,6 @@ AdobeRGBToXYZ_color(const Color3f& rgb)
 
 
 
-static bool
-AdobeRGBToXYZ(ImageBuf& A, ROI roi, int nthreads)
-{
-    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
-        for (ImageBuf::Iterator<float> a(A, roi); !a.done(); ++a) {
-            Color3f rgb(a[0], a[1], a[2]);
-            Color3f XYZ = AdobeRGBToXYZ_color(rgb);
-            a[0]        = XYZ.x;
-            a[1]        = XYZ.y;
-            a[2]        = XYZ.z;
-        }
-    });
-    return true;
-}
-
-
-
 /// Convert a color in XYZ space to LAB space.
 ///
 inline Color3f
@@ -132,19 +186,31 @@ XYZToLAB_color(const Color3f& xyz)
 
 
 
-static bool
-XYZToLAB(ImageBuf& A, ROI roi, int nthreads)
+// Convert the float RGB pixels of A, assumed to be Adobe RGB (1998), to
+// LAB in place, and set lum to the luminance of each pixel scaled by
+// `luminance`.
+static void
+AdobeRGBToLAB(ImageBuf& A, std::vector<float>& lum, float luminance,
+              int nthreads)
 {
-    ImageBufAlgo::parallel_image(roi, nthreads, [&](ROI roi) {
-        for (ImageBuf::Iterator<float> a(A, roi); !a.done(); ++a) {
-            Color3f XYZ(a[0], a[1], a[2]);
-            Color3f LAB = XYZToLAB_color(XYZ);
-            a[0]        = LAB.x;
-            a[1]        = LAB.y;
-            a[2]        = LAB.z;
+    OIIO_DASSERT(A.localpixels() && A.nchannels() == 3
+                 && A.spec().format == TypeFloat);
+    const int w = A.spec().width;
+    lum.resize(A.spec().image_pixels());
+    ImageBufAlgo::parallel_image(get_roi(A.spec()), nthreads, [&](ROI roi) {
+        for (int y = roi.ybegin; y < roi.yend; ++y) {
+            imagesize_t i = imagesize_t(y) * w + roi.xbegin;
+            float* a      = (float*)A.pixeladdr(roi.xbegin, y);
+            for (int x = roi.xbegin; x < roi.xend; ++x, ++i, a += 3) {
+                Color3f XYZ = AdobeRGBToXYZ_color(Color3f(a[0], a[1], a[2]));
+                lum[i]      = XYZ.y * luminance;
+                Color3f LAB = XYZToLAB_color(XYZ);
+                a[0]        = LAB.x;
+                a[1]        = LAB.y;
+                a[2]        = LAB.z;
+            }
         }
     });
-    return true;
 }
 
 
@@ -214,8 +280,6 @@ ImageBufAlgo::compare_Yee(const ImageBuf& img0, const ImageBuf& img1,
     result.maxx = 0, result.maxy = 0, result.maxz = 0, result.maxc = 0;
     result.nfail = 0, result.nwarn = 0;
 
-    int nscanlines = roi.height() * roi.depth();
-
     bool luminanceOnly = false;
 
     // assuming colorspaces are in Adobe RGB (1998), convert to LAB
@@ -223,33 +287,31 @@ ImageBufAlgo::compare_Yee(const ImageBuf& img0, const ImageBuf& img1,
     // paste() to copy of up to 3 channels, converting to float, and
     // ending up with a 0-origin image.  End up with an LAB image in
     // aLAB, and a luminance image in aLum.
-    ImageSpec spec(roi.width(), roi.height(), 3 /*chans*/, TypeDesc::FLOAT);
+    const int width  = roi.width();
+    const int height = roi.height();
+    ImageSpec spec(width, height, 3 /*chans*/, TypeDesc::FLOAT);
     ImageBuf aLAB(spec);
     ImageBufAlgo::paste(aLAB, 0, 0, 0, 0, img0, roi, nthreads);
-    AdobeRGBToXYZ(aLAB, ROI::All(), nthreads);  // contains XYZ now
-    ImageBuf aLum;
-    ImageBufAlgo::channels(aLum, aLAB, 1, { 1 } /* channelorder */);
-    ImageBufAlgo::mul(aLum, aLum, luminance, ROI::All(), nthreads);
-    XYZToLAB(aLAB, ROI::All(), nthreads);  // now it's LAB
+    std::vector<float> aLum;
+    AdobeRGBToLAB(aLAB, aLum, luminance, nthreads);
 
     // Same thing for img1/bLAB/bLum
     ImageBuf bLAB(spec);
     ImageBufAlgo::paste(bLAB, 0, 0, 0, 0, img1, roi, nthreads);
-    AdobeRGBToXYZ(bLAB, ROI::All(), nthreads);  // contains XYZ now
-    ImageBuf bLum;
-    ImageBufAlgo::channels(bLum, bLAB, 1, { 1 } /* channelorder */);
-    ImageBufAlgo::mul(bLum, bLum, luminance, ROI::All(), nthreads);
-    XYZToLAB(bLAB, ROI::All(), nthreads);  // now it's LAB
-
-    // Construct Gaussian pyramids (not really pyramids, because they all
-    // have the same resolution, but really just a bunch of successively
-    // more blurred images).
-    GaussianPyramid la(aLum);
-    GaussianPyramid lb(bLum);
+    std::vector<float> bLum;
+    AdobeRGBToLAB(bLAB, bLum, luminance, nthreads);
+
+    // Construct Gaussian pyramids (not really pyramids unless the
+    // "imagebufalgo:yee_decimate" attribute is set, because they all have
+    // the same resolution, but really just a bunch of successively more
+    // blurred images).
+    bool decimate = OIIO::pvt::yee_decimate != 0;
+    GaussianPyramid la(aLum, width, height, decimate, nthreads);
+    GaussianPyramid lb(bLum, width, height, decimate, nthreads);
 
     float num_one_degree_pixels = (float)(2 * tan(fov * 0.5 * M_PI / 180) * 180
                                           / M_PI);
-    float pixels_per_degree     = roi.width() / num_one_degree_pixels;
+    float pixels_per_degree     = width / num_one_degree_pixels;
 
     unsigned int adaptation_level = 0;
     for (int i = 0, npixels = 1;
@@ -267,69 +329,108 @@ ImageBufAlgo::compare_Yee(const ImageBuf& img0, const ImageBuf& img1,
     for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; ++i)
         F_freq[i] = csf_max / contrast_sensitivity(cpd[i], 100.0f);
 
-    for (int y = 0; y < nscanlines; ++y) {
-        for (int x = 0; x < roi.width(); ++x) {
-            float contrast[PYRAMID_MAX_LEVELS - 2];
-            float sum_contrast = 0;
-            for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; i++) {
-                float n1 = fabsf(la.value(x, y, i) - la.value(x, y, i + 1));
-                float n2 = fabsf(lb.value(x, y, i) - lb.value(x, y, i + 1));
-                float numerator   = std::max(n1, n2);
-                float d1          = fabsf(la.value(x, y, i + 2));
-                float d2          = fabsf(lb.value(x, y, i + 2));
-                float denominator = std::max(std::max(d1, d2), 1.0e-5f);
-                contrast[i]       = numerator / denominator;
-                sum_contrast += contrast[i];
+    // Evaluate rows in parallel, reading the pyramid levels and LAB images
+    // directly. Each row keeps its own tally, and the rows are combined in
+    // order afterwards so that ties for the maximum resolve as they would
+    // in a serial scan. (Scanlines past the first image plane of a volume
+    // are all black in both images and can never fail.)
+    struct RowResult {
+        imagesize_t nfail = 0;
+        float maxerror    = 0;
+        int maxx          = 0;
+    };
+    std::vector<RowResult> rows(height);
+    const float* aPix = (const float*)aLAB.localpixels();
+    const float* bPix = (const float*)bLAB.localpixels();
+    ROI all(0, width, 0, height);
+    ImageBufAlgo::parallel_image(all, nthreads, [&](ROI r) {
+        // Room to upsample a row of each level of a decimated pyramid
+        std::vector<float> scratch(decimate ? 2 * PYRAMID_MAX_LEVELS * width
+                                            : 0);
+        float* sa = scratch.data();
+        float* sb = sa + (decimate ? PYRAMID_MAX_LEVELS * width : 0);
+        for (int y = r.ybegin; y < r.yend; ++y) {
+            RowResult& row(rows[y]);
+            const float* lav[PYRAMID_MAX_LEVELS];
+            const float* lbv[PYRAMID_MAX_LEVELS];
+            for (int i = 0; i < PYRAMID_MAX_LEVELS; ++i) {
+                lav[i] = la.row(i, y, sa + imagesize_t(i) * width);
+                lbv[i] = lb.row(i, y, sb + imagesize_t(i) * width);
             }
-            if (sum_contrast < 1e-5)
-                sum_contrast = 1e-5f;
-            float F_mask[PYRAMID_MAX_LEVELS - 2];
-            float adapt = la.value(x, y, adaptation_level)
-                          + lb.value(x, y, adaptation_level);
-            adapt *= 0.5f;
-            if (adapt < 1e-5)
-                adapt = 1e-5f;
-            for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; i++)
-                F_mask[i] = mask(contrast[i]
-                                 * contrast_sensitivity(cpd[i], adapt));
-            float factor = 0;
-            for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; i++)
-                factor += contrast[i] * F_freq[i] * F_mask[i] / sum_contrast;
-            factor      = OIIO::clamp(factor, 1.0f, 10.0f);
-            float delta = fabsf(la.value(x, y, 0) - lb.value(x, y, 0));
-            bool pass   = true;
-            // pure luminance test
-            delta /= tvi(adapt);
-            if (delta > factor) {
-                pass = false;
-            } else if (!luminanceOnly) {
-                // CIE delta E test with modifications
-                float color_scale = 1.0f;
-                // ramp down the color test in scotopic regions
-                if (adapt < 10.0f) {
-                    color_scale = 1.0f - (10.0f - color_scale) / 10.0f;
-                    color_scale = color_scale * color_scale;
+            const float* aLABrow = aPix + imagesize_t(y) * width * 3;
+            const float* bLABrow = bPix + imagesize_t(y) * width * 3;
+            for (int x = 0; x < width; ++x) {
+                float contrast[PYRAMID_MAX_LEVELS - 2];
+                float sum_contrast = 0;
+                for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; i++) {
+                    float n1 = fabsf(lav[i][x] - lav[i + 1][x]);
+                    float n2 = fabsf(lbv[i][x] - lbv[i + 1][x]);
+                    float numerator   = std::max(n1, n2);
+                    float d1          = fabsf(lav[i + 2][x]);
+                    float d2          = fabsf(lbv[i + 2][x]);
+                    float denominator = std::max(std::max(d1, d2), 1.0e-5f);
+                    contrast[i]       = numerator / denominator;
+                    sum_contrast += contrast[i];
                 }
-                float da = aLAB.getchannel(x, y, 0, 1)
-                           - bLAB.getchannel(x, y, 0, 1);  // diff in A
-                float db = aLAB.getchannel(x, y, 0, 2)
-                           - bLAB.getchannel(x, y, 0, 2);  // diff in B
-                da    = da * da;
-                db    = db * db;
-                delta = (da + db) * color_scale;
-                if (delta > factor)
+                if (sum_contrast < 1e-5)
+                    sum_contrast = 1e-5f;
+                float F_mask[PYRAMID_MAX_LEVELS - 2];
+                float adapt = lav[adaptation_level][x]
+                              + lbv[adaptation_level][x];
+                adapt *= 0.5f;
+                if (adapt < 1e-5)
+                    adapt = 1e-5f;
+                for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; i++)
+                    F_mask[i] = mask(contrast[i]
+                                     * contrast_sensitivity(cpd[i], adapt));
+                float factor = 0;
+                for (int i = 0; i < PYRAMID_MAX_LEVELS - 2; i++)
+                    factor += contrast[i] * F_freq[i] * F_mask[i]
+                              / sum_contrast;
+                factor      = OIIO::clamp(factor, 1.0f, 10.0f);
+                float delta = fabsf(lav[0][x] - lbv[0][x]);
+                bool pass   = true;
+                // pure luminance test
+                delta /= tvi(adapt);
+                if (delta > factor) {
                     pass = false;
-            }
-            if (!pass) {
-                ++result.nfail;
-                if (factor > result.maxerror) {
-                    result.maxerror = factor;
-                    result.maxx     = x;
-                    result.maxy     = y;
-                    //                    result.maxz = z;
+                } else if (!luminanceOnly) {
+                    // CIE delta E test with modifications
+                    float color_scale = 1.0f;
+                    // ramp down the color test in scotopic regions
+                    if (adapt < 10.0f) {
+                        color_scale = 1.0f - (10.0f - color_scale) / 10.0f;
+                        color_scale = color_scale * color_scale;
+                    }
+                    float da = aLABrow[3 * x + 1]
+                               - bLABrow[3 * x + 1];  // diff in A
+                    float db = aLABrow[3 * x + 2]
+                               - bLABrow[3 * x + 2];  // diff in B
+                    da    = da * da;
+                    db    = db * db;
+                    delta = (da + db) * color_scale;
+                    if (delta > factor)
+                        pass = false;
+                }
+                if (!pass) {
+                    ++row.nfail;
+                    if (factor > row.maxerror) {
+                        row.maxerror = factor;
+                        row.maxx     = x;
+                    }
                 }
             }
         }
+    });
+
+    for (int y = 0; y < height; ++y) {
+        result.nfail += rows[y].nfail;
+        if (rows[y].maxerror > result.maxerror) {
+            result.maxerror = rows[y].maxerror;
+            result.maxx     = rows[y].maxx;
+            result.maxy     = y;
+            //            result.maxz = z;
+        }
     }
 
     return result.nfail;
@@ -3,11 +3,13 @@
 // https://github.com/AcademySoftwareFoundation/OpenImageIO
 
 
+#include <OpenImageIO/Imath.h>
 #include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagecache.h>
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/texture.h>
 #include <OpenImageIO/unittest.h>
 
 #include <iostream>
@@ -228,6 +230,171 @@ test_app_buffer()
 
 
 
+// Value of channel c of voxel (x,y,z) of the test volumes below. It's linear
+// in each coordinate, so trilinear interpolation reproduces it exactly.
+static float
+volume_value(float x, float y, float z, int c)
+{
+    return 0.5f * x + 0.25f * y + 0.125f * z + 10.0f * c;
+}
+
+
+
+// Add the tile of channels [chbegin,chend) at (x,y,z) of a float volume
+// with cubic tiles, filled with volume_value().
+static bool
+add_volume_tile(ImageCache& imagecache, ustring filename, int x, int y, int z,
+                int tilesize, int chbegin, int chend)
+{
+    std::vector<float> pixels;
+    for (int k = 0; k < tilesize; ++k)
+        for (int j = 0; j < tilesize; ++j)
+            for (int i = 0; i < tilesize; ++i)
+                for (int c = chbegin; c < chend; ++c)
+                    pixels.push_back(volume_value(x + i, y + j, z + k, c));
+    return imagecache.add_tile(filename, 0, 0, x, y, z, chbegin, chend,
+                               TypeFloat, pixels.data());
+}
+
+
+
+// Test texture3d lookups of one layer of a multi-layer volume, whose tiles
+// hold only that layer's channels.
+void
+test_texture3d_layers()
+{
+    Strutil::print("\nTesting texture3d of one layer of a volume\n");
+    auto imagecache = ImageCache::create(false /*not shared*/);
+    auto texsys     = TextureSystem::create(false, imagecache);
+
+    ustring name("layered_volume");
+    const int res = 8, tilesize = 4;
+    ImageSpec config(res, res, 4, TypeFloat);
+    config.depth = config.full_depth = res;
+    config.tile_width = config.tile_height = config.tile_depth = tilesize;
+    config.channelnames = { "A.R", "A.G", "B.R", "B.G" };
+    config.attribute("null:force", 1);
+    OIIO_CHECK_ASSERT(imagecache->add_file(name, NullInputCreator, &config));
+    for (int z = 0; z < res; z += tilesize)
+        for (int y = 0; y < res; y += tilesize)
+            for (int x = 0; x < res; x += tilesize)
+                for (int layer = 0; layer < 2; ++layer)
+                    OIIO_CHECK_ASSERT(add_volume_tile(*imagecache, name, x, y,
+                                                      z, tilesize, 2 * layer,
+                                                      2 * layer + 2));
+
+    // Voxel coordinates to look up: a voxel center, a point inside one tile,
+    // and points whose trilinear footprint straddles tiles.
+    const Imath::V3f points[] = { { 5.5f, 2.5f, 6.5f },
+                                  { 1.75f, 2.25f, 2.875f },
+                                  { 4.0f, 2.25f, 1.5f },
+                                  { 3.75f, 4.25f, 4.125f } };
+    Imath::V3f zero(0.0f);
+    for (int layer = 0; layer < 2; ++layer) {
+        for (auto interp :
+             { TextureOpt::InterpClosest, TextureOpt::InterpBilinear }) {
+            for (auto p : points) {
+                TextureOpt opt;
+                opt.firstchannel = 2 * layer;
+                opt.interpmode   = interp;
+                float result[2]  = { -1.0f, -1.0f };
+                OIIO_CHECK_ASSERT(texsys->texture3d(name, opt, p / float(res),
+                                                    zero, zero, zero, 2,
+                                                    result));
+                // Closest returns the voxel containing p; trilinear
+                // interpolates between voxel centers.
+                Imath::V3f v = interp == TextureOpt::InterpClosest
+                                   ? Imath::V3f(floorf(p.x), floorf(p.y),
+                                                floorf(p.z))
+                                   : p - Imath::V3f(0.5f);
+                for (int c = 0; c < 2; ++c)
+                    OIIO_CHECK_EQUAL_THRESH(result[c],
+                                            volume_value(v.x, v.y, v.z,
+                                                         2 * layer + c),
+                                            1.0e-4f);
+            }
+        }
+    }
+}
+
+
+
+// Test texture3d lookups in the background of a sparse volume, which is
+// read as constant tiles, and next to the one tile that has detail.
+void
+test_texture3d_sparse()
+{
+    Strutil::print("\nTesting texture3d of a sparse volume\n");
+    auto imagecache = ImageCache::create(false /*not shared*/);
+    auto texsys     = TextureSystem::create(false, imagecache);
+
+    ustring name(
+        "sparse.null?RES=32x32x32&TILE=8x8x8&CHANNELS=2&PIXEL=0.25,0.5");
+    const int res = 32, tilesize = 8;
+    const float background[2] = { 0.25f, 0.5f };
+    OIIO_CHECK_ASSERT(
+        add_volume_tile(*imagecache, name, 8, 8, 8, tilesize, 0, 2));
+
+    Imath::V3f zero(0.0f);
+    auto lookup = [&](Imath::V3f p, TextureOpt::InterpMode interp,
+                      float* result, float* dresult) {
+        TextureOpt opt;
+        opt.interpmode = interp;
+        OIIO_CHECK_ASSERT(texsys->texture3d(name, opt, p / float(res), zero,
+                                            zero, zero, 2, result, dresult,
+                                            dresult + 2, dresult + 4));
+    };
+    auto interps = { TextureOpt::InterpClosest, TextureOpt::InterpBilinear };
+
+    // Inside one constant tile, and with a trilinear footprint straddling
+    // eight constant tiles of the same value: the background, with no
+    // derivatives.
+    for (auto p : { Imath::V3f(20.25f, 4.75f, 27.125f),
+                    Imath::V3f(24.0f, 16.0f, 8.0f) }) {
+        for (auto interp : interps) {
+            float result[2], dresult[6];
+            lookup(p, interp, result, dresult);
+            for (int c = 0; c < 2; ++c)
+                OIIO_CHECK_EQUAL(result[c], background[c]);
+            for (float d : dresult)
+                OIIO_CHECK_EQUAL(d, 0.0f);
+        }
+    }
+
+    // Inside the tile with detail
+    {
+        float result[2], dresult[6];
+        lookup(Imath::V3f(9.5f, 10.5f, 14.5f), TextureOpt::InterpClosest,
+               result, dresult);
+        for (int c = 0; c < 2; ++c)
+            OIIO_CHECK_EQUAL_THRESH(result[c], volume_value(9, 10, 14, c),
+                                    1.0e-4f);
+    }
+
+    // Straddling the tile with detail and the background, halfway between
+    // voxel (15,12,12) and the background voxel (16,12,12).
+    {
+        float result[2], dresult[6];
+        lookup(Imath::V3f(16.0f, 12.5f, 12.5f), TextureOpt::InterpBilinear,
+               result, dresult);
+        for (int c = 0; c < 2; ++c)
+            OIIO_CHECK_EQUAL_THRESH(result[c],
+                                    0.5f * volume_value(15, 12, 12, c)
+                                        + 0.5f * background[c],
+                                    1.0e-4f);
+    }
+
+    // The background tiles looked up were stored as constant tiles: the one
+    // holding the first point and the eight around (24,16,8). The lookup
+    // straddling the detail reads (16,8,8), which is one of those eight.
+    long long ntiles = 0;
+    OIIO_CHECK_ASSERT(
+        imagecache->getattribute("stat:constant_tiles", TypeInt64, &ntiles));
+    OIIO_CHECK_EQUAL(ntiles, 9);
+}
+
+
+
 void
 test_custom_threadinfo()
 {
@@ -269,6 +436,150 @@ test_tileptr()
 
 
 
+// Test that tiles whose pixels are all the same are stored as one pixel,
+// and still read back as full tiles.
+void
+test_constant_tiles()
+{
+    Strutil::print("\nTesting constant tiles\n");
+    auto imagecache = ImageCache::create(false /*not shared*/);
+    ustring name(
+        "uniform.null?RES=64x48&TILE=16x16&CHANNELS=3&PIXEL=0.25,0.5,1");
+    const float value[3]       = { 0.25f, 0.5f, 1.0f };
+    const int tilepixels       = 16 * 16;
+    const long long pixelbytes = sizeof(value);
+    const long long tilebytes  = tilepixels * pixelbytes;
+
+    auto constant_stats = [&](long long& ntiles, long long& saved) {
+        OIIO_CHECK_ASSERT(imagecache->getattribute("stat:constant_tiles",
+                                                   TypeInt64, &ntiles));
+        OIIO_CHECK_ASSERT(
+            imagecache->getattribute("stat:constant_tile_bytes_saved",
+                                     TypeInt64, &saved));
+    };
+    // Each constant tile keeps one pixel, padded by at most a SIMD register
+    auto check_saved = [&](long long ntiles, long long saved) {
+        OIIO_CHECK_LE(saved, ntiles * tilebytes);
+        OIIO_CHECK_GE(saved, ntiles * (tilebytes - pixelbytes - 64));
+    };
+
+    // The full tile is still handed out through tile_pixels()
+    ImageCache::Tile* tile = imagecache->get_tile(name, 0, 0, 16, 16, 0);
+    OIIO_CHECK_ASSERT(tile != nullptr);
+    long long ntiles = 0, saved = 0;
+    constant_stats(ntiles, saved);
+    OIIO_CHECK_EQUAL(ntiles, 1);
+    check_saved(ntiles, saved);
+    TypeDesc format;
+    const float* pels = (const float*)imagecache->tile_pixels(tile, format);
+    OIIO_CHECK_ASSERT(pels != nullptr);
+    OIIO_CHECK_EQUAL(format, TypeFloat);
+    int mismatches = 0;
+    for (int p = 0; p < tilepixels; ++p)
+        for (int c = 0; c < 3; ++c)
+            mismatches += (pels[3 * p + c] != value[c]);
+    OIIO_CHECK_EQUAL(mismatches, 0);
+    imagecache->release_tile(tile);
+
+    // get_pixels of a region spanning tiles x 0-16 and y 0-32 reads five
+    // more constant tiles and sees every pixel of them.
+    const int xbegin = 5, xend = 29, ybegin = 3, yend = 41;
+    std::vector<float> pixels((xend - xbegin) * (yend - ybegin) * 3, -1.0f);
+    OIIO_CHECK_ASSERT(imagecache->get_pixels(name, 0, 0, xbegin, xend, ybegin,
+                                             yend, 0, 1, 0, 3, TypeFloat,
+                                             pixels.data()));
+    mismatches = 0;
+    for (size_t i = 0; i < pixels.size(); ++i)
+        mismatches += (pixels[i] != value[i % 3]);
+    OIIO_CHECK_EQUAL(mismatches, 0);
+    constant_stats(ntiles, saved);
+    OIIO_CHECK_EQUAL(ntiles, 6);
+    check_saved(ntiles, saved);
+}
+
+
+
+// Test 2D texture lookups whose filter footprint lies in constant tiles,
+// and next to one tile that has detail.
+void
+test_texture_constant_tiles()
+{
+    Strutil::print("\nTesting texture of constant tiles\n");
+    auto imagecache = ImageCache::create(false /*not shared*/);
+    auto texsys     = TextureSystem::create(false, imagecache);
+
+    ustring name("flat.null?RES=64x64&TILE=16x16&CHANNELS=2&PIXEL=0.25,0.5");
+    const int res = 64, tilesize = 16;
+    const float background[2] = { 0.25f, 0.5f };
+    {
+        std::vector<float> pixels;
+        for (int j = 0; j < tilesize; ++j)
+            for (int i = 0; i < tilesize; ++i)
+                for (int c = 0; c < 2; ++c)
+                    pixels.push_back(volume_value(32 + i, 32 + j, 0, c));
+        OIIO_CHECK_ASSERT(imagecache->add_tile(name, 0, 0, 32, 32, 0, 0, 2,
+                                               TypeFloat, pixels.data()));
+    }
+
+    // Look up at texel coordinates (x,y), with a footprint `width` texels
+    // wide in s and one texel high in t.
+    auto lookup = [&](float x, float y, float width,
+                      TextureOpt::InterpMode interp, float* result,
+                      float* dresult) {
+        TextureOpt opt;
+        opt.interpmode = interp;
+        OIIO_CHECK_ASSERT(texsys->texture(name, opt, x / res, y / res,
+                                          width / res, 0.0f, 0.0f, 1.0f / res,
+                                          2, result, dresult, dresult + 2));
+    };
+    auto interps = { TextureOpt::InterpClosest, TextureOpt::InterpBilinear,
+                     TextureOpt::InterpBicubic };
+
+    // An anisotropic footprint whose every tap lies in one constant tile
+    // returns the background, with no derivatives.
+    for (auto interp : interps) {
+        float result[2], dresult[4];
+        lookup(24.0f, 8.5f, 6.0f, interp, result, dresult);
+        for (int c = 0; c < 2; ++c)
+            OIIO_CHECK_EQUAL_THRESH(result[c], background[c], 1.0e-6f);
+        for (float d : dresult)
+            OIIO_CHECK_EQUAL(d, 0.0f);
+    }
+
+    // So does one straddling four constant tiles of the same value, though
+    // it is filtered as usual.
+    for (auto interp : interps) {
+        float result[2], dresult[4];
+        lookup(16.0f, 16.0f, 1.0f, interp, result, dresult);
+        for (int c = 0; c < 2; ++c)
+            OIIO_CHECK_EQUAL_THRESH(result[c], background[c], 1.0e-6f);
+    }
+
+    // At a texel center inside the tile with detail
+    for (auto interp : interps) {
+        float result[2], dresult[4];
+        lookup(40.5f, 40.5f, 1.0f, interp, result, dresult);
+        for (int c = 0; c < 2; ++c)
+            OIIO_CHECK_EQUAL_THRESH(result[c], volume_value(40, 40, 0, c),
+                                    1.0e-4f);
+    }
+
+    // A bilinear lookup halfway between texel (31,40) of the background
+    // and texel (32,40) of the tile with detail must still interpolate.
+    {
+        float result[2], dresult[4];
+        lookup(32.0f, 40.5f, 1.0f, TextureOpt::InterpBilinear, result,
+               dresult);
+        for (int c = 0; c < 2; ++c)
+            OIIO_CHECK_EQUAL_THRESH(result[c],
+                                    0.5f * volume_value(32, 40, 0, c)
+                                        + 0.5f * background[c],
+                                    1.0e-4f);
+    }
+}
+
+
+
 static void
 test_imagespec()
 {
@@ -381,7 +692,11 @@ main(int /*argc*/, char* /*argv*/[])
     test_get_pixels_cachechannels(6, 9, 6, 9);
 
     test_app_buffer();
+    test_texture3d_layers();
+    test_texture3d_sparse();
     test_tileptr();
+    test_constant_tiles();
+    test_texture_constant_tiles();
     test_get_pixels_errors();
     test_custom_threadinfo();
     test_imagespec();
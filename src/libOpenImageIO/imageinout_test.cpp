@@ -20,6 +20,8 @@
 #include <OpenImageIO/imageio.h>
 #include <OpenImageIO/unittest.h>
 
+#include <zlib.h>
+
 using namespace OIIO;
 
 
@@ -562,6 +564,540 @@ test_read_tricky_sizes()
 
 
 
+// Test read_image_async and write_image_async, including cancellation and
+// the completion callback.
+void
+test_async_read_write()
+{
+    print("Testing async read/write\n");
+    const char* filename = "tmp_async.exr";
+    ImageSpec spec(64, 48, 3, TypeFloat);
+    ImageBuf src(spec);
+    ImageBufAlgo::fill(src, { 0.25f, 0.5f, 1.0f });
+    auto srcspan = src.localpixels_as_byte_image_span();
+
+    {
+        auto out = ImageOutput::create(filename);
+        OIIO_ASSERT(out && out->open(filename, spec));
+        std::atomic<int> ncompleted(0);
+        auto f = out->write_image_async(TypeFloat, srcspan, nullptr,
+                                        [&](bool ok) { ncompleted += ok; });
+        OIIO_CHECK_ASSERT(f.get());
+        OIIO_CHECK_EQUAL(ncompleted.load(), 1);
+        OIIO_CHECK_ASSERT(out->close());
+    }
+
+    auto in = ImageInput::open(filename);
+    OIIO_ASSERT(in);
+    ImageBuf dst(spec);
+    auto dstspan = dst.localpixels_as_writable_byte_image_span();
+    {
+        auto f = in->read_image_async(0, 0, 0, 3, TypeFloat, dstspan);
+        OIIO_CHECK_ASSERT(f.get());
+        auto comp = ImageBufAlgo::compare(src, dst, 0.0f, 0.0f);
+        OIIO_CHECK_EQUAL(comp.nfail, 0);
+    }
+    {
+        // Already cancelled: must fail with an error that the calling
+        // thread can retrieve.
+        std::atomic<bool> cancel(true);
+        bool completed_ok = true;
+        auto f = in->read_image_async(0, 0, 0, 3, TypeFloat, dstspan, &cancel,
+                                      [&](bool ok) { completed_ok = ok; });
+        OIIO_CHECK_ASSERT(!f.get());
+        OIIO_CHECK_ASSERT(!completed_ok);
+        OIIO_CHECK_ASSERT(in->has_error());
+        OIIO_CHECK_ASSERT(Strutil::contains(in->geterror(), "cancelled"));
+        OIIO_CHECK_ASSERT(!in->has_error());
+    }
+    {
+        // A cancellation flag that is never set doesn't hurt.
+        std::atomic<bool> cancel(false);
+        ImageBufAlgo::zero(dst);
+        auto f = in->read_image_async(0, 0, 0, 3, TypeFloat, dstspan, &cancel);
+        OIIO_CHECK_ASSERT(f.get());
+        auto comp = ImageBufAlgo::compare(src, dst, 0.0f, 0.0f);
+        OIIO_CHECK_EQUAL(comp.nfail, 0);
+    }
+    in.reset();
+    if (!nodelete)
+        Filesystem::remove(filename);
+}
+
+
+
+// Separate-planarconfig TIFF files decode channel subsets by reading only
+// the planes asked for. Compare that against extracting the channels from
+// a read of all of them, and make sure that contiguous files don't claim to
+// decode subsets natively.
+void
+test_tiff_channel_subsets()
+{
+    print("Testing TIFF channel subset reads\n");
+    const char* filename = "tmp_planes.tif";
+    for (const char* planarconfig : { "separate", "contig" }) {
+        ImageSpec spec(53, 41, 4, TypeUInt16);
+        spec.attribute("planarconfig", planarconfig);
+        spec.attribute("tiff:RowsPerStrip", 8);
+        ImageBuf src(spec);
+        ImageBufAlgo::fill(src, { 0.0f, 0.25f, 0.5f, 1.0f },
+                           { 1.0f, 0.5f, 0.0f, 0.25f },
+                           { 0.5f, 0.0f, 1.0f, 0.75f },
+                           { 0.25f, 1.0f, 0.75f, 0.0f });
+        OIIO_CHECK_ASSERT(src.write(filename));
+
+        auto in = ImageInput::open(filename);
+        OIIO_ASSERT(in);
+        bool separate = !strcmp(planarconfig, "separate");
+        OIIO_CHECK_EQUAL(bool(in->supports("native_channel_subset")),
+                         separate);
+        const int nc = spec.nchannels, ybegin = 5, yend = 37;
+        std::vector<uint16_t> all(size_t(spec.width) * spec.height * nc);
+        OIIO_CHECK_ASSERT(in->read_native_scanlines(0, 0, 0, spec.height, 0,
+                                                    all.data()));
+        for (int chbegin = 0; chbegin < nc; ++chbegin) {
+            for (int chend = chbegin + 1; chend <= nc; ++chend) {
+                int nsub = chend - chbegin;
+                std::vector<uint16_t> sub(size_t(spec.width) * (yend - ybegin)
+                                          * nsub);
+                OIIO_CHECK_ASSERT(in->read_native_scanlines(0, 0, ybegin,
+                                                            yend, 0, chbegin,
+                                                            chend,
+                                                            sub.data()));
+                int nwrong = 0;
+                for (int y = ybegin, i = 0; y < yend; ++y)
+                    for (int x = 0; x < spec.width; ++x)
+                        for (int c = chbegin; c < chend; ++c, ++i)
+                            nwrong += sub[i]
+                                      != all[(size_t(y) * spec.width + x) * nc
+                                             + c];
+                OIIO_CHECK_EQUAL(nwrong, 0);
+            }
+        }
+    }
+    if (!nodelete)
+        Filesystem::remove(filename);
+}
+
+
+
+// A tiled "file" whose pixel values are a function of their position. It
+// can claim to support concurrent reads, and can be told to fail on one row
+// of tiles.
+class ProceduralTiledInput final : public ImageInput {
+public:
+    ProceduralTiledInput(bool concurrent, int failrow)
+        : m_concurrent(concurrent)
+        , m_failrow(failrow)
+    {
+    }
+    const char* format_name(void) const override { return "procedural"; }
+    int supports(string_view feature) const override
+    {
+        return feature == "concurrent_reads" && m_concurrent;
+    }
+    bool open(const std::string& /*name*/, ImageSpec& newspec) override
+    {
+        m_spec             = ImageSpec(330, 450, 3, TypeUInt16);
+        m_spec.tile_width  = 64;
+        m_spec.tile_height = 32;
+        newspec            = m_spec;
+        return true;
+    }
+    bool close() override { return true; }
+    bool read_native_scanline(int /*subimage*/, int /*miplevel*/, int /*y*/,
+                              int /*z*/, void* /*data*/) override
+    {
+        return false;
+    }
+    bool read_native_tile(int /*subimage*/, int /*miplevel*/, int x, int y,
+                          int /*z*/, void* data) override
+    {
+        if (y / m_spec.tile_height == m_failrow) {
+            errorfmt("tile row {} is unreadable", m_failrow);
+            return false;
+        }
+        uint16_t* p = (uint16_t*)data;
+        for (int j = 0; j < m_spec.tile_height; ++j)
+            for (int i = 0; i < m_spec.tile_width; ++i)
+                for (int c = 0; c < m_spec.nchannels; ++c)
+                    *p++ = value(x + i, y + j, c);
+        return true;
+    }
+    static uint16_t value(int x, int y, int c)
+    {
+        return uint16_t(x * 37 + y * 101 + c * 1009);
+    }
+
+private:
+    bool m_concurrent;
+    int m_failrow;
+};
+
+
+
+// The converting read_tiles path decodes rows of tiles ahead on the thread
+// pool. Make sure that gives the same pixels as reading serially, and that
+// an error partway through fails the read and is reported to the caller.
+void
+test_pipelined_read()
+{
+    print("Testing pipelined tile reads\n");
+    int oldthreads = 0;
+    OIIO::getattribute("threads", oldthreads);
+    // Make sure there's a pool to pipeline with, even on a single core.
+    OIIO::attribute("threads", 4);
+    for (bool concurrent : { false, true }) {
+        for (int threads : { 1, 0 }) {
+            std::unique_ptr<ImageInput> in(
+                new ProceduralTiledInput(concurrent, -1));
+            ImageSpec spec;
+            OIIO_ASSERT(in->open("procedural", spec));
+            in->threads(threads);
+            std::vector<float> pixels(spec.image_pixels() * spec.nchannels);
+            OIIO_CHECK_ASSERT(in->read_tiles(0, 0, spec.x,
+                                             spec.x + spec.width, spec.y,
+                                             spec.y + spec.height, 0, 1, 0,
+                                             spec.nchannels, TypeFloat,
+                                             pixels.data()));
+            int nwrong = 0;
+            for (int y = 0, i = 0; y < spec.height; ++y)
+                for (int x = 0; x < spec.width; ++x)
+                    for (int c = 0; c < spec.nchannels; ++c, ++i)
+                        nwrong += fabsf(pixels[i]
+                                        - ProceduralTiledInput::value(x, y, c)
+                                              / 65535.0f)
+                                  > 1.0e-6f;
+            OIIO_CHECK_EQUAL(nwrong, 0);
+
+            // Fail on a row of tiles in the middle of the image.
+            in.reset(new ProceduralTiledInput(concurrent, 7));
+            OIIO_ASSERT(in->open("procedural", spec));
+            in->threads(threads);
+            OIIO_CHECK_ASSERT(!in->read_tiles(0, 0, spec.x,
+                                              spec.x + spec.width, spec.y,
+                                              spec.y + spec.height, 0, 1, 0,
+                                              spec.nchannels, TypeFloat,
+                                              pixels.data()));
+            OIIO_CHECK_ASSERT(in->has_error());
+            OIIO_CHECK_ASSERT(
+                Strutil::contains(in->geterror(), "tile row 7 is unreadable"));
+            OIIO_CHECK_ASSERT(!in->has_error());
+        }
+    }
+    OIIO::attribute("threads", oldthreads);
+}
+
+
+
+// Write one scanline part (a line at a time, so that chunks are completed
+// piecemeal) and/or one tiled part to an OpenEXR file, and read them back.
+static void
+test_exr_write_parts(const char* filename, bool scanline, bool tiled)
+{
+    std::vector<ImageSpec> specs;
+    if (scanline) {
+        ImageSpec spec(61, 37, 4, TypeFloat);
+        spec.x = 3;
+        spec.y = -2;
+        spec.attribute("compression", "zip");
+        specs.push_back(spec);
+    }
+    if (tiled) {
+        ImageSpec spec(45, 29, 3, TypeHalf);
+        spec.tile_width  = 16;
+        spec.tile_height = 16;
+        spec.attribute("compression", "piz");
+        specs.push_back(spec);
+    }
+    // The pixels are handed to the writer as float, whatever the file's
+    // data format is.
+    std::vector<ImageBuf> bufs;
+    for (const auto& spec : specs) {
+        ImageSpec bufspec = spec;
+        bufspec.set_format(TypeFloat);
+        bufs.emplace_back(bufspec);
+        ImageBufAlgo::fill(bufs.back(), { 0.0f, 0.25f, 0.5f, 1.0f },
+                           { 1.0f, 0.5f, 0.0f, 0.25f },
+                           { 0.5f, 0.0f, 1.0f, 0.75f },
+                           { 0.25f, 1.0f, 0.75f, 0.0f });
+    }
+
+    auto out = ImageOutput::create(filename);
+    OIIO_ASSERT(out);
+    bool ok = specs.size() > 1
+                  ? out->open(filename, int(specs.size()), specs.data())
+                  : out->open(filename, specs[0]);
+    OIIO_CHECK_ASSERT(ok);
+    for (size_t p = 0; p < specs.size() && ok; ++p) {
+        const ImageSpec& spec(specs[p]);
+        if (p > 0)
+            ok &= out->open(filename, spec, ImageOutput::AppendSubimage);
+        if (spec.tile_width) {
+            ok &= out->write_tiles(spec.x, spec.x + spec.width, spec.y,
+                                   spec.y + spec.height, 0, 1, TypeFloat,
+                                   bufs[p].localpixels());
+        } else {
+            for (int y = spec.y; y < spec.y + spec.height; ++y)
+                ok &= out->write_scanline(y, 0, TypeFloat,
+                                          bufs[p].pixeladdr(spec.x, y));
+        }
+    }
+    ok &= out->close();
+    OIIO_CHECK_ASSERT(ok);
+    if (!ok)
+        print("  {}\n", out->geterror());
+    out.reset();
+
+    for (size_t p = 0; p < specs.size(); ++p) {
+        ImageBuf dst(filename, int(p));
+        OIIO_CHECK_ASSERT(dst.read(0, 0, true, TypeFloat));
+        OIIO_CHECK_ASSERT(dst.roi() == specs[p].roi());
+        OIIO_CHECK_EQUAL(dst.spec().tile_width, specs[p].tile_width);
+        auto comp = ImageBufAlgo::compare(bufs[p], dst, 1.0e-3f, 1.0e-3f);
+        OIIO_CHECK_EQUAL(comp.nfail, 0);
+    }
+    if (!nodelete)
+        Filesystem::remove(filename);
+}
+
+
+
+// Write a tiled, MIP-mapped OpenEXR file one level at a time, and read
+// every level back.
+static void
+test_exr_write_mipmap(const char* filename)
+{
+    ImageSpec spec(64, 64, 3, TypeHalf);
+    spec.tile_width  = 16;
+    spec.tile_height = 16;
+    spec.attribute("textureformat", "Plain Texture");
+    spec.attribute("compression", "zip");
+    std::vector<ImageBuf> levels;
+    for (int res = spec.width; res >= 1; res /= 2) {
+        ImageSpec levelspec = spec;
+        levelspec.width = levelspec.height = res;
+        levelspec.full_width = levelspec.full_height = res;
+        levelspec.set_format(TypeFloat);
+        levels.emplace_back(levelspec);
+        ImageBufAlgo::fill(levels.back(), { 0.0f, 0.25f, 0.5f },
+                           { 1.0f, 0.5f, 0.0f }, { 0.5f, 0.0f, 1.0f },
+                           { 0.25f, 1.0f, 0.75f });
+    }
+
+    auto out = ImageOutput::create(filename);
+    OIIO_ASSERT(out);
+    bool ok = true;
+    for (size_t m = 0; m < levels.size() && ok; ++m) {
+        ImageSpec levelspec = levels[m].spec();
+        levelspec.set_format(spec.format);
+        ok &= m ? out->open(filename, levelspec, ImageOutput::AppendMIPLevel)
+                : out->open(filename, levelspec);
+        ok &= out->write_tiles(0, levelspec.width, 0, levelspec.height, 0, 1,
+                               TypeFloat, levels[m].localpixels());
+    }
+    ok &= out->close();
+    OIIO_CHECK_ASSERT(ok);
+    if (!ok)
+        print("  {}\n", out->geterror());
+    out.reset();
+
+    auto in = ImageInput::open(filename);
+    OIIO_ASSERT(in);
+    int nlevels = 0;
+    while (in->seek_subimage(0, nlevels))
+        ++nlevels;
+    OIIO_CHECK_EQUAL(nlevels, int(levels.size()));
+    in.reset();
+    for (int m = 0; m < int(levels.size()); ++m) {
+        ImageBuf dst(filename, 0, m);
+        OIIO_CHECK_ASSERT(dst.read(0, m, true, TypeFloat));
+        OIIO_CHECK_ASSERT(dst.roi() == levels[m].roi());
+        auto comp = ImageBufAlgo::compare(levels[m], dst, 1.0e-3f, 1.0e-3f);
+        OIIO_CHECK_EQUAL(comp.nfail, 0);
+    }
+    if (!nodelete)
+        Filesystem::remove(filename);
+}
+
+
+
+// Write scanline, tiled, MIP-mapped, and multipart OpenEXR files with both
+// the C++ library and the OpenEXRCore writers.
+void
+test_exr_write()
+{
+    print("Testing OpenEXR write/read\n");
+    int oldcore = 0;
+    OIIO::getattribute("openexr:core", oldcore);
+    for (int core : { 0, 1 }) {
+        OIIO::attribute("openexr:core", core);
+        test_exr_write_parts("tmp_scanline.exr", true, false);
+        test_exr_write_parts("tmp_tiled.exr", false, true);
+        test_exr_write_parts("tmp_multipart.exr", true, true);
+        test_exr_write_mipmap("tmp_mipmap.exr");
+    }
+    OIIO::attribute("openexr:core", oldcore);
+}
+
+
+
+// Write 10-bit DPX files and read them back, making sure the channels come
+// back in order (not swapped by a disagreement about datum order).
+void
+test_dpx_10bit_roundtrip()
+{
+    print("Testing 10-bit DPX write/read\n");
+    if (!ImageOutput::create("dpx")) {
+        (void)OIIO::geterror();  // discard error
+        return;
+    }
+    const char* filename = "tmp_10bit.dpx";
+    for (int nchannels : { 3, 4 }) {
+        for (const char* packing : { "Filled, method A", "Filled, method B" }) {
+            ImageSpec spec(37, 19, nchannels, TypeUInt16);
+            spec.attribute("oiio:BitsPerSample", 10);
+            spec.attribute("dpx:Packing", packing);
+            ImageBuf src(spec);
+            ImageBufAlgo::fill(src, { 0.0f, 0.25f, 0.5f, 1.0f },
+                               { 1.0f, 0.5f, 0.0f, 0.25f },
+                               { 0.5f, 0.0f, 1.0f, 0.75f },
+                               { 0.25f, 1.0f, 0.75f, 0.0f });
+            OIIO_CHECK_ASSERT(src.write(filename));
+            ImageBuf dst(filename);
+            OIIO_CHECK_ASSERT(dst.read(0, 0, true, TypeUInt16));
+            OIIO_CHECK_EQUAL(dst.nchannels(), nchannels);
+            auto comp = ImageBufAlgo::compare(src, dst, 1.0f / 1023.0f,
+                                              1.0f / 1023.0f);
+            OIIO_CHECK_EQUAL(comp.nfail, 0);
+        }
+    }
+    if (!nodelete)
+        Filesystem::remove(filename);
+}
+
+
+
+// Write the RGB pixels of buf (8 or 16 bits per channel) as an Adam7
+// interlaced PNG, which ImageOutput never writes, with every row
+// unfiltered and the whole image in one IDAT chunk.
+static bool
+write_interlaced_png(string_view filename, const ImageBuf& buf)
+{
+    const ImageSpec& spec(buf.spec());
+    const int w = spec.width, h = spec.height, nc = spec.nchannels;
+    const int bytes = spec.format == TypeUInt16 ? 2 : 1;
+    std::vector<unsigned short> pixels(spec.image_pixels() * nc);
+    buf.get_pixels(buf.roi(), TypeUInt16, pixels.data());
+
+    static const int adam7[7][4] = { { 0, 0, 8, 8 }, { 4, 0, 8, 8 },
+                                     { 0, 4, 4, 8 }, { 2, 0, 4, 4 },
+                                     { 0, 2, 2, 4 }, { 1, 0, 2, 2 },
+                                     { 0, 1, 1, 2 } };
+    std::vector<unsigned char> raw;
+    for (auto& pass : adam7) {
+        if (pass[0] >= w)
+            continue;  // empty pass has no rows at all
+        for (int y = pass[1]; y < h; y += pass[3]) {
+            raw.push_back(0);  // filter type NONE
+            for (int x = pass[0]; x < w; x += pass[2]) {
+                for (int c = 0; c < nc; ++c) {
+                    unsigned short v = pixels[(size_t(y) * w + x) * nc + c];
+                    if (bytes == 2)
+                        raw.push_back(v >> 8);
+                    raw.push_back(bytes == 2 ? v & 0xff : (v + 128) / 257);
+                }
+            }
+        }
+    }
+    std::vector<unsigned char> idat(compressBound(raw.size()));
+    uLongf idat_size = idat.size();
+    if (compress(idat.data(), &idat_size, raw.data(), raw.size()) != Z_OK)
+        return false;
+    idat.resize(idat_size);
+
+    std::vector<unsigned char> file = { 0x89, 'P',  'N',  'G',
+                                        '\r',  '\n', 0x1a, '\n' };
+    auto put32 = [&](uint32_t v) {
+        for (int shift = 24; shift >= 0; shift -= 8)
+            file.push_back((v >> shift) & 0xff);
+    };
+    auto chunk = [&](const char* type, cspan<unsigned char> data) {
+        put32(uint32_t(data.size()));
+        size_t start = file.size();
+        file.insert(file.end(), type, type + 4);
+        file.insert(file.end(), data.begin(), data.end());
+        put32(crc32(0, file.data() + start, uInt(file.size() - start)));
+    };
+    unsigned char ihdr[13] = { 0, 0, 0, 0, 0, 0, 0, 0,
+                               (unsigned char)(bytes * 8),
+                               (unsigned char)(nc == 3 ? 2 : 6),  // RGB(A)
+                               0, 0, 1 /* Adam7 */ };
+    for (int i = 0; i < 4; ++i) {
+        ihdr[i]     = (w >> (24 - 8 * i)) & 0xff;
+        ihdr[4 + i] = (h >> (24 - 8 * i)) & 0xff;
+    }
+    chunk("IHDR", ihdr);
+    chunk("IDAT", idat);
+    chunk("IEND", {});
+    return Filesystem::write_binary_file(filename, file);
+}
+
+
+
+// Write PNG files big enough to be compressed in parallel, with and without
+// "png:multithread", plus interlaced files (which always go through
+// libpng), and make sure every one of them reads back bit for bit, with
+// and without "png:multithread".
+void
+test_png_multithread_roundtrip()
+{
+    print("Testing PNG write/read with and without png:multithread\n");
+    if (!ImageOutput::create("png")) {
+        (void)OIIO::geterror();  // discard error
+        return;
+    }
+    int oldmultithread = 1;
+    OIIO::getattribute("png:multithread", oldmultithread);
+    for (TypeDesc type : { TypeUInt8, TypeUInt16 }) {
+        // 640x480 RGB is 900KB at 8 bits, well over the 256KB needed to
+        // write in parallel.
+        ImageBuf src(ImageSpec(640, 480, 3, type));
+        ImageBufAlgo::fill(src, { 0.0f, 0.25f, 0.5f }, { 1.0f, 0.5f, 0.0f },
+                           { 0.5f, 0.0f, 1.0f }, { 0.25f, 1.0f, 0.75f });
+        ImageBufAlgo::noise(src, "uniform", -0.1f, 0.1f);
+        std::vector<std::string> filenames;
+        for (int mt : { 0, 1 }) {
+            std::string filename = Strutil::fmt::format("tmp_png_{}_mt{}.png",
+                                                        type.c_str(), mt);
+            OIIO::attribute("png:multithread", mt);
+            OIIO_CHECK_ASSERT(src.write(filename));
+            filenames.push_back(filename);
+        }
+        std::string adam7 = Strutil::fmt::format("tmp_png_{}_adam7.png",
+                                                 type.c_str());
+        OIIO_CHECK_ASSERT(write_interlaced_png(adam7, src));
+        filenames.push_back(adam7);
+
+        for (const auto& filename : filenames) {
+            for (int mt : { 0, 1 }) {
+                OIIO::attribute("png:multithread", mt);
+                ImageBuf dst(filename);
+                OIIO_CHECK_ASSERT(dst.read(0, 0, true, type));
+                OIIO_CHECK_EQUAL(dst.spec().format, type);
+                auto comp = ImageBufAlgo::compare(src, dst, 0.0f, 0.0f);
+                OIIO_CHECK_EQUAL(comp.nfail, 0);
+                OIIO_CHECK_EQUAL(comp.maxerror, 0.0);
+            }
+            if (!nodelete)
+                Filesystem::remove(filename);
+        }
+    }
+    OIIO::attribute("png:multithread", oldmultithread);
+}
+
+
+
 void
 benchmark_tile_sizes(string_view extension, TypeDesc datatype,
                      int tilestart = 4)
@@ -655,6 +1191,12 @@ main(int argc, char* argv[])
 
     test_all_formats();
     test_read_tricky_sizes();
+    test_async_read_write();
+    test_dpx_10bit_roundtrip();
+    test_png_multithread_roundtrip();
+    test_tiff_channel_subsets();
+    test_exr_write();
+    test_pipelined_read();
     benchmark_tile_sizes("exr", TypeHalf, 4);
     benchmark_tile_sizes("tif", TypeUInt16, 16);
 
@@ -6,6 +6,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <tsl/robin_map.h>
@@ -14,6 +15,7 @@
 #include <OpenImageIO/deepdata.h>
 #include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/fmath.h>
+#include <OpenImageIO/function_view.h>
 #include <OpenImageIO/imageio.h>
 #include <OpenImageIO/parallel.h>
 #include <OpenImageIO/strutil.h>
@@ -45,6 +47,11 @@ public:
     uint64_t m_id;
     int m_threads = 0;
 
+    // Errors from read_image_async(), which happen on an I/O thread and
+    // so can't go in the calling thread's input_error_messages.
+    std::mutex m_async_mutex;
+    std::string m_async_error;
+
     // The IOProxy object we will use for all I/O operations.
     Filesystem::IOProxy* m_io = nullptr;
     // The "local" proxy that we will create to use if the user didn't
@@ -346,6 +353,101 @@ ImageInput::read_scanlines(int subimage, int miplevel, int ybegin, int yend,
 
 
 
+// Maximum number of chunks that the pipelined read paths will decode at
+// once for plugins that support "concurrent_reads".
+static const int max_concurrent_decoders = 3;
+
+
+// How many chunks the pipelined read paths should decode ahead on the
+// default thread pool for ImageInput `in`, or 0 to decode and convert
+// serially. This honors the input's "threads" setting as well as the size
+// of the pool (which the global "threads" attribute controls), and stays
+// serial when called from a pool thread, which must not block waiting on
+// other pool tasks.
+static int
+pipeline_decoders(const ImageInput* in)
+{
+    thread_pool* pool = default_thread_pool();
+    int nthreads      = in->threads();
+    if (nthreads <= 0)
+        nthreads = OIIO::pvt::oiio_threads;
+    int ndecoders = std::min(nthreads - 1, pool->size());
+    if (ndecoders < 1 || pool->is_worker())
+        return 0;
+    return in->supports("concurrent_reads")
+               ? std::min(ndecoders, max_concurrent_decoders)
+               : 1;
+}
+
+
+// Read an image in `nchunks` pieces, overlapping the decoding of upcoming
+// chunks with the conversion of the current one. `decode(i, buf)` reads
+// chunk i into a scratch buffer of `bufsize` bytes; it runs as a task on
+// the default thread pool, with up to `ndecoders` of them at once (so it
+// must only be >1 for plugins whose read_native_* may run concurrently).
+// `convert(i, buf)` is called on the calling thread for each chunk, in
+// order. Decoding never runs more than `ndecoders` chunks ahead of
+// conversion, and no new chunks are started after a failure. With
+// `ndecoders` == 0, or a single chunk, everything happens serially on the
+// calling thread.
+static bool
+read_pipelined(ImageInput* in, int nchunks, size_t bufsize, int ndecoders,
+               function_view<bool(int, std::byte*)> decode,
+               function_view<bool(int, std::byte*)> convert)
+{
+    if (ndecoders < 1 || nchunks < 2) {
+        std::unique_ptr<std::byte[]> buf(new std::byte[bufsize]);
+        bool ok = true;
+        for (int i = 0; ok && i < nchunks; ++i)
+            ok = decode(i, buf.get()) && convert(i, buf.get());
+        return ok;
+    }
+
+    ndecoders = std::min(ndecoders, nchunks - 1);
+    int nbufs = ndecoders + 1;
+    std::vector<std::unique_ptr<std::byte[]>> bufs(nbufs);
+    for (auto& b : bufs)
+        b.reset(new std::byte[bufsize]);
+
+    // Chunk i is decoded into bufs[i % nbufs] by task i of `tasks`. Chunk
+    // i+ndecoders is only started once chunk i is decoded, by which time
+    // chunk i-1, the previous user of its buffer, has been converted.
+    thread_pool* pool = default_thread_pool();
+    task_set tasks(pool);
+    std::vector<char> decoded(nchunks, 0);
+    std::vector<std::string> errors(nchunks);
+    int nstarted = 0;
+    auto start   = [&]() {
+        int i = nstarted++;
+        tasks.push(pool->push([&, i](int /*id*/) {
+            decoded[i] = decode(i, bufs[i % nbufs].get());
+            // Errors are stored per thread, so collect them here to be
+            // re-posted on the calling thread.
+            if (in->has_error())
+                errors[i] = in->geterror();
+        }));
+    };
+    while (nstarted < ndecoders)
+        start();
+
+    bool ok = true;
+    for (int i = 0; ok && i < nchunks; ++i) {
+        tasks.wait_for_task(size_t(i));
+        ok = decoded[i];
+        if (ok && nstarted < nchunks)
+            start();
+        if (ok)
+            ok = convert(i, bufs[i % nbufs].get());
+    }
+    tasks.wait();
+    for (const auto& e : errors)
+        if (e.size())
+            in->errorfmt("{}", e);
+    return ok;
+}
+
+
+
 bool
 ImageInput::read_scanlines(int subimage, int miplevel, int ybegin, int yend,
                            int z, int chbegin, int chend, TypeDesc format,
@@ -410,37 +512,40 @@ ImageInput::read_scanlines(int subimage, int miplevel, int ybegin, int yend,
                                          chbegin, chend, dataspan);
     }
 
-    // No such luck.  Read scanlines in chunks.
+    // No such luck.  Read scanlines in chunks, decoding the next chunks
+    // while the current one is converted into the caller's buffer.
 
-    // Split into reasonable chunks -- try to use around 64 MB, but
-    // round up to a multiple of the TIFF rows per strip (or 64).
-    int chunk = std::max(1, (1 << 26) / int(spec.scanline_bytes(true)));
+    // Split into reasonable chunks -- try to use around 16 MB, so that
+    // there are several chunks to overlap, but round up to a multiple of
+    // the TIFF rows per strip (or 64).
+    int chunk = std::max(1, (1 << 24) / int(spec.scanline_bytes(true)));
     chunk     = std::max(chunk, int(oiio_read_chunk));
     chunk     = round_to_multiple(chunk, rps);
-    std::unique_ptr<std::byte[]> buf(
-        new std::byte[chunk * native_scanline_bytes]);
-    auto bufspan = make_span(buf.get(), chunk * native_scanline_bytes);
+    int nchunks        = (yend - ybegin + chunk - 1) / chunk;
+    size_t chunk_bytes = chunk * native_scanline_bytes;
 
-    bool ok             = true;
     int scanline_values = spec.width * nchans;
-    for (; ok && ybegin < yend; ybegin += chunk) {
-        int y1 = std::min(ybegin + chunk, yend);
-        ok &= read_native_scanlines(subimage, miplevel, ybegin, y1, chbegin,
-                                    chend, bufspan);
-        if (!ok)
-            break;
-
-        int nscanlines  = y1 - ybegin;
+    auto decode         = [&](int i, std::byte* buf) {
+        int y0 = ybegin + i * chunk;
+        int y1 = std::min(y0 + chunk, yend);
+        return read_native_scanlines(subimage, miplevel, y0, y1, chbegin,
+                                     chend, make_span(buf, chunk_bytes));
+    };
+    auto convert = [&](int i, std::byte* buf) {
+        int y0          = ybegin + i * chunk;
+        int nscanlines  = std::min(y0 + chunk, yend) - y0;
         int chunkvalues = scanline_values * nscanlines;
+        char* dst       = (char*)data + ystride * (y0 - ybegin);
+        bool ok         = true;
         if (spec.channelformats.empty()) {
             // No per-channel formats -- do the conversion in one shot
             if (contiguous) {
-                ok = convert_pixel_values(spec.format, buf.get(), format, data,
+                ok = convert_pixel_values(spec.format, buf, format, dst,
                                           chunkvalues);
             } else {
                 ok = parallel_convert_image(nchans, spec.width, nscanlines, 1,
-                                            buf.get(), spec.format, AutoStride,
-                                            AutoStride, AutoStride, data,
+                                            buf, spec.format, AutoStride,
+                                            AutoStride, AutoStride, dst,
                                             format, xstride, ystride, zstride,
                                             threads());
             }
@@ -460,8 +565,8 @@ ImageInput::read_scanlines(int subimage, int miplevel, int ybegin, int yend,
                                             nscanlines, 1, &buf[offset],
                                             chanformat, native_pixel_bytes,
                                             AutoStride, AutoStride,
-                                            (char*)data + c * format.size(),
-                                            format, xstride, ystride, zstride,
+                                            dst + c * format.size(), format,
+                                            xstride, ystride, zstride,
                                             threads());
                 offset += n * chanformat.size();
             }
@@ -469,9 +574,10 @@ ImageInput::read_scanlines(int subimage, int miplevel, int ybegin, int yend,
         if (!ok)
             errorfmt("ImageInput::read_scanlines : no support for format {}",
                      spec.format);
-        data = (char*)data + ystride * nscanlines;
-    }
-    return ok;
+        return ok;
+    };
+    return read_pipelined(this, nchunks, chunk_bytes, pipeline_decoders(this),
+                          decode, convert);
 }
 
 
@@ -756,7 +862,6 @@ ImageInput::read_tiles(int subimage, int miplevel, int xbegin, int xend,
     }
 
     // No such luck.  Just punt and read tiles individually.
-    bool ok                        = true;
     stride_t pixelsize             = native_data ? native_pixel_bytes
                                                  : (format.size() * nchans);
     stride_t native_pixelsize      = spec.pixel_bytes(true);
@@ -769,93 +874,150 @@ ImageInput::read_tiles(int subimage, int miplevel, int xbegin, int xend,
     size_t prefix_bytes = native_data ? spec.pixel_bytes(0, chbegin, true)
                                       : format.size() * chbegin;
     bool allchans       = (chbegin == 0 && chend == spec.nchannels);
-    std::vector<char> buf;
-    for (int z = zbegin; z < zend; z += std::max(1, spec.tile_depth)) {
-        int zd      = std::min(zend - z, spec.tile_depth);
-        bool full_z = (zd == spec.tile_depth);
-        for (int y = ybegin; ok && y < yend; y += spec.tile_height) {
-            char* tilestart = ((char*)data + (z - zbegin) * zstride
-                               + (y - ybegin) * ystride);
-            int yh          = std::min(yend - y, spec.tile_height);
-            bool full_y     = (yh == spec.tile_height);
-            int x           = xbegin;
-            // If we're reading full y and z tiles and not doing any funny
-            // business with channels, try to read as many complete x tiles
-            // as we can in this row.
-            int x_full_tiles = (xend - xbegin) / spec.tile_width;
-            if (full_z && full_y && allchans && !perchanfile
-                && x_full_tiles >= 1) {
-                int x_full_tile_end = xbegin + x_full_tiles * spec.tile_width;
-                if (buf.size() < size_t(full_native_tilebytes * x_full_tiles))
-                    buf.resize(full_native_tilebytes * x_full_tiles);
-                ok &= read_native_tiles(subimage, miplevel, xbegin,
-                                        x_full_tile_end, y, y + yh, z, z + zd,
-                                        chbegin, chend, &buf[0]);
-                if (ok)
-                    convert_image(nchans, x_full_tiles * spec.tile_width, yh,
-                                  zd, &buf[0], spec.format, native_pixelsize,
-                                  native_pixelsize * x_full_tiles
-                                      * spec.tile_width,
-                                  native_pixelsize * x_full_tiles
-                                      * spec.tile_width * spec.tile_height,
-                                  tilestart, format, xstride, ystride, zstride);
-                tilestart += x_full_tiles * spec.tile_width * xstride;
-                x += x_full_tiles * spec.tile_width;
-            }
 
-            // Now get the rest in the row, anything that is only a
-            // partial tile, which needs extra care.
-            // Since we are here relying on the non-thread-safe read_tile()
-            // call, we re-establish the lock and make sure we're on the
-            // right subimage/miplevel.
-            for (; ok && x < xend; x += spec.tile_width) {
-                int xw      = std::min(xend - x, spec.tile_width);
-                bool full_x = (xw == spec.tile_width);
-                // Full tiles are read directly into the user buffer,
-                // but partial tiles (such as at the image edge) or
-                // partial channel subsets are read into a buffer and
-                // then copied.
-                if (full_x && full_y && full_z && allchans && !perchanfile) {
-                    // Full tile, either native data or not needing
-                    // per-tile data format conversion.
+    // Work a row of tiles at a time. If we're reading full y and z tiles
+    // and not doing any funny business with channels, the complete x tiles
+    // of each row are read at once with read_native_tiles, which is done
+    // for upcoming rows while the current one is converted.
+    int tile_depth   = std::max(1, spec.tile_depth);
+    int x_full_tiles = (xend - xbegin) / spec.tile_width;
+    int x_full_end   = xbegin + x_full_tiles * spec.tile_width;
+    bool rowread_ok  = allchans && !perchanfile && x_full_tiles >= 1;
+    auto row_is_full = [&](int y, int z) {
+        return rowread_ok && (yend - y) >= spec.tile_height
+               && (zend - z) >= tile_depth;
+    };
+    size_t row_bytes = full_native_tilebytes * std::max(1, x_full_tiles);
+
+    // Readers whose read_native_tiles calls may overlap get their partial
+    // and channel-subset tiles through read_native_tiles as well, which
+    // takes no lock, rather than through read_tile, which has to hold it.
+    // Those tiles arrive as just channels [chbegin,chend) in native
+    // format, and are converted here.
+    bool concurrent             = supports("concurrent_reads");
+    stride_t sub_tilewidthbytes = native_pixel_bytes * spec.tile_width;
+    stride_t sub_tilewhbytes    = sub_tilewidthbytes * spec.tile_height;
+    auto convert_native_tile = [&](const char* src, int xw, int yh, int zd,
+                                   char* dst) {
+        if (!perchanfile)
+            return convert_image(nchans, xw, yh, zd, src, spec.format,
+                                 native_pixel_bytes, sub_tilewidthbytes,
+                                 sub_tilewhbytes, dst,
+                                 native_data ? spec.format : format, xstride,
+                                 ystride, zstride);
+        // Per-channel formats -- have to convert/copy channels individually
+        bool ok       = true;
+        size_t offset = 0;
+        for (int c = chbegin; ok && c < chend; ++c) {
+            TypeDesc chanformat = spec.channelformat(c);
+            size_t dstoffset    = native_data ? offset
+                                              : (c - chbegin) * format.size();
+            ok = convert_image(1, xw, yh, zd, src + offset, chanformat,
+                               native_pixel_bytes, sub_tilewidthbytes,
+                               sub_tilewhbytes, dst + dstoffset,
+                               native_data ? chanformat : format, xstride,
+                               ystride, zstride);
+            offset += chanformat.size();
+        }
+        return ok;
+    };
+
+    std::vector<char> buf;  // for partial tiles
+    auto decode = [&](int i, std::byte* rowbuf) {
+        int z = zbegin + (i / nytiles) * tile_depth;
+        int y = ybegin + (i % nytiles) * spec.tile_height;
+        if (!row_is_full(y, z))
+            return true;
+        return read_native_tiles(subimage, miplevel, xbegin, x_full_end, y,
+                                 y + spec.tile_height, z, z + tile_depth,
+                                 chbegin, chend, rowbuf);
+    };
+    auto convert = [&](int i, std::byte* rowbuf) {
+        int z           = zbegin + (i / nytiles) * tile_depth;
+        int y           = ybegin + (i % nytiles) * spec.tile_height;
+        int zd          = std::min(zend - z, spec.tile_depth);
+        bool full_z     = (zd == spec.tile_depth);
+        char* tilestart = ((char*)data + (z - zbegin) * zstride
+                           + (y - ybegin) * ystride);
+        int yh          = std::min(yend - y, spec.tile_height);
+        bool full_y     = (yh == spec.tile_height);
+        int x           = xbegin;
+        bool ok         = true;
+        if (row_is_full(y, z)) {
+            convert_image(nchans, x_full_tiles * spec.tile_width, yh, zd,
+                          rowbuf, spec.format, native_pixelsize,
+                          native_pixelsize * x_full_tiles * spec.tile_width,
+                          native_pixelsize * x_full_tiles * spec.tile_width
+                              * spec.tile_height,
+                          tilestart, format, xstride, ystride, zstride);
+            tilestart += x_full_tiles * spec.tile_width * xstride;
+            x = x_full_end;
+        }
+
+        // Now get the rest in the row, anything that is only a
+        // partial tile, which needs extra care.
+        // Since we are here relying on the non-thread-safe read_tile()
+        // call, we re-establish the lock and make sure we're on the
+        // right subimage/miplevel.
+        for (; ok && x < xend; x += spec.tile_width) {
+            int xw      = std::min(xend - x, spec.tile_width);
+            bool full_x = (xw == spec.tile_width);
+            // Full tiles are read directly into the user buffer,
+            // but partial tiles (such as at the image edge) or
+            // partial channel subsets are read into a buffer and
+            // then copied.
+            if (concurrent) {
+                size_t tilebytes = size_t(sub_tilewhbytes) * tile_depth;
+                if (buf.size() < tilebytes)
+                    buf.resize(tilebytes);
+                ok &= read_native_tiles(subimage, miplevel, x,
+                                        x + spec.tile_width, y,
+                                        y + spec.tile_height, z, z + tile_depth,
+                                        chbegin, chend, buf.data());
+                if (ok)
+                    ok &= convert_native_tile(buf.data(), xw, yh, zd,
+                                              tilestart);
+                if (!ok)
+                    return false;
+            } else if (full_x && full_y && full_z && allchans
+                       && !perchanfile) {
+                // Full tile, either native data or not needing
+                // per-tile data format conversion.
+                lock_guard lock(*this);
+                if (!seek_subimage(subimage, miplevel))
+                    return false;
+                ok &= read_tile(x, y, z, format, tilestart, xstride, ystride,
+                                zstride);
+                if (!ok)
+                    return false;
+            } else {
+                if (buf.size() < size_t(full_tilebytes))
+                    buf.resize(full_tilebytes);
+                {
                     lock_guard lock(*this);
                     if (!seek_subimage(subimage, miplevel))
                         return false;
-                    ok &= read_tile(x, y, z, format, tilestart, xstride,
-                                    ystride, zstride);
-                    if (!ok)
-                        return false;
-                } else {
-                    if (buf.size() < size_t(full_tilebytes))
-                        buf.resize(full_tilebytes);
-                    {
-                        lock_guard lock(*this);
-                        if (!seek_subimage(subimage, miplevel))
-                            return false;
-                        ok &= read_tile(x, y, z, format, &buf[0],
-                                        full_pixelsize, full_tilewidthbytes,
-                                        full_tilewhbytes);
-                    }
-                    if (ok)
-                        copy_image(nchans, xw, yh, zd, &buf[prefix_bytes],
-                                   pixelsize, full_pixelsize,
-                                   full_tilewidthbytes, full_tilewhbytes,
-                                   tilestart, xstride, ystride, zstride);
-                    // N.B. It looks like read_tiles doesn't handle the
-                    // per-channel data types case fully, but it does!
-                    // The call to read_tile() above handles the case of
-                    // per-channel data types, converting to to desired
-                    // format, so all we have to do on our own is the
-                    // copy_image.
+                    ok &= read_tile(x, y, z, format, &buf[0], full_pixelsize,
+                                    full_tilewidthbytes, full_tilewhbytes);
                 }
-                tilestart += spec.tile_width * xstride;
+                if (ok)
+                    copy_image(nchans, xw, yh, zd, &buf[prefix_bytes],
+                               pixelsize, full_pixelsize, full_tilewidthbytes,
+                               full_tilewhbytes, tilestart, xstride, ystride,
+                               zstride);
+                // N.B. It looks like read_tiles doesn't handle the
+                // per-channel data types case fully, but it does!
+                // The call to read_tile() above handles the case of
+                // per-channel data types, converting to to desired
+                // format, so all we have to do on our own is the
+                // copy_image.
             }
-            if (!ok)
-                break;
+            tilestart += spec.tile_width * xstride;
         }
-    }
-
-    return ok;
+        return ok;
+    };
+    return read_pipelined(this, nztiles * nytiles, row_bytes,
+                          pipeline_decoders(this), decode, convert);
 }
 
 
@@ -1133,15 +1295,16 @@ ImageInput::read_image(int subimage, int miplevel, int chbegin, int chend,
         if (progress_callback(progress_callback_data, 0.0f))
             return ok;
     if (spec.tile_width) {  // Tiled image -- rely on read_tiles
-        // Read in chunks of a whole row of tiles at once. If tiles are
-        // 64x64, a 2k image has 32 tiles across. That's fine for now (for
-        // parallelization purposes), but as typical core counts increase,
-        // we may someday want to revisit this to batch multiple rows.
+        // Without a progress callback to service, hand a whole slab of
+        // tiles to read_tiles, which pipelines the decoding of rows of
+        // tiles with their conversion. Otherwise, read a row of tiles at a
+        // time so that progress can be reported between rows.
+        int ystep = progress_callback ? spec.tile_height : spec.height;
         for (int z = 0; z < spec.depth; z += spec.tile_depth) {
-            for (int y = 0; y < spec.height && ok; y += spec.tile_height) {
+            for (int y = 0; y < spec.height && ok; y += ystep) {
                 ok &= read_tiles(subimage, miplevel, spec.x,
                                  spec.x + spec.width, y + spec.y,
-                                 std::min(y + spec.y + spec.tile_height,
+                                 std::min(y + spec.y + ystep,
                                           spec.y + spec.height),
                                  z + spec.z,
                                  std::min(z + spec.z + spec.tile_depth,
@@ -1156,12 +1319,16 @@ ImageInput::read_image(int subimage, int miplevel, int chbegin, int chend,
             }
         }
     } else {  // Scanline image -- rely on read_scanlines.
-        // Split into reasonable chunks -- try to use around 64 MB or the
-        // oiio_read_chunk value, which ever is bigger, but also round up to
-        // a multiple of the TIFF rows per strip (or 64).
+        // With a progress callback, split into reasonable chunks -- try to
+        // use around 64 MB or the oiio_read_chunk value, which ever is
+        // bigger, but also round up to a multiple of the TIFF rows per
+        // strip (or 64). Without one, read_scanlines does its own
+        // (pipelined) chunking, so hand it the whole image.
         int chunk = std::max(1, (1 << 26) / int(spec.scanline_bytes(true)));
         chunk     = std::max(chunk, int(oiio_read_chunk));
         chunk     = round_to_multiple(chunk, rps);
+        if (!progress_callback)
+            chunk = spec.height;
         for (int z = 0; z < spec.depth; ++z) {
             for (int y = 0; y < spec.height && ok; y += chunk) {
                 int yend = std::min(y + spec.y + chunk, spec.y + spec.height);
@@ -1189,9 +1356,8 @@ ImageInput::read_image(int subimage, int miplevel, int chbegin, int chend,
 {
     OIIO::pvt::LoggedTimer logtime("II::read_image");
     ImageSpec spec;
-    int rps = 0;
     {
-        // We need to lock briefly to retrieve rps from the spec
+        // We need to lock briefly to retrieve the spec dimensions
         lock_guard lock(*this);
         if (!seek_subimage(subimage, miplevel))
             return false;
@@ -1199,9 +1365,6 @@ ImageInput::read_image(int subimage, int miplevel, int chbegin, int chend,
         // local `spec` means that we can release the lock!  (Calls to
         // read_native_* will internally lock again if necessary.)
         spec.copy_dimensions(m_spec);
-        // For scanline files, we also need one piece of metadata
-        if (!spec.tile_width)
-            rps = m_spec.get_int_attribute("tiff:RowsPerStrip", 64);
     }
     if (spec.image_bytes() < 1) {
         errorfmt("Invalid image size {} x {} ({} chans)", m_spec.width,
@@ -1221,46 +1384,88 @@ ImageInput::read_image(int subimage, int miplevel, int chbegin, int chend,
 
     bool ok = true;
     if (spec.tile_width) {  // Tiled image -- rely on read_tiles
-        // Read in chunks of a whole row of tiles at once. If tiles are
-        // 64x64, a 2k image has 32 tiles across. That's fine for now (for
-        // parallelization purposes), but as typical core counts increase,
-        // we may someday want to revisit this to batch multiple rows.
+        // Hand a whole slab of tiles to read_tiles, which pipelines the
+        // decoding of rows of tiles with their conversion.
         for (int z = 0; z < spec.depth; z += spec.tile_depth) {
             int zend = std::min(z + spec.z + spec.tile_depth,
                                 spec.z + spec.depth);
-            for (int y = 0; y < spec.height && ok; y += spec.tile_height) {
-                int yend = std::min(y + spec.y + spec.tile_height,
-                                    spec.y + spec.height);
-                ok &= read_tiles(subimage, miplevel, spec.x,
-                                 spec.x + spec.width, y + spec.y, yend,
-                                 z + spec.z, zend, chbegin, chend, format,
-                                 data.subspan(spec.x, spec.x + spec.width,
-                                              y + spec.y, yend, z + spec.z,
-                                              zend));
-            }
+            ok &= read_tiles(subimage, miplevel, spec.x, spec.x + spec.width,
+                             spec.y, spec.y + spec.height, z + spec.z, zend,
+                             chbegin, chend, format,
+                             data.subspan(spec.x, spec.x + spec.width, spec.y,
+                                          spec.y + spec.height, z + spec.z,
+                                          zend));
+            if (!ok)
+                break;
         }
     } else {  // Scanline image -- rely on read_scanlines.
-        // Split into reasonable chunks -- try to use around 64 MB or the
-        // oiio_read_chunk value, which ever is bigger, but also round up to
-        // a multiple of the TIFF rows per strip (or 64).
-        int chunk = std::max(1, (1 << 26) / int(spec.scanline_bytes(true)));
-        chunk     = std::max(chunk, int(oiio_read_chunk));
-        chunk     = round_to_multiple(chunk, rps);
-        for (int z = 0; z < spec.depth; ++z) {
-            for (int y = 0; y < spec.height && ok; y += chunk) {
-                int yend = std::min(y + spec.y + chunk, spec.y + spec.height);
-                ok &= read_scanlines(subimage, miplevel, y + spec.y, yend,
-                                     chbegin, chend, format,
-                                     data.subspan(spec.x, spec.x + spec.width,
-                                                  y + spec.y, yend));
-            }
-        }
+        // read_scanlines does its own (pipelined) chunking, so hand it the
+        // whole image.
+        ok = read_scanlines(subimage, miplevel, spec.y, spec.y + spec.height,
+                            chbegin, chend, format,
+                            data.subspan(spec.x, spec.x + spec.width, spec.y,
+                                         spec.y + spec.height));
     }
     return ok;
 }
 
 
 
+// Progress callback used by the asynchronous read and write to poll their
+// cancellation flag.
+static bool
+poll_cancel(void* cancel, float /*portion_done*/)
+{
+    return static_cast<const std::atomic<bool>*>(cancel)->load();
+}
+
+
+
+std::future<bool>
+ImageInput::read_image_async(int subimage, int miplevel, int chbegin,
+                             int chend, TypeDesc format,
+                             const image_span<std::byte>& data,
+                             const std::atomic<bool>* cancel,
+                             CompletionCallback completion)
+{
+    return io_thread_pool()->push([this, subimage, miplevel, chbegin, chend,
+                                   format, data, cancel,
+                                   completion](int /*id*/) {
+        bool ok = false;
+        if (!cancel) {
+            ok = read_image(subimage, miplevel, chbegin, chend, format, data);
+        } else if (!*cancel) {
+            // Only poll when there is a flag: with a progress callback,
+            // read_image reads in smaller pieces so that it can report.
+            // That means using the pointer flavor, so check the span here.
+            ImageSpec spec = spec_dimensions(subimage, miplevel);
+            int nchans     = spec.nchannels;
+            int chend1     = (chend < 0 || chend > nchans) ? nchans : chend;
+            ok = check_span_size(this, "read_image_async", spec, format,
+                                 spec.image_pixels(), chbegin, chend1, data)
+                 && read_image(subimage, miplevel, chbegin, chend, format,
+                               data.data(), data.xstride(), data.ystride(),
+                               data.zstride(), poll_cancel,
+                               const_cast<std::atomic<bool>*>(cancel));
+        }
+        if (cancel && *cancel) {
+            errorfmt("read_image_async: cancelled");
+            ok = false;
+        }
+        if (!ok) {
+            // We are on an I/O thread, so move the error to where the
+            // caller's thread will find it.
+            std::string err = geterror();
+            std::lock_guard<std::mutex> lock(m_impl->m_async_mutex);
+            m_impl->m_async_error = err;
+        }
+        if (completion)
+            completion(ok);
+        return ok;
+    });
+}
+
+
 bool
 ImageInput::read_native_deep_scanlines(int /*subimage*/, int /*miplevel*/,
                                        int /*ybegin*/, int /*yend*/, int /*z*/,
@@ -1356,6 +1561,11 @@ ImageInput::append_error(string_view message) const
 bool
 ImageInput::has_error() const
 {
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_async_mutex);
+        if (m_impl->m_async_error.size())
+            return true;
+    }
     auto iter = input_error_messages.find(m_impl->m_id);
     if (iter == input_error_messages.end())
         return false;
@@ -1368,9 +1578,17 @@ std::string
 ImageInput::geterror(bool clear) const
 {
     std::string e;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_async_mutex);
+        e = m_impl->m_async_error;
+        if (clear)
+            m_impl->m_async_error.clear();
+    }
     auto iter = input_error_messages.find(m_impl->m_id);
     if (iter != input_error_messages.end()) {
-        e = iter.value();
+        if (e.size() && iter.value().size())
+            e += '\n';
+        e += iter.value();
         if (clear)
             input_error_messages.erase(iter);
     }
@@ -42,6 +42,7 @@ std::recursive_mutex imageio_mutex;
 atomic_int oiio_threads(threads_default());
 atomic_int oiio_exr_threads(threads_default());
 atomic_int oiio_read_chunk(256);
+atomic_int oiio_io_threads(4);
 atomic_int oiio_try_all_readers(1);
 #ifndef OIIO_OPENEXR_CORE_DEFAULT
 #    define OIIO_OPENEXR_CORE_DEFAULT 0
@@ -50,6 +51,7 @@ atomic_int oiio_try_all_readers(1);
 int openexr_core(OIIO_OPENEXR_CORE_DEFAULT);
 int jpeg_com_attributes(1);
 int png_linear_premult(0);
+int png_multithread(1);
 int tiff_half(0);
 int tiff_multithread(1);
 int dds_bc5normal(0);
@@ -65,6 +67,7 @@ int limit_channels(1024);
 int limit_imagesize_MB(std::min(32 * 1024,
                                 int(Sysutil::physical_memory() >> 20)));
 int imageinput_strict(0);
+int yee_decimate(0);
 ustring font_searchpath(Sysutil::getenv("OPENIMAGEIO_FONTS"));
 ustring plugin_searchpath(OIIO_DEFAULT_PLUGIN_SEARCHPATH);
 std::string format_list;         // comma-separated list of all formats
@@ -74,6 +77,24 @@ std::string extension_list;      // list of all extensions for all formats
 std::string library_list;        // list of all libraries for all formats
 int oiio_log_times = Strutil::stoi(Sysutil::getenv("OPENIMAGEIO_LOG_TIMES"));
 std::vector<float> oiio_missingcolor;
+
+
+thread_pool*
+io_thread_pool()
+{
+    static std::unique_ptr<thread_pool> io_pool(
+        new thread_pool(oiio_io_threads));
+    static std::mutex io_pool_mutex;
+    // Setting "io_threads" only records the new size. It's applied here,
+    // the next time the pool is asked for while it has no work, so that
+    // the pool is never resized underneath running or queued jobs.
+    std::lock_guard<std::mutex> lock(io_pool_mutex);
+    int nthreads = oiio_io_threads;
+    if (io_pool->size() != nthreads && io_pool->idle() == io_pool->size()
+        && io_pool->jobs_in_queue() == 0)
+        io_pool->resize(nthreads);
+    return io_pool.get();
+}
 }  // namespace pvt
 
 using namespace pvt;
@@ -393,6 +414,11 @@ attribute(string_view name, TypeDesc type, const void* val)
         oiio_exr_threads = OIIO::clamp(*(const int*)val, -1, maxthreads);
         return true;
     }
+    if (name == "io_threads" && type == TypeInt) {
+        // Takes effect the next time io_thread_pool() finds the pool idle.
+        oiio_io_threads = OIIO::clamp(*(const int*)val, 1, maxthreads);
+        return true;
+    }
     if (name == "openexr:core" && type == TypeInt) {
         openexr_core = *(const int*)val;
         return true;
@@ -405,6 +431,10 @@ attribute(string_view name, TypeDesc type, const void* val)
         png_linear_premult = *(const int*)val;
         return true;
     }
+    if (name == "png:multithread" && type == TypeInt) {
+        png_multithread = *(const int*)val;
+        return true;
+    }
     if (name == "tiff:half" && type == TypeInt) {
         tiff_half = *(const int*)val;
         return true;
@@ -447,6 +477,10 @@ attribute(string_view name, TypeDesc type, const void* val)
         imageinput_strict = *(const int*)val;
         return true;
     }
+    if (name == "imagebufalgo:yee_decimate" && type == TypeInt) {
+        yee_decimate = *(const int*)val;
+        return true;
+    }
     if (name == "use_tbb" && type == TypeInt) {
         oiio_use_tbb = *(const int*)val;
         return true;
@@ -601,6 +635,10 @@ getattribute(string_view name, TypeDesc type, void* val)
         *(int*)val = oiio_exr_threads;
         return true;
     }
+    if (name == "io_threads" && type == TypeInt) {
+        *(int*)val = oiio_io_threads;
+        return true;
+    }
     if (name == "openexr:core" && type == TypeInt) {
         *(int*)val = openexr_core;
         return true;
@@ -613,6 +651,10 @@ getattribute(string_view name, TypeDesc type, void* val)
         *(int*)val = png_linear_premult;
         return true;
     }
+    if (name == "png:multithread" && type == TypeInt) {
+        *(int*)val = png_multithread;
+        return true;
+    }
     if (name == "tiff:half" && type == TypeInt) {
         *(int*)val = tiff_half;
         return true;
@@ -653,6 +695,10 @@ getattribute(string_view name, TypeDesc type, void* val)
         *(int*)val = imageinput_strict;
         return true;
     }
+    if (name == "imagebufalgo:yee_decimate" && type == TypeInt) {
+        *(int*)val = yee_decimate;
+        return true;
+    }
     if (name == "use_tbb" && type == TypeInt) {
         *(int*)val = oiio_use_tbb;
         return true;
@@ -944,6 +990,182 @@ OIIO_NAMESPACE_END
 OIIO_NAMESPACE_3_1_BEGIN
 
 
+// Direct conversion kernels between the pixel data types that account for
+// nearly all real-world images: uint8, uint16, half, float, uint32, and
+// double. Each kernel converts in SIMD registers, a vector of values at a
+// time, rather than through a full float intermediate buffer. The math is
+// the same as converting to float and then to the destination type with
+// convert_type, so results are identical to the general path.
+namespace {
+
+#if OIIO_SIMD >= 8
+using cvt_vfloat = simd::vfloat8;
+using cvt_vint   = simd::vint8;
+#else
+using cvt_vfloat = simd::vfloat4;
+using cvt_vint   = simd::vint4;
+#endif
+constexpr int cvt_width = cvt_vfloat::elements;
+
+
+// Load cvt_width values of type S, converted to float as convert_type
+// would (normalizing integer types to [0,1]).
+template<typename S>
+inline cvt_vfloat
+cvt_load(const S* src)
+{
+    if constexpr (std::is_same_v<S, float> || std::is_same_v<S, half>) {
+        return cvt_vfloat(src);
+    } else if constexpr (std::is_same_v<S, uint8_t>
+                         || std::is_same_v<S, uint16_t>) {
+        const float scale = 1.0f / std::numeric_limits<S>::max();
+        return cvt_vfloat(src) * cvt_vfloat(scale);
+    } else if constexpr (std::is_same_v<S, uint32_t>) {
+        // No unsigned int->float SIMD conversion, so do the two 16 bit
+        // halves separately. Their sum is exact until the final rounding,
+        // same as a scalar conversion.
+        const float scale = 1.0f / float(std::numeric_limits<S>::max());
+        cvt_vint v((const int*)src);
+        cvt_vfloat f = cvt_vfloat(simd::srl(v, 16)) * cvt_vfloat(65536.0f)
+                       + cvt_vfloat(v & cvt_vint(0xffff));
+        return f * cvt_vfloat(scale);
+    } else {
+        float tmp[cvt_width];
+        convert_type(src, tmp, cvt_width);
+        return cvt_vfloat(tmp);
+    }
+}
+
+
+// Store cvt_width float values converted to type D as convert_type would
+// (rounding and clamping for integer types).
+template<typename D>
+inline void
+cvt_store(const cvt_vfloat& v, D* dst)
+{
+    if constexpr (std::is_same_v<D, float> || std::is_same_v<D, half>) {
+        v.store(dst);
+    } else if constexpr (std::is_same_v<D, uint8_t>
+                         || std::is_same_v<D, uint16_t>) {
+        const cvt_vfloat max(float(std::numeric_limits<D>::max()));
+        cvt_vfloat scaled = simd::round(v * max);
+        cvt_vint(clamp(scaled, cvt_vfloat::Zero(), max)).store(dst);
+    } else {
+        // uint32 and double need double precision math
+        float tmp[cvt_width];
+        v.store(tmp);
+        convert_type(tmp, dst, cvt_width);
+    }
+}
+
+
+// Convert n contiguous values from type S to type D.
+template<typename S, typename D>
+void
+convert_values(const void* src_, void* dst_, size_t n)
+{
+    const S* src = (const S*)src_;
+    D* dst       = (D*)dst_;
+    size_t i     = 0;
+    for (; i + cvt_width <= n; i += cvt_width)
+        cvt_store(cvt_load(src + i), dst + i);
+    for (; i < n; ++i) {
+        float f;
+        convert_type(src + i, &f, 1);
+        convert_type(&f, dst + i, 1);
+    }
+}
+
+
+// Convert npixels pixels of nchannels contiguous values from type S to
+// type D, where pixels are src_xstride and dst_xstride bytes apart.
+// Strided pixels are gathered into (or scattered from) a small contiguous
+// buffer so that the conversion itself can run on full vectors.
+template<typename S, typename D>
+void
+convert_values_strided(const void* src, stride_t src_xstride, void* dst,
+                       stride_t dst_xstride, int nchannels, int npixels)
+{
+    constexpr int bufvals  = 1024;
+    const stride_t spixels = stride_t(nchannels * sizeof(S));
+    const stride_t dpixels = stride_t(nchannels * sizeof(D));
+    const char* s          = (const char*)src;
+    char* d                = (char*)dst;
+    if (nchannels > bufvals) {
+        for (int x = 0; x < npixels; ++x, s += src_xstride, d += dst_xstride)
+            convert_values<S, D>(s, d, size_t(nchannels));
+        return;
+    }
+    S sbuf[bufvals];
+    D dbuf[bufvals];
+    const int chunk = bufvals / nchannels;
+    for (int x = 0; x < npixels; x += chunk) {
+        int np              = std::min(chunk, npixels - x);
+        const char* sbegin  = s + x * src_xstride;
+        char* dbegin        = d + x * dst_xstride;
+        const void* convsrc = sbegin;
+        void* convdst       = dbegin;
+        if (src_xstride != spixels) {
+            for (int p = 0; p < np; ++p)
+                memcpy(sbuf + p * nchannels, sbegin + p * src_xstride,
+                       size_t(spixels));
+            convsrc = sbuf;
+        }
+        if (dst_xstride != dpixels)
+            convdst = dbuf;
+        convert_values<S, D>(convsrc, convdst, size_t(np * nchannels));
+        if (convdst == dbuf) {
+            for (int p = 0; p < np; ++p)
+                memcpy(dbegin + p * dst_xstride, dbuf + p * nchannels,
+                       size_t(dpixels));
+        }
+    }
+}
+
+
+typedef void (*ConvertValuesFunc)(const void* src, void* dst, size_t n);
+typedef void (*ConvertStridedFunc)(const void* src, stride_t src_xstride,
+                                   void* dst, stride_t dst_xstride,
+                                   int nchannels, int npixels);
+
+// Index of t's base type in the kernel tables, or -1 if there are no
+// direct kernels for it.
+inline int
+convert_kernel_index(TypeDesc t)
+{
+    switch (t.basetype) {
+    case TypeDesc::UINT8: return 0;
+    case TypeDesc::UINT16: return 1;
+    case TypeDesc::HALF: return 2;
+    case TypeDesc::FLOAT: return 3;
+    case TypeDesc::UINT32: return 4;
+    case TypeDesc::DOUBLE: return 5;
+    default: return -1;
+    }
+}
+
+// clang-format off
+#define OIIO_CONVERT_ROW(S, F)                                          \
+    { F<S, uint8_t>, F<S, uint16_t>, F<S, half>, F<S, float>,           \
+      F<S, uint32_t>, F<S, double> }
+#define OIIO_CONVERT_TABLE(F)                                           \
+    { OIIO_CONVERT_ROW(uint8_t, F), OIIO_CONVERT_ROW(uint16_t, F),      \
+      OIIO_CONVERT_ROW(half, F), OIIO_CONVERT_ROW(float, F),            \
+      OIIO_CONVERT_ROW(uint32_t, F), OIIO_CONVERT_ROW(double, F) }
+
+const ConvertValuesFunc convert_values_table[6][6]
+    = OIIO_CONVERT_TABLE(convert_values);
+const ConvertStridedFunc convert_strided_table[6][6]
+    = OIIO_CONVERT_TABLE(convert_values_strided);
+
+#undef OIIO_CONVERT_TABLE
+#undef OIIO_CONVERT_ROW
+// clang-format on
+
+}  // namespace
+
+
+
 bool
 convert_pixel_values(TypeDesc src_type, const void* src, TypeDesc dst_type,
                      void* dst, int n)
@@ -954,6 +1176,13 @@ convert_pixel_values(TypeDesc src_type, const void* src, TypeDesc dst_type,
         return true;
     }
 
+    int si = convert_kernel_index(src_type);
+    int di = convert_kernel_index(dst_type);
+    if (si >= 0 && di >= 0) {
+        convert_values_table[si][di](src, dst, size_t(n));
+        return true;
+    }
+
     if (dst_type == TypeFloat) {
         // Special case -- converting non-float to float
         OIIO::pvt::convert_to_float(src, (float*)dst, n, src_type);
@@ -1018,12 +1247,21 @@ convert_image(int nchannels, int width, int height, int depth, const void* src,
     bool result = true;
     bool contig = (src_xstride == stride_t(nchannels * src_type.size())
                    && dst_xstride == stride_t(nchannels * dst_type.size()));
+    int si = convert_kernel_index(src_type);
+    int di = convert_kernel_index(dst_type);
+    ConvertStridedFunc strided = (si >= 0 && di >= 0 && !contig)
+                                     ? convert_strided_table[si][di]
+                                     : nullptr;
     for (int z = 0; z < depth; ++z) {
         for (int y = 0; y < height; ++y) {
             const char* f = (const char*)src
                             + (z * src_zstride + y * src_ystride);
             char* t = (char*)dst + (z * dst_zstride + y * dst_ystride);
-            if (contig) {
+            if (strided) {
+                // Strided pixels, but a direct kernel for these types:
+                // gather/convert/scatter a whole row at once.
+                strided(f, src_xstride, t, dst_xstride, nchannels, width);
+            } else if (contig) {
                 // Special case: pixels within each row are contiguous
                 // in both src and dst and we're copying all channels.
                 // Be efficient by converting each scanline as a single
@@ -50,6 +50,11 @@ public:
     uint64_t m_id;
     int m_threads = 0;
 
+    // Errors from write_image_async(), which happen on an I/O thread and
+    // so can't go in the calling thread's output_error_messages.
+    std::mutex m_async_mutex;
+    std::string m_async_error;
+
     // The IOProxy object we will use for all I/O operations.
     Filesystem::IOProxy* m_io = nullptr;
     // The "local" proxy that we will create to use if the user didn't
@@ -722,6 +727,53 @@ ImageOutput::write_image(TypeDesc format,
 
 
 
+// Progress callback used by write_image_async to poll its cancellation
+// flag.
+static bool
+poll_cancel(void* cancel, float /*portion_done*/)
+{
+    return static_cast<const std::atomic<bool>*>(cancel)->load();
+}
+
+
+
+std::future<bool>
+ImageOutput::write_image_async(TypeDesc format,
+                               const image_span<const std::byte>& data,
+                               const std::atomic<bool>* cancel,
+                               CompletionCallback completion)
+{
+    return io_thread_pool()->push([this, format, data, cancel,
+                                   completion](int /*id*/) {
+        bool ok = false;
+        if (!cancel) {
+            ok = write_image(format, data);
+        } else if (!*cancel
+                   && check_span_size(this, "write_image_async", m_spec,
+                                      format, m_spec.image_pixels(), data)) {
+            ok = write_image(format, data.data(), data.xstride(),
+                             data.ystride(), data.zstride(), poll_cancel,
+                             const_cast<std::atomic<bool>*>(cancel));
+        }
+        if (cancel && *cancel) {
+            errorfmt("write_image_async: cancelled");
+            ok = false;
+        }
+        if (!ok) {
+            // We are on an I/O thread, so move the error to where the
+            // caller's thread will find it.
+            std::string err = geterror();
+            std::lock_guard<std::mutex> lock(m_impl->m_async_mutex);
+            m_impl->m_async_error = err;
+        }
+        if (completion)
+            completion(ok);
+        return ok;
+    });
+}
+
+
+
 bool
 ImageOutput::copy_image(ImageInput* in)
 {
@@ -859,6 +911,11 @@ ImageOutput::copy_tile_to_image_buffer(int x, int y, int z, TypeDesc format,
 bool
 ImageOutput::has_error() const
 {
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_async_mutex);
+        if (m_impl->m_async_error.size())
+            return true;
+    }
     auto iter = output_error_messages.find(m_impl->m_id);
     if (iter == output_error_messages.end())
         return false;
@@ -871,9 +928,17 @@ std::string
 ImageOutput::geterror(bool clear) const
 {
     std::string e;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_async_mutex);
+        e = m_impl->m_async_error;
+        if (clear)
+            m_impl->m_async_error.clear();
+    }
     auto iter = output_error_messages.find(m_impl->m_id);
     if (iter != output_error_messages.end()) {
-        e = iter.value();
+        if (e.size() && iter.value().size())
+            e += '\n';
+        e += iter.value();
         if (clear)
             output_error_messages.erase(iter);
     }
@@ -27,6 +27,7 @@ static int numthreads    = 0;
 static int autotile_size = 64;
 static bool iter_only    = false;
 static bool no_iter      = false;
+static bool convert_bench = false;
 static std::string conversionname;
 static TypeDesc conversion = TypeDesc::UNKNOWN;  // native by default
 static std::vector<ustring> input_filename;
@@ -65,6 +66,8 @@ getargs(int argc, char* argv[])
       .help("Run ImageBuf iteration tests only (not read tests)");
     ap.arg("--noiter", &no_iter)
       .help("Don't run ImageBuf iteration tests");
+    ap.arg("--convertbench", &convert_bench)
+      .help("Benchmark convert_image between pixel data types (no file needed)");
     ap.arg("--convert %s", &conversionname)
       .help("Convert to named type upon read (default: native)");
     ap.arg("--cache %f", &cache_size)
@@ -94,6 +97,33 @@ time_read_image()
 
 
 
+// Run func with the format-specific multithreading of those plugins that
+// can parallelize a single image's I/O (e.g. "png:multithread") turned
+// off, to measure what they gain.
+static void
+without_plugin_multithread(void (*func)())
+{
+    static const char* attribs[] = { "png:multithread", "tiff:multithread" };
+    int saved[2];
+    for (int i = 0; i < 2; ++i) {
+        saved[i] = OIIO::get_int_attribute(attribs[i]);
+        OIIO::attribute(attribs[i], 0);
+    }
+    func();
+    for (int i = 0; i < 2; ++i)
+        OIIO::attribute(attribs[i], saved[i]);
+}
+
+
+
+static void
+time_read_image_serial()
+{
+    without_plugin_multithread(time_read_image);
+}
+
+
+
 static void
 time_read_scanline_at_a_time()
 {
@@ -193,6 +223,14 @@ time_write_image()
 
 
 
+static void
+time_write_image_serial()
+{
+    without_plugin_multithread(time_write_image);
+}
+
+
+
 static void
 time_write_scanline_at_a_time()
 {
@@ -459,6 +497,56 @@ test_pixel_iteration(const std::string& explanation,
 
 
 
+// Time convert_image between every pair of the common pixel data types,
+// for contiguous pixels and for RGB pixels within RGBA buffers (the strided
+// case), and report the rate as GB/s of source plus destination data.
+static void
+time_convert_image()
+{
+    const int xres = 1024, yres = 1024, nchans = 4;
+    const TypeDesc types[] = { TypeUInt8,  TypeUInt16, TypeHalf,
+                               TypeFloat,  TypeUInt32, TypeDesc::DOUBLE };
+    const imagesize_t nvals = imagesize_t(xres) * yres * nchans;
+    std::vector<float> ramp(nvals);
+    for (imagesize_t i = 0; i < nvals; ++i)
+        ramp[i] = float(i % 1024) / 1023.0f;
+    std::vector<char> src(nvals * sizeof(double)), dst(src.size());
+
+    std::cout << "Timing convert_image (GB/s of src+dst data):\n";
+    std::cout << "                     contig   strided\n";
+    for (TypeDesc stype : types) {
+        convert_image(nchans, xres, yres, 1, ramp.data(), TypeFloat,
+                      AutoStride, AutoStride, AutoStride, src.data(), stype,
+                      AutoStride, AutoStride, AutoStride);
+        for (TypeDesc dtype : types) {
+            if (stype == dtype)
+                continue;
+            double rate[2];
+            for (int strided = 0; strided < 2; ++strided) {
+                // The strided case converts 3 of the 4 channels.
+                int nc       = strided ? 3 : nchans;
+                double bytes = double(xres) * yres * nc
+                               * (stype.size() + dtype.size());
+                double t     = time_trial(
+                    [&]() {
+                        convert_image(nc, xres, yres, 1, src.data(), stype,
+                                      nchans * stype.size(), AutoStride,
+                                      AutoStride, dst.data(), dtype,
+                                      nchans * dtype.size(), AutoStride,
+                                      AutoStride);
+                    },
+                    ntrials, iterations);
+                rate[strided] = bytes * iterations / t / 1.0e9;
+            }
+            OIIO::print("  {:>7} -> {:<7} {:7.2f}   {:7.2f}\n", stype, dtype,
+                        rate[0], rate[1]);
+        }
+    }
+    std::cout << std::endl;
+}
+
+
+
 static void
 set_dataformat(const std::string& output_format, ImageSpec& outspec)
 {
@@ -485,6 +573,11 @@ int
 main(int argc, char** argv)
 {
     getargs(argc, argv);
+    if (convert_bench) {
+        time_convert_image();
+        if (input_filename.empty())
+            return 0;
+    }
     if (input_filename.size() == 0) {
         std::cout << "Error: Must supply a filename.\n";
         return -1;
@@ -527,6 +620,8 @@ main(int argc, char** argv)
         buffer.resize(maxpelchans * sizeof(float), 0);
         test_read("read_image                                   ",
                   time_read_image, 0, 0);
+        test_read("read_image (no plugin multithreading)        ",
+                  time_read_image_serial, 0, 0);
         if (all_scanline) {
             test_read("read_scanline (1 at a time)                  ",
                       time_read_scanline_at_a_time, 0, 0);
@@ -574,6 +669,8 @@ main(int argc, char** argv)
 
         test_write("write_image (scanline)                       ",
                    time_write_image, 0);
+        test_write("write_image (scanline, no plugin multithread)",
+                   time_write_image_serial, 0);
         if (supports_tiles)
             test_write("write_image (tiled)                          ",
                        time_write_image, 64);
@@ -768,7 +768,148 @@ write_mipmap(ImageBufAlgo::MakeTextureMode mode, std::shared_ptr<ImageBuf>& img,
         filtername  = "lanczos3";
     }
 
-    Timer writetimer;
+    // Compute the MIP level below `big` (whose output spec is `bigspec`)
+    // into `small`, and the spec with which to write it into `smallspec`.
+    // This runs while another thread is writing `big`, so it must not
+    // modify `big` or touch `out`.
+    std::vector<std::string> mipimages;
+    std::string mipimages_unsplit = configspec.get_string_attribute(
+        "maketx:mipimages");
+    if (mipimages_unsplit.length())
+        Strutil::split(mipimages_unsplit, mipimages, ";");
+    bool allow_shift = configspec.get_int_attribute("maketx:allow_pixel_shift")
+                       != 0;
+    auto make_level = [&](const ImageBuf& big, const ImageSpec& bigspec,
+                          ImageBuf& small, ImageSpec& smallspec) -> bool {
+        if (mipimages.size()) {
+            // Special case -- the user specified a custom MIP level
+            small.reset(mipimages[0]);
+            small.read(0, 0, true, TypeFloat);
+            smallspec = small.spec();
+            if (smallspec.nchannels != bigspec.nchannels) {
+                OIIO::print(outstream,
+                            "WARNING: Custom mip level \"{}\" had the wrong "
+                            "number of channels.\n",
+                            mipimages[0]);
+                ImageBuf t(smallspec);
+                ImageBufAlgo::channels(t, small, bigspec.nchannels,
+                                       cspan<int>(), cspan<float>(),
+                                       cspan<std::string>(), true, nthreads);
+                small.swap(t);
+            }
+            smallspec.tile_width  = bigspec.tile_width;
+            smallspec.tile_height = bigspec.tile_height;
+            smallspec.tile_depth  = bigspec.tile_depth;
+            mipimages.erase(mipimages.begin());
+        } else {
+            // Resize a factor of two smaller
+            smallspec = bigspec;
+            if (!configspec.get_int_attribute("maketx:mipmap_metadata"))
+                smallspec.extra_attribs.free();
+            smallspec.width  = big.spec().width;
+            smallspec.height = big.spec().height;
+            smallspec.depth  = big.spec().depth;
+            if (smallspec.width > 1)
+                smallspec.width /= 2;
+            if (smallspec.height > 1)
+                smallspec.height /= 2;
+            smallspec.full_width  = smallspec.width;
+            smallspec.full_height = smallspec.height;
+            smallspec.full_depth  = smallspec.depth;
+            if (!allow_shift
+                || configspec.get_int_attribute("maketx:forcefloat", 1))
+                smallspec.set_format(TypeDesc::FLOAT);
+
+            // Trick: to get the resize working properly, we reset both
+            // display and pixel windows to match, and have 0 offset, AND
+            // the caller doctors the big image to have its display and
+            // pixel windows match.  Don't worry, the texture engine doesn't
+            // care what the upper MIP levels have for the window sizes, it
+            // uses level 0 to determine the relationship between texture
+            // 0-1 space (display window) and the pixels.
+            smallspec.x      = 0;
+            smallspec.y      = 0;
+            smallspec.full_x = 0;
+            smallspec.full_y = 0;
+            small.reset(smallspec);  // Realocate with new size
+
+            if (filtername == "box" && !orig_was_overscan && sharpen <= 0.0f) {
+                ImageBufAlgo::parallel_image(get_roi(small.spec()),
+                                             paropt(nthreads), [&](ROI roi) {
+                                                 resize_block(small, big, roi,
+                                                              envlatlmode,
+                                                              allow_shift);
+                                             });
+            } else {
+                Filter2D* filter = setup_filter(small.spec(), big.spec(),
+                                                filtername);
+                if (!filter) {
+                    errorfmt("Could not make filter \"{}\"", filtername);
+                    return false;
+                }
+                if (verbose) {
+                    OIIO::print(outstream,
+                                "  Downsampling filter \"{}\" width = {}",
+                                filter->name(), filter->width());
+                    if (sharpen > 0.0f)
+                        OIIO::print(
+                            outstream,
+                            ", sharpening {} with {} unsharp mask {} the resize",
+                            sharpen, sharpenfilt,
+                            (sharpen_first ? "before" : "after"));
+                    OIIO::print(outstream, "\n");
+                }
+                // `big` is being written, so any processing of it before
+                // the resize goes into a temporary buffer. Only one such
+                // full-size temporary is alive at a time.
+                const ImageBuf* src = &big;
+                ImageBuf tmp;
+                if (do_highlight_compensation) {
+                    ImageBufAlgo::rangecompress(tmp, *src, false, ROI(),
+                                                nthreads);
+                    src = &tmp;
+                }
+                if (sharpen > 0.0f && sharpen_first) {
+                    ImageBuf sharp;
+                    if (!ImageBufAlgo::unsharp_mask(sharp, *src, sharpenfilt,
+                                                    3.0f, sharpen, 0.0f, ROI(),
+                                                    nthreads))
+                        errorfmt("{}", sharp.geterror());
+                    tmp.swap(sharp);
+                    src = &tmp;
+                }
+                ImageBufAlgo::resize(small, *src,
+                                     { make_pv("filterptr", filter) }, ROI(),
+                                     nthreads);
+                tmp.clear();
+                if (sharpen > 0.0f && !sharpen_first) {
+                    ImageBuf sharpsmall;
+                    bool uok = ImageBufAlgo::unsharp_mask(sharpsmall, small,
+                                                          sharpenfilt, 3.0f,
+                                                          sharpen, 0.0f, ROI(),
+                                                          nthreads);
+                    if (!uok)
+                        errorfmt("{}", sharpsmall.geterror());
+                    small.swap(sharpsmall);
+                }
+                if (do_highlight_compensation) {
+                    ImageBufAlgo::rangeexpand(small, small, false, ROI(),
+                                              nthreads);
+                    ImageBufAlgo::clamp(small, small, 0.0f,
+                                        std::numeric_limits<float>::max(),
+                                        true, ROI(), nthreads);
+                }
+                Filter2D::destroy(filter);
+            }
+        }
+        if (clamp_half)
+            ImageBufAlgo::clamp(small, small, -HALF_MAX, HALF_MAX, true, ROI(),
+                                nthreads);
+        if (envlatlmode && src_samples_border)
+            fix_latl_edges(small);
+        return true;
+    };
+
     if (!out->open(outputfilename.c_str(), outspec)) {
         errorfmt("Could not open \"{}\" : {}", outputfilename, out->geterror());
         return false;
@@ -788,170 +929,20 @@ write_mipmap(ImageBufAlgo::MakeTextureMode mode, std::shared_ptr<ImageBuf>& img,
                             nthreads);
         std::swap(tmp, img);
     }
-    if (!img->write(out)) {
-        // ImageBuf::write transfers any errors from the ImageOutput to
-        // the ImageBuf.
-        errorfmt("Write failed: {}", img->geterror());
-        if (!out->close()) {
-            errorfmt("Close failed: {}", out->geterror());
-        }
-        return false;
-    }
-
-    double wtime = writetimer();
-    stat_writetime += wtime;
-    if (verbose) {
-        size_t mem = Sysutil::memory_used(true);
-        peak_mem   = std::max(peak_mem, mem);
-        OIIO::print(outstream, "    {:15s} ({})  write {}\n",
-                    formatres(outspec), Strutil::memformat(mem),
-                    Strutil::timeintervalformat(wtime, 2));
-    }
 
-    if (mipmap) {  // Mipmap levels:
-        if (verbose)
-            OIIO::print(outstream, "  Mipmapping...\n");
-        std::vector<std::string> mipimages;
-        std::string mipimages_unsplit = configspec.get_string_attribute(
-            "maketx:mipimages");
-        if (mipimages_unsplit.length())
-            Strutil::split(mipimages_unsplit, mipimages, ";");
-        bool allow_shift
-            = configspec.get_int_attribute("maketx:allow_pixel_shift") != 0;
-
-        std::shared_ptr<ImageBuf> small(new ImageBuf);
-        while (outspec.width > 1 || outspec.height > 1) {
-            Timer miptimer;
-            ImageSpec smallspec;
-
-            if (mipimages.size()) {
-                // Special case -- the user specified a custom MIP level
-                small->reset(mipimages[0]);
-                small->read(0, 0, true, TypeFloat);
-                smallspec = small->spec();
-                if (smallspec.nchannels != outspec.nchannels) {
-                    outstream << "WARNING: Custom mip level \"" << mipimages[0]
-                              << " had the wrong number of channels.\n";
-                    std::shared_ptr<ImageBuf> t(new ImageBuf(smallspec));
-                    ImageBufAlgo::channels(*t, *small, outspec.nchannels,
-                                           cspan<int>(), cspan<float>(),
-                                           cspan<std::string>(), true,
-                                           nthreads);
-                    std::swap(t, small);
-                }
-                smallspec.tile_width  = outspec.tile_width;
-                smallspec.tile_height = outspec.tile_height;
-                smallspec.tile_depth  = outspec.tile_depth;
-                mipimages.erase(mipimages.begin());
-            } else {
-                // Resize a factor of two smaller
-                smallspec = outspec;
-                if (!configspec.get_int_attribute("maketx:mipmap_metadata"))
-                    smallspec.extra_attribs.free();
-                smallspec.width  = img->spec().width;
-                smallspec.height = img->spec().height;
-                smallspec.depth  = img->spec().depth;
-                if (smallspec.width > 1)
-                    smallspec.width /= 2;
-                if (smallspec.height > 1)
-                    smallspec.height /= 2;
-                smallspec.full_width  = smallspec.width;
-                smallspec.full_height = smallspec.height;
-                smallspec.full_depth  = smallspec.depth;
-                if (!allow_shift
-                    || configspec.get_int_attribute("maketx:forcefloat", 1))
-                    smallspec.set_format(TypeDesc::FLOAT);
-
-                // Trick: to get the resize working properly, we reset
-                // both display and pixel windows to match, and have 0
-                // offset, AND doctor the big image to have its display
-                // and pixel windows match.  Don't worry, the texture
-                // engine doesn't care what the upper MIP levels have
-                // for the window sizes, it uses level 0 to determine
-                // the relationship between texture 0-1 space (display
-                // window) and the pixels.
-                smallspec.x      = 0;
-                smallspec.y      = 0;
-                smallspec.full_x = 0;
-                smallspec.full_y = 0;
-                small->reset(smallspec);  // Realocate with new size
-                img->set_full(img->xbegin(), img->xend(), img->ybegin(),
-                              img->yend(), img->zbegin(), img->zend());
-
-                if (filtername == "box" && !orig_was_overscan
-                    && sharpen <= 0.0f) {
-                    ImageBufAlgo::parallel_image(
-                        get_roi(small->spec()), paropt(nthreads), [&](ROI roi) {
-                            resize_block(*small, *img, roi, envlatlmode,
-                                         allow_shift);
-                        });
-                } else {
-                    Filter2D* filter = setup_filter(small->spec(), img->spec(),
-                                                    filtername);
-                    if (!filter) {
-                        errorfmt("Could not make filter \"{}\"", filtername);
-                        return false;
-                    }
-                    if (verbose) {
-                        OIIO::print(outstream,
-                                    "  Downsampling filter \"{}\" width = {}",
-                                    filter->name(), filter->width());
-                        if (sharpen > 0.0f)
-                            OIIO::print(
-                                outstream,
-                                ", sharpening {} with {} unsharp mask {} the resize",
-                                sharpen, sharpenfilt,
-                                (sharpen_first ? "before" : "after"));
-                        OIIO::print(outstream, "\n");
-                    }
-                    if (do_highlight_compensation)
-                        ImageBufAlgo::rangecompress(*img, *img, false, ROI(),
-                                                    nthreads);
-                    if (sharpen > 0.0f && sharpen_first) {
-                        std::shared_ptr<ImageBuf> sharp(new ImageBuf);
-                        bool uok = ImageBufAlgo::unsharp_mask(*sharp, *img,
-                                                              sharpenfilt, 3.0f,
-                                                              sharpen, 0.0f,
-                                                              ROI(), nthreads);
-                        if (!uok)
-                            errorfmt("{}", sharp->geterror());
-                        std::swap(img, sharp);
-                    }
-                    ImageBufAlgo::resize(*small, *img,
-                                         { make_pv("filterptr", filter) },
-                                         ROI(), nthreads);
-                    if (sharpen > 0.0f && !sharpen_first) {
-                        std::shared_ptr<ImageBuf> sharp(new ImageBuf);
-                        bool uok = ImageBufAlgo::unsharp_mask(*sharp, *small,
-                                                              sharpenfilt, 3.0f,
-                                                              sharpen, 0.0f,
-                                                              ROI(), nthreads);
-                        if (!uok)
-                            errorfmt("{}", sharp->geterror());
-                        std::swap(small, sharp);
-                    }
-                    if (do_highlight_compensation) {
-                        ImageBufAlgo::rangeexpand(*small, *small, false, ROI(),
-                                                  nthreads);
-                        ImageBufAlgo::clamp(*small, *small, 0.0f,
-                                            std::numeric_limits<float>::max(),
-                                            true, ROI(), nthreads);
-                    }
-                    Filter2D::destroy(filter);
-                }
-            }
-            if (clamp_half)
-                ImageBufAlgo::clamp(*small, *small, -HALF_MAX, HALF_MAX, true,
-                                    ROI(), nthreads);
-
-            double this_miptime = miptimer();
-            stat_miptime += this_miptime;
-            outspec = smallspec;
-            outspec.set_format(outputdatatype);
-            if (envlatlmode && src_samples_border)
-                fix_latl_edges(*small);
-
-            Timer writetimer;
+    // Write each level on a separate thread while the next smaller one is
+    // computed from it on this one, so downsampling overlaps the compression
+    // and I/O of the level above it. The writer is a plain thread rather
+    // than a pool task, so neither it nor the IBA calls that build the next
+    // level are limited to one thread, as they would be on a pool worker.
+    // At most two levels, plus one full-size temporary while a level is
+    // sharpened or range-compressed, are held in memory at any time.
+    std::shared_ptr<ImageBuf> small;
+    ImageSpec smallspec;
+    double miptime = 0.0;
+    for (int level = 0;; ++level) {
+        Timer writetimer;
+        if (level > 0) {
             // If the format explicitly supports MIP-maps, use that,
             // otherwise try to simulate MIP-mapping with multi-image.
             ImageOutput::OpenMode mode = out->supports("mipmap")
@@ -962,40 +953,78 @@ write_mipmap(ImageBufAlgo::MakeTextureMode mode, std::shared_ptr<ImageBuf>& img,
                          out->geterror());
                 return false;
             }
-            if (!small->write(out)) {
-                // ImageBuf::write transfers any errors from the
-                // ImageOutput to the ImageBuf.
-                errorfmt("Error writing \"{}\" : {}", outputfilename,
-                         small->geterror());
-                if (!out->close()) {
-                    errorfmt("Close failed: {}", out->geterror());
-                }
-                return false;
+        }
+
+        bool more  = mipmap && (outspec.width > 1 || outspec.height > 1);
+        bool mipok = true;
+
+        bool wok            = true;
+        double wtime        = 0.0;
+        double next_miptime = 0.0;
+
+        auto write_level = [&]() {
+            wok   = img->write(out);
+            wtime = writetimer();
+        };
+        if (more) {
+            if (level == 0 && verbose)
+                OIIO::print(outstream, "  Mipmapping...\n");
+            // Only the full window changes, and the output was already
+            // opened with outspec, so this doesn't alter what is written.
+            img->set_full(img->xbegin(), img->xend(), img->ybegin(),
+                          img->yend(), img->zbegin(), img->zend());
+            std::thread writer(write_level);
+            Timer miptimer;
+            small.reset(new ImageBuf);
+            mipok        = make_level(*img, outspec, *small, smallspec);
+            next_miptime = miptimer();
+            writer.join();
+        } else {
+            write_level();
+        }
+        if (!wok) {
+            // ImageBuf::write transfers any errors from the ImageOutput to
+            // the ImageBuf.
+            errorfmt("Write failed: {}", img->geterror());
+            if (!out->close()) {
+                errorfmt("Close failed: {}", out->geterror());
             }
-            double wtime = writetimer();
-            stat_writetime += wtime;
-            if (verbose) {
-                size_t mem = Sysutil::memory_used(true);
-                peak_mem   = std::max(peak_mem, mem);
+            return false;
+        }
+        stat_writetime += wtime;
+        if (verbose) {
+            size_t mem = Sysutil::memory_used(true);
+            peak_mem   = std::max(peak_mem, mem);
+            if (level == 0)
+                OIIO::print(outstream, "    {:15s} ({})  write {}\n",
+                            formatres(outspec), Strutil::memformat(mem),
+                            Strutil::timeintervalformat(wtime, 2));
+            else
                 OIIO::print(outstream, "    {:15s} ({})  downres {} write {}\n",
-                            formatres(smallspec), Strutil::memformat(mem),
-                            Strutil::timeintervalformat(this_miptime, 2),
+                            formatres(outspec), Strutil::memformat(mem),
+                            Strutil::timeintervalformat(miptime, 2),
                             Strutil::timeintervalformat(wtime, 2));
-            }
-            std::swap(img, small);
         }
+        if (!more)
+            break;
+        if (!mipok)
+            return false;
+        miptime = next_miptime;
+        stat_miptime += miptime;
+        outspec = smallspec;
+        outspec.set_format(outputdatatype);
+        std::swap(img, small);
     }
 
     if (verbose)
         OIIO::print(outstream, "  Wrote file: {}  ({})\n", outputfilename,
                     Strutil::memformat(Sysutil::memory_used(true)));
-    writetimer.reset();
-    writetimer.start();
+    Timer closetimer;
     if (!out->close()) {
         errorfmt("Error writing \"{}\" : {}", outputfilename, out->geterror());
         return false;
     }
-    stat_writetime += writetimer();
+    stat_writetime += closetimer();
     return true;
 }
 
@@ -1735,7 +1764,18 @@ make_texture_impl(ImageBufAlgo::MakeTextureMode mode, const ImageBuf* input,
             ccSrc.reset(new ImageBuf(floatSpec));
         }
 
-        ColorConfig colorconfig(colorconfigname);
+        // A caller making many textures may pass in one ColorConfig to use
+        // for all of them, rather than have each re-read the config file.
+        std::unique_ptr<ColorConfig> owncolorconfig;
+        const ColorConfig* colorconfigptr = nullptr;
+        if (auto p = configspec.find_attribute("maketx:colorconfig_ptr",
+                                               TypeDesc::PTR))
+            colorconfigptr = p->get<const ColorConfig*>();
+        if (!colorconfigptr) {
+            owncolorconfig.reset(new ColorConfig(colorconfigname));
+            colorconfigptr = owncolorconfig.get();
+        }
+        const ColorConfig& colorconfig(*colorconfigptr);
         if (colorconfig.has_error()) {
             errorfmt("Error Creating ColorConfig: {}", colorconfig.geterror());
             return false;
@@ -1897,6 +1937,8 @@ make_texture_impl(ImageBufAlgo::MakeTextureMode mode, const ImageBuf* input,
     dstspec.erase_attribute("AverageColor=");
     dstspec.erase_attribute("oiio:SHA-1=");
     dstspec.erase_attribute("SHA-1=");
+    dstspec.erase_attribute("oiio:SHA-1");
+    dstspec.erase_attribute("oiio:PixelHash");
     if (desc.size()) {
         Strutil::excise_string_after_head(desc, "oiio:ConstantColor=");
         Strutil::excise_string_after_head(desc, "ConstantColor=");
@@ -1904,6 +1946,7 @@ make_texture_impl(ImageBufAlgo::MakeTextureMode mode, const ImageBuf* input,
         Strutil::excise_string_after_head(desc, "AverageColor=");
         Strutil::excise_string_after_head(desc, "oiio:SHA-1=");
         Strutil::excise_string_after_head(desc, "SHA-1=");
+        Strutil::excise_string_after_head(desc, "oiio:PixelHash=");
         updatedDesc = true;
     }
 
@@ -1926,27 +1969,49 @@ make_texture_impl(ImageBufAlgo::MakeTextureMode mode, const ImageBuf* input,
     if (configspec.get_int_attribute("maketx:keepaspect", 0))
         addlHashData << "keepaspect=1 ";
 
+    // SHA-1 is the default and is stored as "oiio:SHA-1". The much faster
+    // non-cryptographic hashes are stored as "oiio:PixelHash", prefixed by
+    // the algorithm name so that hashes of different kinds never match.
     const int sha1_blocksize = 256;
-    std::string hash_digest  = configspec.get_int_attribute("maketx:hash", 1)
-                                   ? ImageBufAlgo::computePixelHashSHA1(
-                                      *toplevel, addlHashData.str(), ROI::All(),
-                                      sha1_blocksize, nthreads)
-                                   : "";
+    std::string hash_algorithm
+        = Strutil::lower(configspec.get_string_attribute("maketx:hashalgorithm",
+                                                         "sha1"));
+    std::string hash_attrib = "oiio:SHA-1";
+    std::string hash_digest;
+    if (configspec.get_int_attribute("maketx:hash", 1)) {
+        if (hash_algorithm == "sha1" || hash_algorithm == "sha-1") {
+            hash_digest = ImageBufAlgo::computePixelHashSHA1(
+                *toplevel, addlHashData.str(), ROI::All(), sha1_blocksize,
+                nthreads);
+        } else {
+            hash_digest = ImageBufAlgo::computePixelHash(*toplevel,
+                                                         hash_algorithm,
+                                                         addlHashData.str(),
+                                                         ROI::All(), nthreads);
+            if (hash_digest.empty()) {
+                errorfmt("{}", toplevel->geterror());
+                return false;
+            }
+            hash_digest = hash_algorithm + ":" + hash_digest;
+            hash_attrib = "oiio:PixelHash";
+        }
+    }
     if (hash_digest.length()) {
         if (out->supports("arbitrary_metadata")) {
-            dstspec.attribute("oiio:SHA-1", hash_digest);
+            dstspec.attribute(hash_attrib, hash_digest);
         } else {
             if (desc.length())
                 desc += " ";
-            desc += "oiio:SHA-1=";
+            desc += hash_attrib + "=";
             desc += hash_digest;
             updatedDesc = true;
         }
         if (verbose)
-            outstream << "  SHA-1: " << hash_digest << std::endl;
+            outstream << "  " << (hash_digest.size() == 40 ? "SHA-1" : "Hash")
+                      << ": " << hash_digest << std::endl;
     }
     double stat_hashtime = alltime.lap();
-    STATUS("SHA-1 hash", stat_hashtime);
+    STATUS("pixel hash", stat_hashtime);
 
     if (isConstantColor) {
         std::string colstr = Strutil::join(constantColor, ",",
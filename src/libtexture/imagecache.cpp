@@ -136,6 +136,9 @@ ImageCacheStatistics::init()
     files_totalsize        = 0;
     files_totalsize_ondisk = 0;
     bytes_read             = 0;
+
+    constant_tiles            = 0;
+    constant_tile_bytes_saved = 0;
     //    open_files_created = 0;
     //    open_files_current = 0;
     //    open_files_peak = 0;
@@ -182,6 +185,8 @@ ImageCacheStatistics::merge(const ImageCacheStatistics& s)
     files_totalsize += s.files_totalsize;
     files_totalsize_ondisk += s.files_totalsize_ondisk;
     bytes_read += s.bytes_read;
+    constant_tiles += s.constant_tiles;
+    constant_tile_bytes_saved += s.constant_tile_bytes_saved;
     //    open_files_created += s.open_files_created;
     //    open_files_current += s.open_files_current;
     //    open_files_peak += s.open_files_peak;
@@ -485,6 +490,26 @@ ImageCacheFile::SubimageInfo::init(ImageCacheFile& icfile, ImageSpec* spec_,
     channelsize = datatype.size();
     pixelsize   = channelsize * spec.nchannels;
 
+    // Group the channels into runs that share a layer name (everything
+    // before the last '.'), so that texture lookups can cache tiles of just
+    // the layer they use.
+    auto layername = [&](int c) {
+        string_view name = spec.channel_name(c);
+        size_t dot       = name.rfind('.');
+        return dot == string_view::npos ? string_view() : name.substr(0, dot);
+    };
+    channel_layer.clear();
+    int nlayers = 0;
+    for (int c = 0; c < spec.nchannels; ++nlayers) {
+        int e = c + 1;
+        while (e < spec.nchannels && layername(e) == layername(c))
+            ++e;
+        channel_layer.resize(e, { c, e });
+        c = e;
+    }
+    if (nlayers < 2)
+        channel_layer.clear();
+
     // See if there's a constant color tag
     string_view software = spec.get_string_attribute("Software");
     bool from_maketx     = Strutil::istarts_with(software, "OpenImageIO")
@@ -566,6 +591,30 @@ ImageCacheFile::SubimageInfo::get_pixel_bytes() const
 
 
 
+void
+ImageCacheFile::SubimageInfo::tile_channel_range(int chbegin, int chend,
+                                                 int maxchans,
+                                                 int& tile_chbegin,
+                                                 int& tile_chend) const
+{
+    int nchannels = spec().nchannels;
+    if (chend > chbegin && chbegin >= 0 && chend <= int(channel_layer.size())
+        && channel_layer[chbegin] == channel_layer[chend - 1]) {
+        // The lookup is within one layer -- cache just that layer
+        tile_chbegin = channel_layer[chbegin].first;
+        tile_chend   = channel_layer[chbegin].second;
+    } else if (nchannels > maxchans) {
+        // For files with many channels, narrow the range we cache
+        tile_chbegin = chbegin;
+        tile_chend   = chend;
+    } else {
+        tile_chbegin = 0;
+        tile_chend   = nchannels;
+    }
+}
+
+
+
 imagesize_t
 ImageCacheFile::SubimageInfo::get_tile_bytes(int m) const
 {
@@ -1050,8 +1099,13 @@ ImageCacheFile::init_from_spec()
     // Squash some problematic texture metadata if we suspect it's wrong
     OIIO::pvt::check_texture_metadata_sanity(this->spec(0));
 
-    // See if there's a SHA-1 hash in the image description
+    // See if there's a pixel hash in the image description. A SHA-1 is
+    // preferred; otherwise use the faster hash maketx may have stored,
+    // which is self-describing ("xxhash:...") so that hashes made with
+    // different algorithms never compare equal.
     string_view fing = spec.get_string_attribute("oiio:SHA-1");
+    if (fing.empty())
+        fing = spec.get_string_attribute("oiio:PixelHash");
     if (fing.length())
         m_fingerprint = ustring(fing);
 
@@ -1070,6 +1124,73 @@ ImageCacheFile::init_from_spec()
 
 
 
+// Of the `bytes` that a read of all channels would cost, how many were
+// actually read from the file for channels [chbegin,chend)? Readers that
+// decode channel subsets natively only touch the channels asked for;
+// everybody else reads them all and discards the rest.
+static imagesize_t
+channel_subset_bytes(ImageInput* inp, imagesize_t bytes, int chbegin,
+                     int chend, int nchannels)
+{
+    int nchans = chend - chbegin;
+    if (nchans < nchannels && nchannels > 0
+        && inp->supports("native_channel_subset"))
+        bytes = bytes / nchannels * nchans;
+    return bytes;
+}
+
+
+
+// Apply `processor` in place to `npixels` pixels of `nchannels` channels
+// of type `format`, the same way ImageBufAlgo::colorconvert would: only
+// the first 4 channels are transformed, a single channel is treated as
+// gray, and a 4th channel is treated as alpha that the color channels are
+// unpremultiplied by around the transform.
+static void
+apply_colorprocessor(const ColorProcessor* processor, TypeDesc format,
+                     void* data, imagesize_t npixels, int nchannels)
+{
+    using namespace simd;
+    constexpr int chunk = 256;
+    OIIO_SIMD4_ALIGN vfloat4 buf[chunk];
+    float alpha[chunk];
+    const float fltmin = std::numeric_limits<float>::min();
+    int nc             = std::min(4, nchannels);
+    stride_t pixelsize = stride_t(format.size()) * nchannels;
+    for (imagesize_t p = 0; p < npixels; p += chunk) {
+        int n        = int(std::min(imagesize_t(chunk), npixels - p));
+        char* pixels = (char*)data + p * pixelsize;
+        if (nc < 4)
+            std::fill(buf, buf + n, vfloat4::Zero());
+        convert_image(nc, n, 1, 1, pixels, format, pixelsize, AutoStride,
+                      AutoStride, buf, TypeFloat, sizeof(vfloat4),
+                      AutoStride, AutoStride);
+        for (int i = 0; i < n; ++i) {
+            if (nc == 1) {
+                buf[i] = shuffle<0, 0, 0, 3>(buf[i]);
+            } else if (nc == 4) {
+                float a  = extract<3>(buf[i]);
+                alpha[i] = a;
+                a        = a >= fltmin ? a : 1.0f;
+                buf[i] /= vfloat4(a, a, a, 1.0f);
+            }
+        }
+        processor->apply((float*)buf, n, 1, 4, sizeof(float), sizeof(vfloat4),
+                         n * sizeof(vfloat4));
+        if (nc == 4) {
+            for (int i = 0; i < n; ++i) {
+                float a = alpha[i] >= fltmin ? alpha[i] : 1.0f;
+                buf[i] *= vfloat4(a, a, a, 1.0f);
+            }
+        }
+        convert_image(nc, n, 1, 1, buf, TypeFloat, sizeof(vfloat4),
+                      AutoStride, AutoStride, pixels, format, pixelsize,
+                      AutoStride, AutoStride);
+    }
+}
+
+
+
 bool
 ImageCacheFile::read_tile(ImageCachePerThreadInfo* thread_info,
                           const TileID& id, void* data)
@@ -1134,23 +1255,20 @@ ImageCacheFile::read_tile(ImageCachePerThreadInfo* thread_info,
     }
 
     if (ok) {
-        size_t b = si.get_tile_bytes(miplevel);
+        size_t b = channel_subset_bytes(inp.get(), si.get_tile_bytes(miplevel),
+                                        chbegin, chend, dims.nchannels);
         thread_info->m_stats.bytes_read += b;
         m_bytesread += b;
         ++m_tilesread;
         if (id.colortransformid() > 0) {
             // OIIO::print("CONVERT id {} {},{} to cs {}\n", filename(), id.x(), id.y(),
             //       id.colortransformid());
-            ImageSpec tilespec(dims.tile_width, dims.tile_height,
-                               dims.nchannels, format);
-            ImageBuf wrapper(tilespec, make_cspan((const std::byte*)data,
-                                                  tilespec.image_bytes()));
-            ImageBufAlgo::colorconvert(
-                wrapper, wrapper,
-                ColorConfig::default_colorconfig().getColorSpaceNameByIndex(
-                    (id.colortransformid() >> 16) - 1),
-                m_imagecache.colorspace(), true, string_view(), string_view(),
-                nullptr, ROI(), 1);
+            ColorProcessorHandle processor = m_imagecache.colorprocessor(
+                id.colortransformid());
+            if (processor && !processor->isNoOp())
+                apply_colorprocessor(processor.get(), format, data,
+                                     si.get_tile_pixels(miplevel),
+                                     chend - chbegin);
         }
     }
     return ok;
@@ -1319,7 +1437,10 @@ ImageCacheFile::read_untiled(ImageCachePerThreadInfo* thread_info,
             if (!err.empty() && errors_should_issue())
                 imagecache().error("{}", err);
         }
-        size_t b = (y1 - y0 + 1) * si.get_scanline_bytes(miplevel);
+        size_t b = channel_subset_bytes(inp,
+                                        (y1 - y0 + 1)
+                                            * si.get_scanline_bytes(miplevel),
+                                        chbegin, chend, dims.nchannels);
         thread_info->m_stats.bytes_read += b;
         m_bytesread += b;
         ++m_tilesread;
@@ -1360,7 +1481,8 @@ ImageCacheFile::read_untiled(ImageCachePerThreadInfo* thread_info,
             if (!err.empty() && errors_should_issue())
                 imagecache().error("{}", err);
         }
-        size_t b = si.get_image_bytes(miplevel);
+        size_t b = channel_subset_bytes(inp, si.get_image_bytes(miplevel),
+                                        chbegin, chend, dims.nchannels);
         thread_info->m_stats.bytes_read += b;
         m_bytesread += b;
         ++m_tilesread;
@@ -1783,6 +1905,26 @@ ImageCacheImpl::check_max_files(ImageCachePerThreadInfo* /*thread_info*/)
 
 
 
+ColorProcessorHandle
+ImageCacheImpl::colorprocessor(int colortransformid)
+{
+    {
+        spin_lock lock(m_colorprocessors_mutex);
+        auto found = m_colorprocessors.find(colortransformid);
+        if (found != m_colorprocessors.end())
+            return found->second;
+    }
+    // Build it without holding the lock. If another thread beat us to it,
+    // the emplace keeps theirs.
+    const ColorConfig& cc(ColorConfig::default_colorconfig());
+    ColorProcessorHandle processor = cc.createColorProcessor(
+        cc.getColorSpaceNameByIndex((colortransformid >> 16) - 1),
+        colorspace());
+    spin_lock lock(m_colorprocessors_mutex);
+    return m_colorprocessors.emplace(colortransformid, processor).first->second;
+}
+
+
 void
 ImageCacheImpl::set_min_cache_size(long long newsize)
 {
@@ -1811,6 +1953,7 @@ ImageCacheTile::ImageCacheTile(const TileID& id, const void* pels,
     m_channelsize = file.datatype(id.subimage()).size();
     m_pixelsize   = id.nchannels() * m_channelsize;
     m_tile_width  = dims.tile_width;
+    m_tile_height = dims.tile_height;
     if (copy) {
         size_t size = memsize_needed();
         OIIO_ASSERT_MSG(size > 0 && memsize() == 0,
@@ -1841,6 +1984,8 @@ ImageCacheTile::ImageCacheTile(const TileID& id, const void* pels,
 ImageCacheTile::~ImageCacheTile()
 {
     m_id.file().imagecache().decr_tiles(memsize());
+    if (m_full_pixels)
+        m_id.file().imagecache().decr_mem(m_full_pixels_size);
     if (m_nofree)
         m_pixels.release();  // release without freeing
 }
@@ -1878,8 +2023,10 @@ ImageCacheTile::read(ImageCachePerThreadInfo* thread_info)
         SubimageInfo& si(file.subimageinfo(m_id.subimage()));
         LevelInfo& lev(si.levelinfo(m_id.miplevel()));
         const ImageDims& dims(si.leveldims(m_id.miplevel()));
-        m_tile_width = dims.tile_width;
+        m_tile_width  = dims.tile_width;
+        m_tile_height = dims.tile_height;
         OIIO_DASSERT(m_tile_width > 0);
+        check_constant(thread_info);
         int whichtile = ((m_id.x() - dims.x) / dims.tile_width)
                         + ((m_id.y() - dims.y) / dims.tile_height) * lev.nxtiles
                         + ((m_id.z() - dims.z) / dims.tile_depth)
@@ -1915,6 +2062,60 @@ ImageCacheTile::read(ImageCachePerThreadInfo* thread_info)
 
 
 
+void
+ImageCacheTile::check_constant(ImageCachePerThreadInfo* thread_info)
+{
+    const SubimageInfo& si(file().subimageinfo(m_id.subimage()));
+    size_t npixels = si.get_tile_pixels(m_id.miplevel());
+    size_t bytes   = npixels * m_pixelsize;
+    // All the pixels are the same if and only if each one matches the
+    // next, which is one memcmp of the tile against itself shifted by a
+    // pixel.
+    if (npixels < 2
+        || memcmp(&m_pixels[0], &m_pixels[m_pixelsize], bytes - m_pixelsize))
+        return;
+    // Keep just the one pixel, padded like a full tile so that SIMD loads
+    // of it don't run off the end.
+    size_t size = m_pixelsize + OIIO_SIMD_MAX_SIZE_BYTES;
+    std::unique_ptr<char[]> pixel(new char[size]);
+    memcpy(pixel.get(), &m_pixels[0], m_pixelsize);
+    memset(pixel.get() + m_pixelsize, 0, OIIO_SIMD_MAX_SIZE_BYTES);
+    size_t saved = m_pixels_size - size;
+    m_pixels.swap(pixel);
+    m_pixels_size = size;
+    m_index_mask  = 0;
+    m_constant    = true;
+    m_id.file().imagecache().decr_mem(saved);
+    ++thread_info->m_stats.constant_tiles;
+    thread_info->m_stats.constant_tile_bytes_saved += saved;
+}
+
+
+
+const void*
+ImageCacheTile::full_data() const
+{
+    if (!m_constant)
+        return data();
+    spin_lock lock(m_full_pixels_mutex);
+    if (!m_full_pixels) {
+        const SubimageInfo& si(file().subimageinfo(m_id.subimage()));
+        size_t npixels = si.get_tile_pixels(m_id.miplevel());
+        size_t size    = npixels * m_pixelsize + OIIO_SIMD_MAX_SIZE_BYTES;
+        m_full_pixels.reset(new char[size]);
+        for (size_t i = 0; i < npixels; ++i)
+            memcpy(&m_full_pixels[i * m_pixelsize], &m_pixels[0],
+                   m_pixelsize);
+        memset(&m_full_pixels[npixels * m_pixelsize], 0,
+               OIIO_SIMD_MAX_SIZE_BYTES);
+        m_full_pixels_size = size;
+        m_id.file().imagecache().incr_mem(size);
+    }
+    return m_full_pixels.get();
+}
+
+
+
 void
 ImageCacheTile::wait_pixels_ready() const
 {
@@ -1941,7 +2142,7 @@ ImageCacheTile::data(int x, int y, int z, int c) const
     if (x < 0 || x >= (int)w || y < 0 || y >= (int)h || z < 0 || z >= (int)d
         || c < m_id.chbegin() || c > m_id.chend())
         return NULL;
-    size_t offset = ((z * h + y) * w + x) * pixelsize()
+    size_t offset = (m_constant ? 0 : ((z * h + y) * w + x) * pixelsize())
                     + (c - m_id.chbegin()) * channelsize();
     return (const void*)&m_pixels[offset];
 }
@@ -2264,6 +2465,11 @@ ImageCacheImpl::getstats(int level) const
             OIIO::print(out, "  Tiles: {} created, {} current, {} peak\n",
                         int(m_stat_tiles_created), int(m_stat_tiles_current),
                         int(m_stat_tiles_peak));
+            if (stats.constant_tiles)
+                OIIO::print(out, "    constant tiles : {} (saved {})\n",
+                            stats.constant_tiles,
+                            Strutil::memformat(
+                                stats.constant_tile_bytes_saved));
             OIIO::print(out, "    total tile requests : {}\n",
                         stats.find_tile_calls);
             if (stats.find_tile_microcache_misses)
@@ -2590,12 +2796,14 @@ ImageCacheImpl::attribute(string_view name, TypeDesc type, const void* val)
         if (uval != m_colorconfigname) {
             m_colorconfigname = uval;
             do_invalidate     = true;
+            clear_colorprocessors();
         }
     } else if (name == "colorspace" && type == TypeDesc::STRING) {
         ustring uval(*(const char**)val);
         if (uval != m_colorspace) {
             m_colorspace  = uval;
             do_invalidate = true;
+            clear_colorprocessors();
         }
     } else if (name == "max_mip_res" && type == TypeInt) {
         m_max_mip_res = *(const int*)val;
@@ -2652,6 +2860,8 @@ ImageCacheImpl::getattributetype(string_view name) const
         { "stat:image_size", TypeInt64 },
         { "stat:file_size", TypeInt64 },
         { "stat:bytes_read", TypeInt64 },
+        { "stat:constant_tiles", TypeInt64 },
+        { "stat:constant_tile_bytes_saved", TypeInt64 },
         { "stat:unique_files", TypeInt },
         { "stat:fileio_time", TypeFloat },
         { "stat:fileopen_time", TypeFloat },
@@ -2783,6 +2993,9 @@ ImageCacheImpl::getattribute(string_view name, TypeDesc type, void* val) const
         ATTR_DECODE("stat:image_size", long long, stats.files_totalsize);
         ATTR_DECODE("stat:file_size", long long, stats.files_totalsize_ondisk);
         ATTR_DECODE("stat:bytes_read", long long, stats.bytes_read);
+        ATTR_DECODE("stat:constant_tiles", long long, stats.constant_tiles);
+        ATTR_DECODE("stat:constant_tile_bytes_saved", long long,
+                    stats.constant_tile_bytes_saved);
         ATTR_DECODE("stat:unique_files", int, stats.unique_files);
         ATTR_DECODE("stat:fileio_time", float, stats.fileio_time);
         ATTR_DECODE("stat:fileopen_time", float, stats.fileopen_time);
@@ -3639,8 +3852,9 @@ ImageCacheImpl::get_pixels(ImageCacheFile* file,
                 continue;
             }
             // int ty = y - ((y - dims.y) % dims.tile_height);
-            char* xptr       = yptr;
-            const char* data = NULL;
+            char* xptr           = yptr;
+            const char* data     = NULL;
+            stride_t data_stride = cache_stride;
             for (int x = xbegin; x < xend;
                  ++x, xptr += xstride, ++npixelsread) {
                 if (x < dims.x || x >= (dims.x + dims.width)) {
@@ -3667,8 +3881,10 @@ ImageCacheImpl::get_pixels(ImageCacheFile* file,
                     OIIO_DASSERT(tile);
                     data = (const char*)tile->data(x, y, z, chbegin);
                     OIIO_DASSERT(data);
+                    // A constant tile stores only one pixel
+                    data_stride = tile->constant() ? 0 : cache_stride;
                 }
-                if (xcontig) {
+                if (xcontig && data_stride) {
                     // Special case for a contiguous span within one tile
                     int spanend   = std::min(tx + dims.tile_width, xend);
                     stride_t span = spanend - x;
@@ -3681,7 +3897,7 @@ ImageCacheImpl::get_pixels(ImageCacheFile* file,
                 } else {
                     convert_pixel_values(cachetype, data, format, xptr,
                                          result_nchans);
-                    data += cache_stride;
+                    data += data_stride;
                 }
             }
         }
@@ -3854,7 +4070,7 @@ ImageCacheImpl::tile_pixels(ImageCache::Tile* tile, TypeDesc& format) const
         return NULL;
     ImageCacheTile* t = (ImageCacheTile*)tile;
     format            = t->file().datatype(t->id().subimage());
-    return t->data();
+    return t->full_data();
 }
 
 
@@ -13,6 +13,7 @@
 #include <tsl/robin_map.h>
 
 #include <OpenImageIO/Imath.h>
+#include <OpenImageIO/color.h>
 #include <OpenImageIO/export.h>
 #include <OpenImageIO/hash.h>
 #include <OpenImageIO/imagebuf.h>
@@ -68,6 +69,8 @@ struct ImageCacheStatistics {
     long long files_totalsize;
     long long files_totalsize_ondisk;
     long long bytes_read;
+    long long constant_tiles;             // Tiles stored as a single pixel
+    long long constant_tile_bytes_saved;  // Memory that saved
     // These stats are hard to deal with on a per-thread basis, so for
     // now, they are still atomics shared by the whole IC.
     // int tiles_created;
@@ -369,6 +372,10 @@ public:
         int min_mip_level = 0;         // Start with this MIP
         std::unique_ptr<int[]> minwh;  // min(width,height) for each MIP level
         ustring subimagename;
+        // For each channel, the [begin,end) channel range of the named
+        // layer it belongs to ("diffuse.R" is in layer "diffuse"). Empty
+        // unless the subimage has more than one layer.
+        std::vector<std::pair<int, int>> channel_layer;
         ImageSpec* m_spec;
 
         SubimageInfo() {}
@@ -405,6 +412,14 @@ public:
             return levels[miplevel];
         }
 
+        // Channel range [tile_chbegin,tile_chend) of the tiles to cache
+        // for a lookup of channels [chbegin,chend). That's the whole layer
+        // if the lookup falls within one, otherwise all channels, unless
+        // there are more than `maxchans` of them, in which case just the
+        // ones asked for.
+        void tile_channel_range(int chbegin, int chend, int maxchans,
+                                int& tile_chbegin, int& tile_chend) const;
+
         const ImageDims& leveldims(int miplevel) const
         {
             const LevelInfo& lvl = levelinfo(miplevel);
@@ -763,9 +778,14 @@ public:
     /// constructed the tile.  Return true for success, false for failure.
     OIIO_NODISCARD bool read(ImageCachePerThreadInfo* thread_info);
 
-    /// Return pointer to the raw pixel data
+    /// Return pointer to the raw pixel data. For a constant() tile, this
+    /// is just one pixel.
     const void* data(void) const { return &m_pixels[0]; }
 
+    /// Return pointer to the pixel data laid out as a full tile, expanding
+    /// a constant() tile on first request.
+    const void* full_data(void) const;
+
     /// Return pointer to the pixel data for a particular pixel.  Be
     /// extremely sure the pixel is within this tile!
     const void* data(int x, int y, int z, int c) const;
@@ -835,10 +855,24 @@ public:
     int channelsize() const { return m_channelsize; }
     int pixelsize() const { return m_pixelsize; }
 
+    /// Were all the pixels of the tile identical when it was read? If so,
+    /// only that one pixel is stored, and pixel_index(), pixel_offset(),
+    /// and data(x,y,z,c) refer to it for every pixel of the tile. Code
+    /// that steps from pixel to pixel itself must check this.
+    bool constant() const { return m_constant; }
+
     // 1D index of the 2D tile coordinate. 64 bit safe.
     imagesize_t pixel_index(int tile_s, int tile_t) const
     {
-        return imagesize_t(tile_t) * m_tile_width + tile_s;
+        return (imagesize_t(tile_t) * m_tile_width + tile_s) & m_index_mask;
+    }
+
+    // 1D index of the 3D coordinate within a volume tile. 64 bit safe.
+    imagesize_t pixel_index(int tile_s, int tile_t, int tile_r) const
+    {
+        return ((imagesize_t(tile_r) * m_tile_height + tile_t) * m_tile_width
+                + tile_s)
+               & m_index_mask;
     }
 
     // Offset in bytes into the tile memory of the given 2D tile pixel
@@ -855,10 +889,22 @@ private:
     int m_channelsize { 0 };           ///< How big is each channel (bytes)
     int m_pixelsize { 0 };             ///< How big is each pixel (bytes)
     int m_tile_width { 0 };            ///< Tile width
+    int m_tile_height { 0 };           ///< Tile height
     bool m_valid { false };            ///< Valid pixels
+    bool m_constant { false };         ///< Only one pixel is stored
     bool m_nofree { false };  ///< We do NOT own the pixels, do not free!
     volatile bool m_pixels_ready { false };  // Pixels have been read from disk
     atomic_int m_used { 1 };                 ///< Used recently
+    // Mask applied by pixel_index: all ones, or zero for a constant tile
+    imagesize_t m_index_mask { ~imagesize_t(0) };
+    // A constant tile expanded to full size, only if full_data() asks
+    mutable std::unique_ptr<char[]> m_full_pixels;
+    mutable size_t m_full_pixels_size { 0 };
+    mutable spin_mutex m_full_pixels_mutex;
+
+    // If every pixel of the freshly read tile is the same, shrink the
+    // storage to that one pixel.
+    void check_constant(ImageCachePerThreadInfo* thread_info);
 };
 
 
@@ -1246,6 +1292,10 @@ public:
     /// is not created.
     void incr_mem(size_t size) { m_mem_used += size; }
 
+    /// Called when a tile's pixel memory shrinks, but the tile is not
+    /// destroyed.
+    void decr_mem(size_t size) { m_mem_used -= size; }
+
     /// Called when a tile is destroyed, to update all the stats.
     ///
     void decr_tiles(size_t size)
@@ -1281,12 +1331,22 @@ public:
 
     ustring colorspace() const noexcept { return m_colorspace; }
 
+    /// Return the processor that converts tiles requested with the given
+    /// colortransformid to colorspace(), building it on first use.
+    ColorProcessorHandle colorprocessor(int colortransformid);
+
     size_t heapsize() const;
     size_t footprint(ImageCacheFootprint& output) const;
 
 private:
     void init();
 
+    void clear_colorprocessors()
+    {
+        spin_lock lock(m_colorprocessors_mutex);
+        m_colorprocessors.clear();
+    }
+
     /// Find a tile identified by 'id' in the tile cache, paging it in if
     /// needed, and store a reference to the tile.  Return true if ok,
     /// false if no such tile exists in the file or could not be read.
@@ -1346,6 +1406,9 @@ private:
     ustring m_colorspace;         ///< Working color space
     ustring m_colorconfigname;    ///< Filename of color config to use
 
+    spin_mutex m_colorprocessors_mutex;  ///< Protect m_colorprocessors
+    tsl::robin_map<int, ColorProcessorHandle> m_colorprocessors;
+
     mutable FilenameMap m_files;    ///< Map file names to ImageCacheFile's
     ustring m_file_sweep_name;      ///< Sweeper for "clock" paging algorithm
     spin_mutex m_file_sweep_mutex;  ///< Ensure only one in check_max_files
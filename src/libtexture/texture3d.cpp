@@ -4,6 +4,7 @@
 
 
 #include <cmath>
+#include <cstring>
 #include <list>
 #include <sstream>
 #include <string>
@@ -48,6 +49,31 @@ float2float(float val)
     return val;
 }
 
+// Add `weight` times the first `nchannels` channels of one texel, of type
+// `pixeltype`, to `accum`.
+OIIO_FORCEINLINE void
+texel_accum(TypeDesc::BASETYPE pixeltype, const unsigned char* texel,
+            int nchannels, float weight, float* accum)
+{
+    if (pixeltype == TypeDesc::UINT8) {
+        for (int c = 0; c < nchannels; ++c)
+            accum[c] += weight * TextureSystemImpl::uchar2float(texel[c]);
+    } else if (pixeltype == TypeDesc::UINT16) {
+        const unsigned short* t = (const unsigned short*)texel;
+        for (int c = 0; c < nchannels; ++c)
+            accum[c] += weight * ushort2float(t[c]);
+    } else if (pixeltype == TypeDesc::HALF) {
+        const half* t = (const half*)texel;
+        for (int c = 0; c < nchannels; ++c)
+            accum[c] += weight * float(t[c]);
+    } else {
+        OIIO_DASSERT(pixeltype == TypeDesc::FLOAT);
+        const float* t = (const float*)texel;
+        for (int c = 0; c < nchannels; ++c)
+            accum[c] += weight * t[c];
+    }
+}
+
 }  // end anonymous namespace
 
 bool
@@ -341,12 +367,10 @@ TextureSystemImpl::accum3d_sample_closest(
         return true;
     }
 
-    int tile_chbegin = 0, tile_chend = dims.nchannels;
-    if (dims.nchannels > m_max_tile_channels) {
-        // For files with many channels, narrow the range we cache
-        tile_chbegin = options.firstchannel;
-        tile_chend   = options.firstchannel + actualchannels;
-    }
+    int tile_chbegin, tile_chend;
+    si.tile_channel_range(options.firstchannel,
+                          options.firstchannel + actualchannels,
+                          m_max_tile_channels, tile_chbegin, tile_chend);
     int tile_s = (stex - dims.x) % dims.tile_width;
     int tile_t = (ttex - dims.y) % dims.tile_height;
     int tile_r = (rtex - dims.z) % dims.tile_depth;
@@ -359,31 +383,15 @@ TextureSystemImpl::accum3d_sample_closest(
     TileRef& tile(thread_info->tile);
     if (!tile || !ok)
         return false;
-    imagesize_t tilepel = (tile_r * dims.tile_height + imagesize_t(tile_t))
-                              * dims.tile_width
-                          + tile_s;
+    // The tile may hold only some of the channels (one layer of a
+    // multi-layer subimage), so index it by its own channel count.
+    imagesize_t tilepel   = tile->pixel_index(tile_s, tile_t, tile_r);
     int startchan_in_tile = options.firstchannel - id.chbegin();
-    imagesize_t offset    = dims.nchannels * tilepel + startchan_in_tile;
+    imagesize_t offset    = id.nchannels() * tilepel + startchan_in_tile;
     OIIO_DASSERT((size_t)offset
-                 < dims.nchannels * si.get_tile_pixels(miplevel));
-    if (pixeltype == TypeDesc::UINT8) {
-        const unsigned char* texel = tile->bytedata() + offset;
-        for (int c = 0; c < actualchannels; ++c)
-            accum[c] += weight * uchar2float(texel[c]);
-    } else if (pixeltype == TypeDesc::UINT16) {
-        const unsigned short* texel = tile->ushortdata() + offset;
-        for (int c = 0; c < actualchannels; ++c)
-            accum[c] += weight * ushort2float(texel[c]);
-    } else if (pixeltype == TypeDesc::HALF) {
-        const half* texel = tile->halfdata() + offset;
-        for (int c = 0; c < actualchannels; ++c)
-            accum[c] += weight * float(texel[c]);
-    } else {
-        OIIO_DASSERT(pixeltype == TypeDesc::FLOAT);
-        const float* texel = tile->floatdata() + offset;
-        for (int c = 0; c < actualchannels; ++c)
-            accum[c] += weight * texel[c];
-    }
+                 < id.nchannels() * si.get_tile_pixels(miplevel));
+    texel_accum(pixeltype, tile->bytedata() + offset * tile->channelsize(),
+                actualchannels, weight, accum);
 
     // Add appropriate amount of "fill" color to extra channels in
     // non-"black"-wrapped regions.
@@ -576,16 +584,17 @@ TextureSystemImpl::accum3d_sample_bilinear(
     bool r_onetile     = (tile_r != tiledepthmask) & (rtex[0] + 1 == rtex[1]);
     bool onetile       = (s_onetile & t_onetile & r_onetile);
     size_t channelsize = texturefile.channelsize(options.subimage);
-    size_t pixelsize   = texturefile.pixelsize(options.subimage);
-    int tile_chbegin = 0, tile_chend = dims.nchannels;
-    if (dims.nchannels > m_max_tile_channels) {
-        // For files with many channels, narrow the range we cache
-        tile_chbegin = options.firstchannel;
-        tile_chend   = options.firstchannel + actualchannels;
-    }
+    int tile_chbegin, tile_chend;
+    si.tile_channel_range(options.firstchannel,
+                          options.firstchannel + actualchannels,
+                          m_max_tile_channels, tile_chbegin, tile_chend);
     TileID id(texturefile, options.subimage, miplevel, 0, 0, 0, tile_chbegin,
               tile_chend, options.colortransformid);
     int startchan_in_tile = options.firstchannel - id.chbegin();
+    // Tiles may hold only some of the channels (one layer of a multi-layer
+    // subimage), so their pixels can be smaller than the file's.
+    size_t pixelsize      = id.nchannels() * channelsize;
+    imagesize_t tilebytes = pixelsize * si.get_tile_pixels(miplevel);
 
     if (onetile && valid_storage.ivalid == all_valid) {
         // Shortcut if all the texels we need are on the same tile
@@ -596,12 +605,19 @@ TextureSystemImpl::accum3d_sample_bilinear(
         TileRef& tile(thread_info->tile);
         if (!tile->valid())
             return false;
-        imagesize_t tilepel = (tile_r * dims.tile_height + imagesize_t(tile_t))
-                                  * dims.tile_width
-                              + tile_s;
-        imagesize_t offset = (dims.nchannels * tilepel + startchan_in_tile)
+        if (tile->constant()) {
+            // All eight texels are the tile's one value (for example, the
+            // background of a sparse volume), so there is nothing to
+            // interpolate and the derivatives are zero.
+            texel_accum(pixeltype,
+                        tile->bytedata() + startchan_in_tile * channelsize,
+                        actualchannels, weight, accum);
+            return true;
+        }
+        imagesize_t tilepel = tile->pixel_index(tile_s, tile_t, tile_r);
+        imagesize_t offset  = (id.nchannels() * tilepel + startchan_in_tile)
                              * channelsize;
-        OIIO_DASSERT(offset < si.get_tile_bytes(miplevel));
+        OIIO_DASSERT(offset < tilebytes);
 
         const unsigned char* b = tile->bytedata() + offset;
         texel[0][0][0]         = b;
@@ -615,6 +631,8 @@ TextureSystemImpl::accum3d_sample_bilinear(
         texel[1][1][1] = b + pixelsize * dims.tile_width + pixelsize;
     } else {
         bool firstsample = true;
+        // Are all eight texels from constant tiles?
+        bool constant = (valid_storage.ivalid == all_valid);
         for (int k = 0; k < 2; ++k) {
             for (int j = 0; j < 2; ++j) {
                 for (int i = 0; i < 2; ++i) {
@@ -635,26 +653,37 @@ TextureSystemImpl::accum3d_sample_bilinear(
                     if (!tile->valid())
                         return false;
                     savetile[k][j][i]   = tile;
-                    imagesize_t tilepel = (tile_r * dims.tile_height
-                                           + imagesize_t(tile_t))
-                                              * dims.tile_width
-                                          + tile_s;
-                    imagesize_t offset = (dims.nchannels * tilepel
+                    imagesize_t tilepel = tile->pixel_index(tile_s, tile_t,
+                                                            tile_r);
+                    imagesize_t offset = (id.nchannels() * tilepel
                                           + startchan_in_tile)
                                          * channelsize;
 #ifndef NDEBUG
-                    if (offset >= si.get_tile_bytes(miplevel))
+                    if (offset >= tilebytes)
                         std::cerr << "offset=" << offset << ", whd "
                                   << dims.tile_width << ' ' << dims.tile_height
                                   << ' ' << dims.tile_depth << " pixsize "
                                   << pixelsize << "\n";
 #endif
-                    OIIO_DASSERT((size_t)offset < si.get_tile_bytes(miplevel));
+                    OIIO_DASSERT(offset < tilebytes);
                     texel[k][j][i] = tile->bytedata() + offset;
                     OIIO_DASSERT(tile->id() == id);
+                    constant &= tile->constant();
                 }
             }
         }
+        if (constant) {
+            // A lookup that straddles constant tiles of the same value,
+            // such as between background tiles of a sparse volume, needs no
+            // filtering either.
+            const unsigned char* const* t = &texel[0][0][0];
+            for (int i = 1; i < 8 && constant; ++i)
+                constant = !memcmp(t[i], t[0], actualchannels * channelsize);
+            if (constant) {
+                texel_accum(pixeltype, t[0], actualchannels, weight, accum);
+                return true;
+            }
+        }
     }
     // FIXME -- optimize the above loop by unrolling
 
@@ -77,6 +77,49 @@ ushort2float4(const unsigned short* s)
 }
 
 
+// Convert one texel of any of the tile pixel types to float.
+OIIO_FORCEINLINE vfloat4
+texel2float4(TypeDesc::BASETYPE pixeltype, const unsigned char* p)
+{
+    if (pixeltype == TypeDesc::UINT8)
+        return uchar2float4(p);
+    if (pixeltype == TypeDesc::UINT16)
+        return ushort2float4((const unsigned short*)p);
+    if (pixeltype == TypeDesc::HALF)
+        return vfloat4((const half*)p);
+    OIIO_DASSERT(pixeltype == TypeDesc::FLOAT);
+    return vfloat4((const float*)p);
+}
+
+
+// Sum of the samples whose taps all read the one texel of a constant tile.
+// Consecutive samples on the same tile (the common case for a filter
+// footprint inside a flat region) just add their weights, so the texel is
+// converted once and nothing is interpolated.
+class ConstantTileAccum {
+public:
+    void add(const ImageCacheTileRef& tile, TypeDesc::BASETYPE pixeltype,
+             const unsigned char* texel, float weight)
+    {
+        if (tile.get() != m_tile.get()) {
+            m_sum += m_weight * m_value;
+            m_tile   = tile;
+            m_value  = texel2float4(pixeltype, texel);
+            m_weight = 0.0f;
+        }
+        m_weight += weight;
+    }
+
+    vfloat4 sum() const { return m_sum + m_weight * m_value; }
+
+private:
+    ImageCacheTileRef m_tile;
+    vfloat4 m_value { vfloat4::Zero() };
+    vfloat4 m_sum { vfloat4::Zero() };
+    float m_weight { 0.0f };
+};
+
+
 static const OIIO_SIMD4_ALIGN vbool4 channel_masks[5] = {
     vbool4(false, false, false, false), vbool4(true, false, false, false),
     vbool4(true, true, false, false),   vbool4(true, true, true, false),
@@ -1261,12 +1304,9 @@ TextureSystemImpl::get_texels(TextureHandle* texture_handle_,
     // somebody reports this routine as being a bottleneck.
     int nchannels      = chend - chbegin;
     int actualchannels = OIIO::clamp(dims.nchannels - chbegin, 0, nchannels);
-    int tile_chbegin = 0, tile_chend = dims.nchannels;
-    if (dims.nchannels > m_max_tile_channels) {
-        // For files with many channels, narrow the range we cache
-        tile_chbegin = chbegin;
-        tile_chend   = chbegin + actualchannels;
-    }
+    int tile_chbegin, tile_chend;
+    si.tile_channel_range(chbegin, chbegin + actualchannels,
+                          m_max_tile_channels, tile_chbegin, tile_chend);
     TileID tileid(*texfile, subimage, miplevel, 0, 0, 0, tile_chbegin,
                   tile_chend, options.colortransformid);
     size_t formatchannelsize = format.size();
@@ -2364,7 +2404,9 @@ TextureSystemImpl::texture_lookup(TextureFile& texturefile,
         case TextureOpt::InterpClosest:
             ok &= sample_closest(nsamples, sval, tval, lev, texturefile,
                                  thread_info, options, nchannels_result,
-                                 actualchannels, lineweight, &r, NULL, NULL);
+                                 actualchannels, lineweight, &r,
+                                 dresultds ? &drds : NULL,
+                                 dresultds ? &drdt : NULL);
             ++closestprobes;
             break;
         case TextureOpt::InterpBilinear:
@@ -2463,9 +2505,11 @@ TextureSystemImpl::pole_color(TextureFile& texturefile,
                 int y = pole * (dims.height - 1);  // 0 or height-1
                 for (int c = 0; c < dims.nchannels; ++c)
                     p[c] = 0.0f;
+                // A constant tile holds only one pixel to average
+                int step = tile->constant() ? 0 : pixelsize;
                 const unsigned char* texel = tile->bytedata()
-                                             + y * dims.tile_width * pixelsize;
-                for (int i = 0; i < width; ++i, texel += pixelsize)
+                                             + tile->pixel_offset(0, y);
+                for (int i = 0; i < width; ++i, texel += step)
                     for (int c = 0; c < dims.nchannels; ++c) {
                         if (pixeltype == TypeDesc::UINT8)
                             p[c] += uchar2float(texel[c]);
@@ -2540,14 +2584,14 @@ TextureSystemImpl::sample_closest(
     accum.clear();
     float nonfill    = 0.0f;
     int firstchannel = options.firstchannel;
-    int tile_chbegin = 0, tile_chend = dims.nchannels;
-    if (dims.nchannels > m_max_tile_channels) {
-        // For files with many channels, narrow the range we cache
-        tile_chbegin = options.firstchannel;
-        tile_chend   = options.firstchannel + actualchannels;
-    }
+    int tile_chbegin, tile_chend;
+    si.tile_channel_range(options.firstchannel,
+                          options.firstchannel + actualchannels,
+                          m_max_tile_channels, tile_chbegin, tile_chend);
     TileID id(texturefile, options.subimage, miplevel, 0, 0, 0, tile_chbegin,
               tile_chend, options.colortransformid);
+    size_t channelsize = texturefile.channelsize(options.subimage);
+    ConstantTileAccum constaccum;
     for (int sample = 0; sample < nsamples; ++sample) {
         float s = s_[sample], t = t_[sample];
         float weight = weight_[sample];
@@ -2590,6 +2634,11 @@ TextureSystemImpl::sample_closest(
         size_t offset = id.nchannels() * tile->pixel_index(tile_s, tile_t)
                         + (firstchannel - id.chbegin());
         OIIO_DASSERT(offset < dims.nchannels * si.get_tile_pixels(miplevel));
+        if (tile->constant()) {
+            constaccum.add(tile, pixeltype,
+                           tile->bytedata() + offset * channelsize, weight);
+            continue;
+        }
         simd::vfloat4 texel_simd;
         if (pixeltype == TypeDesc::UINT8) {
             // special case for 8-bit tiles
@@ -2605,6 +2654,7 @@ TextureSystemImpl::sample_closest(
 
         accum += weight * texel_simd;
     }
+    accum += constaccum.sum();
     simd::vbool4 channel_mask = channel_masks[actualchannels];
     accum                     = blend0(accum, channel_mask);
     if (nonfill < 1.0f && nchannels_result > actualchannels && options.fill) {
@@ -2686,11 +2736,10 @@ TextureSystemImpl::sample_bilinear(
     // need_pole: do we potentially need to fade to special pole color?
     // If we do, can't restrict channel range or fade_to_pole won't work.
     bool need_pole = (options.envlayout == LayoutLatLong && lvl.onetile);
-    if (dims.nchannels > m_max_tile_channels && !need_pole) {
-        // For files with many channels, narrow the range we cache
-        tile_chbegin = options.firstchannel;
-        tile_chend   = options.firstchannel + actualchannels;
-    }
+    if (!need_pole)
+        si.tile_channel_range(options.firstchannel,
+                              options.firstchannel + actualchannels,
+                              m_max_tile_channels, tile_chbegin, tile_chend);
     TileID id(texturefile, options.subimage, miplevel, 0, 0, 0, tile_chbegin,
               tile_chend, options.colortransformid);
     float nonfill = 0.0f;  // The degree to which we DON'T need fill
@@ -2706,6 +2755,7 @@ TextureSystemImpl::sample_bilinear(
         daccumds.clear();
         daccumdt.clear();
     }
+    ConstantTileAccum constaccum;
     vfloat4 s_simd, t_simd;
     vint4 sint_simd, tint_simd;
     vfloat4 sfrac_simd, tfrac_simd;
@@ -2776,11 +2826,17 @@ TextureSystemImpl::sample_bilinear(
             TileRef& tile(thread_info->tile);
             if (!tile->valid())
                 return false;
-            int pixelsize      = tile->pixelsize();
+            // A constant tile stores one pixel, so every texel is that one
+            int pixelsize      = tile->constant() ? 0 : tile->pixelsize();
             imagesize_t offset = tile->pixel_offset(tile_st[S0], tile_st[T0]);
             const unsigned char* p = tile->bytedata() + offset
                                      + channelsize
                                            * (firstchannel - id.chbegin());
+            if (tile->constant() && !need_pole) {
+                // All four texels are the tile's one pixel
+                constaccum.add(tile, pixeltype, p, weight);
+                continue;
+            }
             if (pixeltype == TypeDesc::UINT8) {
                 texel_simd[0][0] = uchar2float4(p);
                 texel_simd[0][1] = uchar2float4(p + pixelsize);
@@ -2898,6 +2954,7 @@ TextureSystemImpl::sample_bilinear(
         }
     }
 
+    accum += constaccum.sum();
     simd::vbool4 channel_mask = channel_masks[actualchannels];
     accum                     = blend0(accum, channel_mask);
     if (use_fill) {
@@ -3043,12 +3100,10 @@ TextureSystemImpl::sample_bicubic(
     // need_pole: do we potentially need to fade to special pole color?
     // If we do, can't restrict channel range or fade_to_pole won't work.
     bool need_pole   = (options.envlayout == LayoutLatLong && lvl.onetile);
-    int tile_chbegin = 0, tile_chend = dims.nchannels;
-    if (dims.nchannels > m_max_tile_channels) {
-        // For files with many channels, narrow the range we cache
-        tile_chbegin = options.firstchannel;
-        tile_chend   = options.firstchannel + actualchannels;
-    }
+    int tile_chbegin, tile_chend;
+    si.tile_channel_range(options.firstchannel,
+                          options.firstchannel + actualchannels,
+                          m_max_tile_channels, tile_chbegin, tile_chend);
     TileID id(texturefile, options.subimage, miplevel, 0, 0, 0, tile_chbegin,
               tile_chend, options.colortransformid);
     int pixelsize                         = channelsize * id.nchannels();
@@ -3061,6 +3116,7 @@ TextureSystemImpl::sample_bicubic(
         daccumdt.clear();
     }
 
+    ConstantTileAccum constaccum;
     vfloat4 s_simd, t_simd;
     vint4 sint_simd, tint_simd;
     vfloat4 sfrac_simd, tfrac_simd;
@@ -3147,31 +3203,35 @@ TextureSystemImpl::sample_bicubic(
             const unsigned char* base = tile->bytedata() + offset
                                         + firstchannel_offset_bytes;
             OIIO_DASSERT(tile->data());
+            if (tile->constant() && !need_pole) {
+                // All sixteen texels are the tile's one pixel
+                constaccum.add(tile, pixeltype, base, weight);
+                continue;
+            }
+            // A constant tile stores one pixel, so every texel is that one
+            int pixstep = tile->constant() ? 0 : pixelsize;
+            int rowstep = pixstep * dims.tile_width;
             if (pixeltype == TypeDesc::UINT8) {
-                for (int j = 0, j_offset = 0; j < 4;
-                     ++j, j_offset += pixelsize * dims.tile_width)
+                for (int j = 0, j_offset = 0; j < 4; ++j, j_offset += rowstep)
                     for (int i = 0, i_offset = j_offset; i < 4;
-                         ++i, i_offset += pixelsize)
+                         ++i, i_offset += pixstep)
                         texel_simd[j][i] = uchar2float4(base + i_offset);
             } else if (pixeltype == TypeDesc::UINT16) {
-                for (int j = 0, j_offset = 0; j < 4;
-                     ++j, j_offset += pixelsize * dims.tile_width)
+                for (int j = 0, j_offset = 0; j < 4; ++j, j_offset += rowstep)
                     for (int i = 0, i_offset = j_offset; i < 4;
-                         ++i, i_offset += pixelsize)
+                         ++i, i_offset += pixstep)
                         texel_simd[j][i] = ushort2float4(
                             (const uint16_t*)(base + i_offset));
             } else if (pixeltype == TypeDesc::HALF) {
-                for (int j = 0, j_offset = 0; j < 4;
-                     ++j, j_offset += pixelsize * dims.tile_width)
+                for (int j = 0, j_offset = 0; j < 4; ++j, j_offset += rowstep)
                     for (int i = 0, i_offset = j_offset; i < 4;
-                         ++i, i_offset += pixelsize)
+                         ++i, i_offset += pixstep)
                         texel_simd[j][i] = vfloat4(
                             (const half*)(base + i_offset));
             } else {
-                for (int j = 0, j_offset = 0; j < 4;
-                     ++j, j_offset += pixelsize * dims.tile_width)
+                for (int j = 0, j_offset = 0; j < 4; ++j, j_offset += rowstep)
                     for (int i = 0, i_offset = j_offset; i < 4;
-                         ++i, i_offset += pixelsize)
+                         ++i, i_offset += pixstep)
                         texel_simd[j][i].load((const float*)(base + i_offset));
             }
         } else {
@@ -3213,8 +3273,10 @@ TextureSystemImpl::sample_bicubic(
                     }
                     TileRef& tile(thread_info->tile);
                     OIIO_DASSERT(tile->data());
-                    imagesize_t offset = row_offset_bytes
-                                         + column_offset_bytes[i];
+                    imagesize_t offset = tile->constant()
+                                             ? firstchannel_offset_bytes
+                                             : row_offset_bytes
+                                                   + column_offset_bytes[i];
                     // const unsigned char *pixelptr = tile->bytedata() + offset[i];
                     if (pixeltype == TypeDesc::UINT8)
                         texel_simd[j][i] = uchar2float4(tile->bytedata()
@@ -3381,6 +3443,7 @@ TextureSystemImpl::sample_bicubic(
         }
     }
 
+    accum += constaccum.sum();
     simd::vbool4 channel_mask = channel_masks[actualchannels];
     accum                     = blend0(accum, channel_mask);
     if (use_fill) {
@@ -28,6 +28,7 @@
 #include <OpenImageIO/dassert.h>
 #include <OpenImageIO/filter.h>
 #include <OpenImageIO/fmath.h>
+#include <OpenImageIO/simd.h>
 
 
 OIIO_NAMESPACE_3_1_BEGIN
@@ -1047,4 +1048,82 @@ Filter2D::destroy(Filter2D* filt)
 }
 
 
+
+FilterTable::FilterTable(const Filter1D& filter, int resolution)
+{
+    init(filter.width() * 0.5f, resolution, &filter, nullptr, false);
+}
+
+
+
+FilterTable::FilterTable(const Filter2D& filter, bool vertical, int resolution)
+{
+    init((vertical ? filter.height() : filter.width()) * 0.5f, resolution,
+         nullptr, &filter, vertical);
+}
+
+
+
+void
+FilterTable::init(float radius, int resolution, const Filter1D* f1,
+                  const Filter2D* f2, bool vertical)
+{
+    auto f = [&](float x) {
+        return f1 ? (*f1)(x) : (vertical ? f2->yfilt(x) : f2->xfilt(x));
+    };
+    // The table spans [0, radius] with `resolution` entries per unit,
+    // rounded up so that the radius falls exactly on the last entry. Some
+    // filters are discontinuous at the radius (box includes it, gaussian
+    // doesn't), so the last entry holds the limit from inside, and the
+    // value at exactly the radius is kept separately.
+    int n    = std::max(1, int(ceilf(radius * std::max(resolution, 1))));
+    m_radius = radius;
+    m_scale  = radius > 0.0f ? float(n) / radius : 0.0f;
+    m_last   = float(n);
+    m_edge   = f(radius);
+    m_table.resize(n + 1);
+    for (int i = 0; i < n; ++i)
+        m_table[i] = f(std::min(float(i) / m_scale, radius));
+    m_table[n] = f(nextafterf(radius, 0.0f));
+}
+
+
+
+float
+FilterTable::eval(float x0, float dx, int n, float* weights) const
+{
+    using namespace simd;
+    int i = 0;
+    // Keep everything in locals: the stores to weights[] could otherwise
+    // alias the members and force them to be reloaded.
+    const float* table = m_table.data();
+    vfloat4 sum(0.0f);
+    vfloat4 scale   = vfloat4(m_scale);
+    vfloat4 last    = vfloat4(m_last);
+    vfloat4 edgeval = vfloat4(m_edge);
+    for (; i + 4 <= n; i += 4) {
+        vfloat4 x     = x0 + dx * (vfloat4::Iota() + float(i));
+        vfloat4 t     = abs(x) * scale;
+        vbool4 inside = t < last;
+        vbool4 edge   = t == last;
+        t             = select(inside, t, vfloat4::Zero());
+        vint4 ti      = ifloor(t);
+        vfloat4 f     = t - vfloat4(ti);
+        vfloat4 a, b;
+        a.gather(table, ti);
+        b.gather(table + 1, ti);
+        vfloat4 w = select(inside, madd(f, b - a, a),
+                           select(edge, edgeval, vfloat4::Zero()));
+        w.store(weights + i);
+        sum += w;
+    }
+    float total = reduce_add(sum);
+    for (; i < n; ++i) {
+        weights[i] = (*this)(x0 + float(i) * dx);
+        total += weights[i];
+    }
+    return total;
+}
+
+
 OIIO_NAMESPACE_3_1_END
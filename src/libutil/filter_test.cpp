@@ -226,6 +226,81 @@ bench_2d()
 
 
 
+// Check that the tabulated version of each separable filter matches the
+// filter itself, and that eval() matches evaluating one tap at a time.
+void
+test_table()
+{
+    print("\nTesting tabulated filters\n");
+    for (int i = 0, e = Filter2D::num_filters(); i < e; ++i) {
+        FilterDesc filtdesc;
+        Filter2D::get_filterdesc(i, &filtdesc);
+        if (!filtdesc.separable)
+            continue;
+        auto filter = Filter2D::create_shared(filtdesc.name, filtdesc.width,
+                                              filtdesc.width);
+        FilterTable table(*filter);
+        float peak   = filter->xfilt(0.0f);
+        float maxerr = 0.0f;
+        for (float x = -filtdesc.width; x <= filtdesc.width; x += 0.001f)
+            maxerr = std::max(maxerr, fabsf(table(x) - filter->xfilt(x)));
+        print("  {:<20s}: max error {:.2g} (relative to peak)\n",
+              filtdesc.name, maxerr / peak);
+        OIIO_CHECK_LE(maxerr, 1.0e-5f * peak);
+
+        // Odd tap count, to exercise the non-SIMD tail too
+        const int ntaps = 15;
+        float w[ntaps], total = 0.0f;
+        float x0 = -0.6f * filtdesc.width, dx = 1.2f * filtdesc.width / ntaps;
+        float sum = table.eval(x0, dx, ntaps, w);
+        for (int t = 0; t < ntaps; ++t) {
+            // The SIMD path may round x0 + t*dx (and the lerp) slightly
+            // differently than the scalar lookup.
+            OIIO_CHECK_EQUAL_THRESH(w[t], table(x0 + float(t) * dx),
+                                    1.0e-6f * peak);
+            total += w[t];
+        }
+        OIIO_CHECK_EQUAL_THRESH(sum, total, 1.0e-5f);
+    }
+}
+
+
+
+// Compare the cost of evaluating a row of filter taps with virtual calls
+// to the filter versus with FilterTable::eval().
+void
+bench_table()
+{
+    print("\nBenchmarking 16 filter taps, virtual xfilt vs table\n");
+    Benchmarker bench;
+    bench.iterations(iterations);
+    bench.trials(ntrials);
+    for (int i = 0, e = Filter2D::num_filters(); i < e; ++i) {
+        FilterDesc filtdesc;
+        Filter2D::get_filterdesc(i, &filtdesc);
+        if (!filtdesc.separable)
+            continue;
+        auto filter = Filter2D::create_shared(filtdesc.name, filtdesc.width,
+                                              filtdesc.width);
+        auto f      = filter.get();
+        FilterTable table(*f);
+        const int ntaps = 16;
+        float x0 = -0.5f * filtdesc.width, dx = filtdesc.width / ntaps;
+        float w[ntaps];
+        bench(Strutil::fmt::format("{} xfilt", filtdesc.name), [&]() {
+            for (int t = 0; t < ntaps; ++t)
+                w[t] = f->xfilt(x0 + float(t) * dx);
+            DoNotOptimize(w);
+        });
+        bench(Strutil::fmt::format("{} table", filtdesc.name), [&]() {
+            DoNotOptimize(table.eval(x0, dx, ntaps, w));
+            DoNotOptimize(w);
+        });
+    }
+}
+
+
+
 int
 main(int argc, char* argv[])
 {
@@ -247,4 +322,8 @@ main(int argc, char* argv[])
     }
     bench_1d();
     bench_2d();
+    test_table();
+    bench_table();
+
+    return unit_test_failures;
 }
@@ -8,6 +8,10 @@
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <sstream>
 
 #include <OpenImageIO/Imath.h>
@@ -20,6 +24,7 @@
 #include <OpenImageIO/imagebufalgo.h>
 #include <OpenImageIO/imagecache.h>
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/parallel.h>
 #include <OpenImageIO/strutil.h>
 #include <OpenImageIO/sysutil.h>
 #include <OpenImageIO/timer.h>
@@ -41,6 +46,12 @@ static bool verbose  = false;
 static bool runstats = false;
 static int nthreads  = 0;  // default: use #cores threads if available
 
+// Batch mode: converting more than one input per invocation
+static std::string filelist;
+static bool batchmode = false;
+static bool metadata_history;
+static std::string batch_command_line;  // command line minus the inputs
+
 // Conversion modes.  If none are true, we just make an ordinary texture.
 static bool mipmapmode     = false;
 static bool shadowmode     = false;
@@ -110,10 +121,13 @@ colorconvert_help_string()
 // verbose attribute commands. Escape control chars in the arguments, and
 // double-quote any that contain spaces.
 static std::string
-command_line_string(int argc, char* argv[], bool sansattrib)
+command_line_string(int argc, char* argv[], bool sansattrib,
+                    const std::set<std::string>& skip = {})
 {
     std::string s;
     for (int i = 0; i < argc; ++i) {
+        if (skip.count(argv[i]))
+            continue;
         if (sansattrib) {
             // skip any filtered attributes
             if (!strcmp(argv[i], "--attrib") || !strcmp(argv[i], "-attrib")
@@ -145,6 +159,67 @@ command_line_string(int argc, char* argv[], bool sansattrib)
 
 
 
+// The "Software" metadata identifying the command that made a texture,
+// which update mode compares against to decide if it's up to date.
+static std::string
+software_string(const std::string& cmdline)
+{
+    return Strutil::fmt::format("OpenImageIO {} : {}", OIIO_VERSION_STRING,
+                                metadata_history ? cmdline
+                                                 : SHA1(cmdline).digest());
+}
+
+
+
+// Expand the inputs of a batch: add the names listed in the filelist, and
+// replace any directories by all the image files beneath them, except for
+// ones with the ".tx" extension that maketx itself writes.
+static bool
+expand_batch_inputs()
+{
+    std::vector<std::string> inputs;
+    if (filelist.size()) {
+        std::string contents;
+        if (!Filesystem::read_text_file(filelist, contents)) {
+            print(stderr, "maketx ERROR: Could not read file list \"{}\"\n",
+                  filelist);
+            return false;
+        }
+        for (auto line : Strutil::splitsv(contents, "\n")) {
+            line = Strutil::strip(line);
+            if (line.size() && line[0] != '#')
+                filenames.emplace_back(line);
+        }
+    }
+    std::set<std::string> extensions;
+    for (auto& format : get_extension_map())
+        for (auto& ext : format.second)
+            extensions.insert(Strutil::lower(ext));
+    extensions.erase("tx");
+    for (auto& f : filenames) {
+        if (!Filesystem::is_directory(f)) {
+            inputs.push_back(f);
+            continue;
+        }
+        std::vector<std::string> entries;
+        if (!Filesystem::get_directory_entries(f, entries, true)) {
+            print(stderr, "maketx ERROR: Could not read directory \"{}\"\n",
+                  f);
+            return false;
+        }
+        std::sort(entries.begin(), entries.end());
+        for (auto& e : entries) {
+            std::string ext = Strutil::lower(Filesystem::extension(e, false));
+            if (Filesystem::is_regular(e) && extensions.count(ext))
+                inputs.push_back(e);
+        }
+    }
+    filenames.swap(inputs);
+    return true;
+}
+
+
+
 static void
 getargs(int argc, char* argv[], ImageSpec& configspec)
 {
@@ -189,11 +264,12 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
     bool cdf                   = false;
     float cdfsigma             = 1.0f / 6;
     int cdfbits                = 8;
+    std::string hashalgorithm  = "sha1";
 #if OPENIMAGEIO_METADATA_HISTORY_DEFAULT
-    bool metadata_history = Strutil::from_string<int>(
+    metadata_history = Strutil::from_string<int>(
         getenv("OPENIMAGEIO_METADATA_HISTORY", "1"));
 #else
-    bool metadata_history = Strutil::from_string<int>(
+    metadata_history = Strutil::from_string<int>(
         getenv("OPENIMAGEIO_METADATA_HISTORY"));
 #endif
     std::string incolorspace;
@@ -221,9 +297,11 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
     ap.arg("-v", &verbose)
       .help("Verbose status messages");
     ap.arg("-o %s:FILENAME", &outputfilename)
-      .help("Output filename");
+      .help("Output filename (or directory, for a batch)");
     ap.arg("--threads %d:NUMTHREADS", &nthreads)
       .help("Number of threads (default: #cores)");
+    ap.arg("--filelist %s:FILENAME", &filelist)
+      .help("Batch convert the input files listed in FILENAME, one per line");
     ap.arg("-u", &updatemode)
       .help("Update mode");
     ap.arg("--format %s:FILEFORMAT", &fileformatname)
@@ -262,6 +340,8 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
       .help("Do not make multiple MIP-map levels");
     ap.arg("--checknan", &checknan)
       .help("Check for NaN/Inf values (abort if found)");
+    ap.arg("--hash %s:ALGORITHM", &hashalgorithm)
+      .help("Pixel hash to store (options: sha1 [default], xxhash, farmhash)");
     ap.arg("--fixnan %s:STRATEGY", &fixnan)
       .help("Attempt to fix NaN/Inf values in the image (options: none, black, box3)");
     ap.arg("--fullpixels", &set_full_to_pixels)
@@ -363,7 +443,7 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
 
     // clang-format on
     ap.parse(argc, (const char**)argv);
-    if (filenames.empty()) {
+    if (filenames.empty() && filelist.empty()) {
         ap.briefusage();
         std::cout << "\nFor detailed help: maketx --help\n";
         exit(EXIT_SUCCESS);
@@ -390,9 +470,26 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
         exit(EXIT_FAILURE);
     }
 
-    if (filenames.size() != 1) {
-        std::cerr << "maketx ERROR: requires exactly one input filename\n";
-        exit(EXIT_FAILURE);
+    // More than one input, a file list, or a directory of inputs means
+    // batch mode.
+    std::set<std::string> inputargs(filenames.begin(), filenames.end());
+    batchmode = filenames.size() != 1 || filelist.size()
+                || Filesystem::is_directory(filenames[0]);
+    if (batchmode) {
+        if (!expand_batch_inputs())
+            exit(EXIT_FAILURE);
+        if (outputfilename.size()
+            && !Filesystem::is_directory(outputfilename)) {
+            print(stderr,
+                  "maketx ERROR: with more than one input, -o must name an "
+                  "existing directory\n");
+            exit(EXIT_FAILURE);
+        }
+        // Batches only (re)make the textures that are out of date.
+        updatemode = true;
+        inputargs.insert("--filelist");
+        inputargs.insert("-filelist");
+        inputargs.insert(filelist);
     }
 
 
@@ -443,6 +540,7 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
     configspec.attribute("maketx:resize", doresize);
     configspec.attribute("maketx:keepaspect", keepaspect);
     configspec.attribute("maketx:nomipmap", nomipmap);
+    configspec.attribute("maketx:hashalgorithm", hashalgorithm);
     configspec.attribute("maketx:updatemode", updatemode);
     configspec.attribute("maketx:constant_color_detect", constant_color_detect);
     configspec.attribute("maketx:monochrome_detect", monochrome_detect);
@@ -483,12 +581,19 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
     configspec.attribute("maketx:cdfsigma", cdfsigma);
     configspec.attribute("maketx:cdfbits", cdfbits);
 
-    std::string cmdline = command_line_string(argc, argv, sansattrib);
-    cmdline = Strutil::fmt::format("OpenImageIO {} : {}", OIIO_VERSION_STRING,
-                                   metadata_history ? cmdline
-                                                    : SHA1(cmdline).digest());
-    configspec.attribute("Software", cmdline);
-    configspec.attribute("maketx:full_command_line", cmdline);
+    if (batchmode) {
+        // Each texture of the batch gets its own command line: the batch's
+        // options followed by that texture's input (see
+        // make_texture_batch()), so that update mode judges each texture by
+        // the options and input that made it.
+        batch_command_line = command_line_string(argc, argv, sansattrib,
+                                                 inputargs);
+    } else {
+        std::string cmdline = software_string(
+            command_line_string(argc, argv, sansattrib));
+        configspec.attribute("Software", cmdline);
+        configspec.attribute("maketx:full_command_line", cmdline);
+    }
 
     // Add user-specified string attributes
     for (size_t i = 0; i < string_attrib_names.size(); ++i) {
@@ -533,6 +638,111 @@ getargs(int argc, char* argv[], ImageSpec& configspec)
 
 
 
+// Convert all of `filenames`, sharing this process's ImageCache, thread
+// pool, and color configs. Textures big enough to keep all the threads busy
+// by themselves are made one at a time; smaller ones are made concurrently,
+// each single-threaded, with their messages gathered so that they don't
+// interleave.
+static bool
+make_texture_batch(ImageBufAlgo::MakeTextureMode mode,
+                   const ImageSpec& configspec)
+{
+    const imagesize_t big_pixels = 2048 * 2048;
+    struct Job {
+        std::string input, output;
+        imagesize_t pixels = 0;
+        bool ok            = false;
+    };
+    std::vector<Job> jobs(filenames.size());
+    auto ic = ImageCache::create();  // the shared one
+    parallel_for(int64_t(0), int64_t(jobs.size()), [&](int64_t i) {
+        Job& job(jobs[i]);
+        job.input = filenames[i];
+        if (outputfilename.size())
+            job.output = Filesystem::replace_extension(
+                outputfilename + "/" + Filesystem::filename(job.input), ".tx");
+        else
+            job.output = Filesystem::replace_extension(job.input, ".tx");
+        if (const ImageSpec* spec = ic->imagespec(ustring(job.input)))
+            job.pixels = spec->image_pixels();
+        (void)ic->geterror();  // Any problem will be reported below
+    });
+
+    // Inputs from different directories (or differing only in extension)
+    // may map to the same texture. Refuse to convert any of them rather
+    // than let one silently overwrite another.
+    std::map<std::string, const Job*> outputs;
+    bool collision = false;
+    for (const auto& job : jobs) {
+        auto found = outputs.emplace(job.output, &job);
+        if (!found.second) {
+            print(stderr,
+                  "maketx ERROR: \"{}\" and \"{}\" would both be written to "
+                  "\"{}\"\n",
+                  found.first->second->input, job.input, job.output);
+            collision = true;
+        }
+    }
+    if (collision)
+        return false;
+
+    // Load the color config once for the whole batch. It also caches the
+    // color processors it makes, so the textures share those too.
+    std::unique_ptr<ColorConfig> colorconfig;
+    if (configspec.get_string_attribute("maketx:incolorspace").size()
+        && configspec.get_string_attribute("maketx:outcolorspace").size())
+        colorconfig.reset(new ColorConfig(
+            configspec.get_string_attribute("maketx:colorconfig")));
+    const ColorConfig* colorconfigptr = colorconfig.get();
+
+    std::mutex outmutex;
+    auto make_one = [&](Job& job, int threads, std::ostream& out) {
+        ImageSpec spec = configspec;
+        if (colorconfigptr)
+            spec.attribute("maketx:colorconfig_ptr", TypeDesc::PTR,
+                           &colorconfigptr);
+        std::string cmdline = software_string(
+            Strutil::fmt::format("{} \"{}\"", batch_command_line,
+                                 Strutil::escape_chars(job.input)));
+        spec.attribute("Software", cmdline);
+        spec.attribute("maketx:full_command_line", cmdline);
+        spec.attribute("maketx:threads", threads);
+        job.ok = ImageBufAlgo::make_texture(mode, job.input, job.output, spec,
+                                            &out);
+        if (!job.ok)
+            out << "make_texture ERROR: " << OIIO::geterror() << "\n";
+    };
+
+    std::vector<Job*> small;
+    for (auto& job : jobs) {
+        if (job.pixels >= big_pixels)
+            make_one(job, nthreads, std::cout);
+        else
+            small.push_back(&job);
+    }
+    parallel_for(int64_t(0), int64_t(small.size()), [&](int64_t i) {
+        std::ostringstream out;
+        out.imbue(std::locale::classic());
+        make_one(*small[i], 1, out);
+        std::lock_guard<std::mutex> lock(outmutex);
+        std::cout << out.str() << std::flush;
+    });
+
+    int nfailed = 0;
+    for (auto& job : jobs) {
+        if (!job.ok) {
+            print(stderr, "maketx ERROR: failed to convert \"{}\"\n",
+                  job.input);
+            ++nfailed;
+        }
+    }
+    if (verbose || nfailed)
+        print("maketx: {} textures, {} failed\n", jobs.size(), nfailed);
+    return nfailed == 0;
+}
+
+
+
 int
 main(int argc, char* argv[])
 {
@@ -567,10 +777,15 @@ main(int argc, char* argv[])
     if (bumpslopesmode)
         mode = ImageBufAlgo::MakeTxBumpWithSlopes;
 
-    bool ok = ImageBufAlgo::make_texture(mode, filenames[0], outputfilename,
-                                         configspec, &std::cout);
-    if (!ok)
-        std::cout << "make_texture ERROR: " << OIIO::geterror() << "\n";
+    bool ok;
+    if (batchmode) {
+        ok = make_texture_batch(mode, configspec);
+    } else {
+        ok = ImageBufAlgo::make_texture(mode, filenames[0], outputfilename,
+                                        configspec, &std::cout);
+        if (!ok)
+            std::cout << "make_texture ERROR: " << OIIO::geterror() << "\n";
+    }
     if (runstats)
         std::cout << "\n" << ic->getstats();
 
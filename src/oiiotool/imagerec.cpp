@@ -392,10 +392,12 @@ ImageRec::read(ReadPolicy readpolicy, string_view channel_set)
             allok &= ok;
             // Remove any existing SHA-1 hash from the spec.
             ib->specmod().erase_attribute("oiio:SHA-1");
+            ib->specmod().erase_attribute("oiio:PixelHash");
             std::string desc = ib->spec().get_string_attribute(
                 "ImageDescription");
             if (desc.size()) {
                 Strutil::excise_string_after_head(desc, "oiio:SHA-1=");
+                Strutil::excise_string_after_head(desc, "oiio:PixelHash=");
                 ib->specmod().attribute("ImageDescription", desc);
             }
 
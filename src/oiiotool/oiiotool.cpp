@@ -1057,6 +1057,7 @@ adjust_output_options(string_view filename, ImageSpec& spec,
     // Make sure we kill any special hints that maketx adds and that will
     // no longer be valid after whatever oiiotool operations we've done.
     spec.erase_attribute("oiio:SHA-1");
+    spec.erase_attribute("oiio:PixelHash");
     spec.erase_attribute("oiio:ConstantColor");
     spec.erase_attribute("oiio:AverageColor");
 }
@@ -15,12 +15,21 @@
 #include <OpenImageIO/sysutil.h>
 #include <OpenImageIO/typedesc.h>
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <ImathBox.h>
 #include <OpenEXR/IexThrowErrnoExc.h>
 #include <OpenEXR/ImfChannelList.h>
 #include <OpenEXR/ImfIO.h>
 #include <OpenEXR/ImfRgbaFile.h>
 
+#if defined(OIIO_USE_EXR_C_API)
+#    include <OpenEXR/openexr.h>
+#endif
+
 #define OPENEXR_CODED_VERSION                                    \
     (OPENEXR_VERSION_MAJOR * 10000 + OPENEXR_VERSION_MINOR * 100 \
      + OPENEXR_VERSION_PATCH)
@@ -128,7 +137,9 @@ public:
                 || feature == "exif"  // Because of arbitrary_metadata
                 || feature == "ioproxy"
                 || feature == "iptc"  // Because of arbitrary_metadata
-                || feature == "multiimage" || feature == "mipmap");
+                || feature == "multiimage" || feature == "mipmap"
+                // the FrameBuffer only names the requested channels
+                || feature == "native_channel_subset");
     }
     bool valid_file(Filesystem::IOProxy* ioproxy) const override;
     bool open(const std::string& name, ImageSpec& newspec,
@@ -269,4 +280,91 @@ private:
 
 
 
+#if defined(OIIO_USE_EXR_C_API)
+// Writes flat scanline and tiled OpenEXR parts through the OpenEXRCore
+// chunk API. OpenEXROutput still builds the Imf::Header for each part;
+// open() translates those into the Core header. Chunks are then encoded
+// in OIIO's thread pool straight from the caller's native pixels (using
+// their strides, so no repacking or tile padding is needed), and written
+// to the file in chunk order through a small reorder buffer.
+class OpenEXRCoreWriter {
+public:
+    struct Userdata;
+    struct Chunk;
+
+    explicit OpenEXRCoreWriter(ImageOutput* out);
+    ~OpenEXRCoreWriter();
+
+    // Can these parts be written by this class? Deep data, line orders
+    // other than increasingY, and ripmaps are left to the C++ library.
+    static bool supported(const Imf::Header* headers, const ImageSpec* specs,
+                          int nparts);
+
+    bool open(const std::string& name, Filesystem::IOProxy* io,
+              const Imf::Header* headers, const ImageSpec* specs, int nparts);
+
+    // Write scanlines or tiles of `part` from native pixels with the given
+    // strides. Scanlines that don't complete a chunk are held until the
+    // rest of the chunk arrives.
+    bool write_scanlines(int part, const ImageSpec& spec, int ybegin,
+                         int yend, const void* data, stride_t xstride,
+                         stride_t ystride);
+    bool write_tiles(int part, int miplevel, const ImageSpec& spec,
+                     int xbegin, int xend, int ybegin, int yend,
+                     const void* data, stride_t xstride, stride_t ystride);
+
+    // Has every chunk of every part been written?
+    bool complete() const;
+
+    // Write the chunk tables and close the file.
+    bool finish();
+
+private:
+    struct Partial {
+        std::vector<char> pixels;
+        int nlines = 0;
+    };
+    struct PartInfo {
+        bool tiled            = false;
+        int32_t nchunks       = 0;
+        int32_t scansperchunk = 1;
+        size_t pixelbytes     = 0;
+        std::vector<std::string> channames;
+        std::vector<size_t> chanoffset, chanbytes;
+        std::map<int, Partial> partial;  // incomplete scanline chunks
+    };
+    struct Job {
+        int part         = 0;
+        bool tiled       = false;
+        int level        = 0;
+        int x            = 0;
+        int y            = 0;
+        const char* data = nullptr;
+        stride_t xstride = 0;
+        stride_t ystride = 0;
+        std::vector<char> owned;  // pixels of a completed partial chunk
+    };
+
+    bool run_jobs(std::vector<Job>& jobs);
+    bool encode(const Job& job, exr_chunk_info_t& cinfo);
+    bool submit(std::unique_ptr<Chunk> chunk);
+    // Post errors the library reported (from any thread) to the
+    // ImageOutput, on the calling thread. Return true if there were any.
+    bool post_errors();
+
+    exr_context_t m_ctxt = nullptr;
+    std::unique_ptr<Userdata> m_userdata;
+    std::vector<PartInfo> m_parts;
+    mutable std::mutex m_mutex;
+    // Encoded chunks waiting for their predecessors to be written. Bounded
+    // by run_jobs()' window, except for tiles the caller writes out of
+    // order, which wait here until the earlier tiles arrive.
+    std::map<std::pair<int, int>, std::unique_ptr<Chunk>> m_ready;
+    int m_next_part  = 0;
+    int m_next_chunk = 0;
+};
+#endif
+
+
+
 OIIO_PLUGIN_NAMESPACE_END
@@ -107,7 +107,11 @@ public:
                 || feature == "exif"  // Because of arbitrary_metadata
                 || feature == "ioproxy"
                 || feature == "iptc"  // Because of arbitrary_metadata
-                || feature == "multiimage" || feature == "mipmap");
+                || feature == "multiimage" || feature == "mipmap"
+                // read_native_* use pread and need no lock
+                || feature == "concurrent_reads"
+                // only the requested channels are decoded
+                || feature == "native_channel_subset");
     }
     bool valid_file(const std::string& filename) const override;
     bool open(const std::string& name, ImageSpec& newspec,
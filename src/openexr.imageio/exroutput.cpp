@@ -60,6 +60,7 @@ OIIO_GCC_PRAGMA(GCC diagnostic ignored "-Wunused-parameter")
 OIIO_PRAGMA_WARNING_POP
 OIIO_PRAGMA_VISIBILITY_POP
 
+#include "imageio_pvt.h"
 #include <OpenImageIO/dassert.h>
 #include <OpenImageIO/deepdata.h>
 #include <OpenImageIO/filesystem.h>
@@ -160,6 +161,9 @@ private:
     std::vector<Imf::Header> m_headers;
     Filesystem::IOProxy* m_io = nullptr;
     std::unique_ptr<Filesystem::IOProxy> m_local_io;
+#if defined(OIIO_USE_EXR_C_API)
+    std::unique_ptr<OpenEXRCoreWriter> m_core;  ///< OpenEXRCore writer
+#endif
 
     // Initialize private members to pre-opened state
     void init(void)
@@ -181,6 +185,22 @@ private:
         m_headers.shrink_to_fit();
         m_io = nullptr;
         m_local_io.reset();
+#if defined(OIIO_USE_EXR_C_API)
+        m_core.reset();
+#endif
+    }
+
+    // If the OpenEXRCore library is enabled and can handle these parts
+    // (already translated into m_headers), set up m_core to write them.
+    // Returns true if m_core is now in charge of the file.
+    bool open_core(const std::string& name, const ImageSpec* specs,
+                   int nparts, bool& ok);
+
+    // Is data in `format` already in the native layout of the file?
+    bool is_native(TypeDesc format) const
+    {
+        return format == TypeUnknown
+               || (m_spec.channelformats.empty() && format == m_spec.format);
     }
 
     // Set up the header based on the given spec.  Also may doctor the
@@ -497,6 +517,9 @@ OpenEXROutput::~OpenEXROutput()
 {
     // Close, if not already done.
     close();
+#if defined(OIIO_USE_EXR_C_API)
+    m_core.reset();
+#endif
 
     m_output_scanline.reset();
     m_output_tiled.reset();
@@ -594,6 +617,9 @@ OpenEXROutput::open(const std::string& name, const ImageSpec& userspec,
                          e.size() ? e : std::string("unknown error"));
                 return false;
             }
+            bool ok = true;
+            if (open_core(name, &m_spec, 1, ok))
+                return ok;
             m_output_stream.reset(new OpenEXROutputStream(name.c_str(), m_io));
             if (m_spec.tile_width) {
                 m_output_tiled.reset(
@@ -626,7 +652,11 @@ OpenEXROutput::open(const std::string& name, const ImageSpec& userspec,
     if (mode == AppendSubimage) {
         // OpenEXR 2.x supports subimages, but we only allow it to use the
         // open(name,subimages,specs[]) variety.
-        if (m_subimagespecs.size() == 0 || !m_output_multipart) {
+        bool core = false;
+#if defined(OIIO_USE_EXR_C_API)
+        core = bool(m_core);
+#endif
+        if (m_subimagespecs.size() == 0 || !(m_output_multipart || core)) {
             errorfmt("{} not opened properly for subimages", format_name());
             return false;
         }
@@ -636,6 +666,13 @@ OpenEXROutput::open(const std::string& name, const ImageSpec& userspec,
             errorfmt("More subimages than originally declared.");
             return false;
         }
+        if (core) {
+            // All parts were declared up front; there's nothing to reopen.
+            m_spec = m_subimagespecs[m_subimage];
+            sanity_check_channelnames();
+            compute_pixeltypes(m_spec);
+            return true;
+        }
         // Close the current subimage, open the next one
         try {
             if (m_tiled_output_part) {
@@ -679,7 +716,11 @@ OpenEXROutput::open(const std::string& name, const ImageSpec& userspec,
     }
 
     if (mode == AppendMIPLevel) {
-        if (!m_output_scanline && !m_output_tiled) {
+        bool core = false;
+#if defined(OIIO_USE_EXR_C_API)
+        core = bool(m_core);
+#endif
+        if (!m_output_scanline && !m_output_tiled && !core) {
             errorfmt("Cannot append a MIP level if no file has been opened");
             return false;
         }
@@ -777,6 +818,9 @@ OpenEXROutput::open(const std::string& name, int subimages,
                      e.size() ? e : std::string("unknown error"));
             return false;
         }
+        bool ok = true;
+        if (open_core(name, m_subimagespecs.data(), subimages, ok))
+            return ok;
         m_output_stream.reset(new OpenEXROutputStream(name.c_str(), m_io));
         m_output_multipart.reset(new Imf::MultiPartOutputFile(*m_output_stream,
                                                               &m_headers[0],
@@ -831,6 +875,26 @@ OpenEXROutput::open(const std::string& name, int subimages,
 
 
 
+bool
+OpenEXROutput::open_core(const std::string& name, const ImageSpec* specs,
+                         int nparts, bool& ok)
+{
+#if defined(OIIO_USE_EXR_C_API)
+    if (!pvt::openexr_core
+        || !OpenEXRCoreWriter::supported(m_headers.data(), specs, nparts))
+        return false;
+    m_core.reset(new OpenEXRCoreWriter(this));
+    ok = m_core->open(name, m_io, m_headers.data(), specs, nparts);
+    if (!ok)
+        m_core.reset();
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+
 Imf::PixelType
 OpenEXROutput::imfpixeltype(TypeDesc type)
 {
@@ -1244,7 +1308,8 @@ OpenEXROutput::put_parameter(const std::string& name, TypeDesc type,
     if (Strutil::istarts_with(xname, "oiio:")) {
         if (Strutil::iequals(xname, "oiio:ConstantColor")
             || Strutil::iequals(xname, "oiio:AverageColor")
-            || Strutil::iequals(xname, "oiio:SHA-1")) {
+            || Strutil::iequals(xname, "oiio:SHA-1")
+            || Strutil::iequals(xname, "oiio:PixelHash")) {
             // let these fall through and get stored as metadata
         } else {
             // Other than the listed exceptions, suppress any other custom
@@ -1609,6 +1674,19 @@ OpenEXROutput::close()
     // trickery.  That's only necessary if it's open(), close(),
     // open(append), close(), ...
 
+#if defined(OIIO_USE_EXR_C_API)
+    if (m_core) {
+        // As below, a MIP-map file stays open until all of its levels
+        // have been written.
+        if (m_levelmode != Imf::ONE_LEVEL && !m_core->complete())
+            return true;
+        bool ok = m_core->finish();
+        m_core.reset();
+        init();
+        return ok;
+    }
+#endif
+
     if (m_levelmode != Imf::ONE_LEVEL) {
         // Leave MIP-map files open, since appending cannot be done via
         // a re-open like it can with TIFF files.
@@ -1751,6 +1829,28 @@ OpenEXROutput::write_scanlines(int ybegin, int yend, int z, TypeDesc format,
                                const void* data, stride_t xstride,
                                stride_t ystride)
 {
+#if defined(OIIO_USE_EXR_C_API)
+    if (m_core) {
+        // Hand native pixels to the encoder as they are, whatever their
+        // strides; only convert if they aren't in the file's format.
+        yend = std::min(yend, m_spec.y + m_spec.height);
+        if (format == TypeUnknown && xstride == AutoStride)
+            xstride = stride_t(m_spec.pixel_bytes(true));
+        stride_t zstride = AutoStride;
+        m_spec.auto_stride(xstride, ystride, zstride, format, m_spec.nchannels,
+                           m_spec.width, m_spec.height);
+        if (!is_native(format)) {
+            data    = to_native_rectangle(m_spec.x, m_spec.x + m_spec.width,
+                                          ybegin, yend, z, z + 1, format, data,
+                                          xstride, ystride, zstride,
+                                          m_scratch);
+            xstride = stride_t(m_spec.pixel_bytes(true));
+            ystride = xstride * m_spec.width;
+        }
+        return m_core->write_scanlines(m_subimage, m_spec, ybegin, yend, data,
+                                       xstride, ystride);
+    }
+#endif
     if (!(m_output_scanline || m_scanline_output_part)) {
         errorfmt("called OpenEXROutput::write_scanlines without an open file");
         return false;
@@ -1866,7 +1966,11 @@ OpenEXROutput::write_tiles(int xbegin, int xend, int ybegin, int yend,
 {
     //    std::cerr << "exr::write_tiles " << xbegin << ' ' << xend
     //              << ' ' << ybegin << ' ' << yend << "\n";
-    if (!(m_output_tiled || m_tiled_output_part)) {
+    bool core = false;
+#if defined(OIIO_USE_EXR_C_API)
+    core = bool(m_core);
+#endif
+    if (!(m_output_tiled || m_tiled_output_part || core)) {
         errorfmt("called OpenEXROutput::write_tiles without an open file");
         return false;
     }
@@ -1875,6 +1979,27 @@ OpenEXROutput::write_tiles(int xbegin, int xend, int ybegin, int yend,
             "called OpenEXROutput::write_tiles with an invalid tile range");
         return false;
     }
+#if defined(OIIO_USE_EXR_C_API)
+    if (m_core) {
+        // Edge tiles are clipped by the encoder, so unlike below, neither a
+        // native copy nor padding to whole tiles is needed.
+        if (format == TypeUnknown && xstride == AutoStride)
+            xstride = stride_t(m_spec.pixel_bytes(true));
+        m_spec.auto_stride(xstride, ystride, zstride, format, m_spec.nchannels,
+                           xend - xbegin, yend - ybegin);
+        if (!is_native(format)) {
+            data    = to_native_rectangle(xbegin, xend, ybegin, yend, zbegin,
+                                          zend, format, data, xstride, ystride,
+                                          zstride, m_scratch);
+            xstride = stride_t(m_spec.pixel_bytes(true));
+            ystride = xstride * (xend - xbegin);
+        }
+        xend = std::min(xend, m_spec.x + m_spec.width);
+        yend = std::min(yend, m_spec.y + m_spec.height);
+        return m_core->write_tiles(m_subimage, m_miplevel, m_spec, xbegin,
+                                   xend, ybegin, yend, data, xstride, ystride);
+    }
+#endif
 
     // Compute where OpenEXR needs to think the full buffers starts.
     // OpenImageIO requires that 'data' points to where the client wants
@@ -0,0 +1,760 @@
+// Copyright Contributors to the OpenImageIO project.
+// SPDX-License-Identifier: Apache-2.0
+// https://github.com/AcademySoftwareFoundation/OpenImageIO
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <OpenImageIO/Imath.h>
+#include <OpenImageIO/platform.h>
+
+#include "exr_pvt.h"
+
+#include <OpenEXR/openexr.h>
+
+// The way that OpenEXR uses dynamic casting for attributes requires
+// temporarily suspending "hidden" symbol visibility mode.
+OIIO_PRAGMA_VISIBILITY_PUSH
+OIIO_PRAGMA_WARNING_PUSH
+OIIO_GCC_PRAGMA(GCC diagnostic ignored "-Wunused-parameter")
+#include <OpenEXR/ImfBoxAttribute.h>
+#include <OpenEXR/ImfChromaticitiesAttribute.h>
+#include <OpenEXR/ImfDoubleAttribute.h>
+#include <OpenEXR/ImfEnvmapAttribute.h>
+#include <OpenEXR/ImfFloatAttribute.h>
+#include <OpenEXR/ImfFloatVectorAttribute.h>
+#include <OpenEXR/ImfHeader.h>
+#include <OpenEXR/ImfIntAttribute.h>
+#include <OpenEXR/ImfKeyCodeAttribute.h>
+#include <OpenEXR/ImfMatrixAttribute.h>
+#include <OpenEXR/ImfPartType.h>
+#include <OpenEXR/ImfRationalAttribute.h>
+#include <OpenEXR/ImfStdIO.h>
+#include <OpenEXR/ImfStringAttribute.h>
+#include <OpenEXR/ImfStringVectorAttribute.h>
+#include <OpenEXR/ImfTileDescriptionAttribute.h>
+#include <OpenEXR/ImfTimeCodeAttribute.h>
+#include <OpenEXR/ImfVecAttribute.h>
+#include <OpenEXR/ImfVersion.h>
+OIIO_PRAGMA_WARNING_POP
+OIIO_PRAGMA_VISIBILITY_POP
+
+#include <OpenImageIO/dassert.h>
+#include <OpenImageIO/filesystem.h>
+#include <OpenImageIO/fmath.h>
+#include <OpenImageIO/imageio.h>
+#include <OpenImageIO/parallel.h>
+#include <OpenImageIO/strutil.h>
+
+OIIO_PLUGIN_NAMESPACE_BEGIN
+
+
+// Everything OpenEXRCore needs from us while writing: where to report
+// errors and where to put the bytes. The library reports errors from
+// whichever thread hit them -- often a pool thread encoding a chunk -- so
+// they are collected here and posted to the ImageOutput by the thread that
+// called into the writer (see post_errors()).
+struct OpenEXRCoreWriter::Userdata {
+    ImageOutput* m_img        = nullptr;
+    Filesystem::IOProxy* m_io = nullptr;
+    std::mutex m_errmutex;
+    std::vector<std::string> m_errors;
+};
+
+
+
+// One encoded chunk, waiting for its turn to be written.
+struct OpenEXRCoreWriter::Chunk {
+    int part   = 0;
+    int index  = 0;  // chunk index within the part
+    int x      = 0;  // tile indices, or scanline chunk start
+    int y      = 0;
+    int level  = 0;
+    bool tiled = false;
+    std::vector<uint8_t> bytes;
+};
+
+
+
+static void
+oiio_exr_write_error_handler(exr_const_context_t ctxt, exr_result_t code,
+                             const char* msg = nullptr)
+{
+    void* userdata;
+    if (EXR_ERR_SUCCESS == exr_get_user_data(ctxt, &userdata) && userdata) {
+        auto ud = static_cast<OpenEXRCoreWriter::Userdata*>(userdata);
+        std::string err
+            = Strutil::fmt::format("EXR Error ({}): {} {}",
+                                   (ud->m_io ? ud->m_io->filename().c_str()
+                                             : "<unknown>"),
+                                   exr_get_error_code_as_string(code),
+                                   msg ? msg
+                                       : exr_get_default_error_message(code));
+        std::lock_guard<std::mutex> lock(ud->m_errmutex);
+        ud->m_errors.push_back(std::move(err));
+    }
+}
+
+
+
+// OpenEXRCore hands us absolute file offsets. Chunks and the header are
+// only ever written one at a time (we serialize them ourselves), so a seek
+// plus sequential write works for any IOProxy, not just those implementing
+// pwrite.
+static int64_t
+oiio_exr_write_func(exr_const_context_t ctxt, void* userdata,
+                    const void* buffer, uint64_t sz, uint64_t offset,
+                    exr_stream_error_func_ptr_t error_cb)
+{
+    auto ud = static_cast<OpenEXRCoreWriter::Userdata*>(userdata);
+    Filesystem::IOProxy* io = ud ? ud->m_io : nullptr;
+    if (!io)
+        return -1;
+    if (io->tell() != int64_t(offset) && !io->seek(int64_t(offset))) {
+        error_cb(ctxt, EXR_ERR_WRITE_IO, "Could not seek in file: \"%s\"",
+                 io->filename().c_str());
+        return -1;
+    }
+    size_t nwritten = io->write(buffer, sz);
+    if (nwritten != sz) {
+        std::string err = io->error();
+        error_cb(ctxt, EXR_ERR_WRITE_IO, "Could not write to file: \"%s\" (%s)",
+                 io->filename().c_str(),
+                 err.empty() ? "<unknown error>" : err.c_str());
+    }
+    return int64_t(nwritten);
+}
+
+
+
+// Capture the finished chunk rather than letting the encoder write it, so
+// that chunks compressed out of order can be written in order.
+static exr_result_t
+oiio_exr_capture_chunk(exr_encode_pipeline_t* encoder)
+{
+    auto chunk = static_cast<OpenEXRCoreWriter::Chunk*>(
+        encoder->encoding_user_data);
+    const uint8_t* buf = static_cast<const uint8_t*>(encoder->packed_buffer);
+    uint64_t size      = encoder->packed_bytes;
+    if (encoder->compressed_buffer && encoder->compressed_bytes) {
+        buf  = static_cast<const uint8_t*>(encoder->compressed_buffer);
+        size = encoder->compressed_bytes;
+    }
+    chunk->bytes.assign(buf, buf + size);
+    return EXR_ERR_SUCCESS;
+}
+
+
+
+OpenEXRCoreWriter::OpenEXRCoreWriter(ImageOutput* out)
+    : m_userdata(new Userdata)
+{
+    m_userdata->m_img = out;
+}
+
+
+
+OpenEXRCoreWriter::~OpenEXRCoreWriter() { finish(); }
+
+
+
+bool
+OpenEXRCoreWriter::post_errors()
+{
+    std::vector<std::string> errors;
+    {
+        std::lock_guard<std::mutex> lock(m_userdata->m_errmutex);
+        errors.swap(m_userdata->m_errors);
+    }
+    for (const auto& e : errors)
+        m_userdata->m_img->errorfmt("{}", e);
+    return !errors.empty();
+}
+
+
+
+bool
+OpenEXRCoreWriter::supported(const Imf::Header* headers,
+                             const ImageSpec* specs, int nparts)
+{
+    for (int p = 0; p < nparts; ++p) {
+        const Imf::Header& h(headers[p]);
+        if (h.hasType() && Imf::isDeepData(h.type()))
+            return false;
+        if (h.lineOrder() != Imf::INCREASING_Y)
+            return false;
+        if (h.compression() > Imf::DWAB_COMPRESSION)
+            return false;
+        if (h.hasTileDescription()
+            && h.tileDescription().mode == Imf::RIPMAP_LEVELS)
+            return false;
+        // We hand the caller's native data straight to the encoder, so
+        // each channel's native format must be what gets stored.
+        const ImageSpec& spec(specs[p]);
+        for (int c = 0; c < spec.nchannels; ++c) {
+            TypeDesc t = spec.channelformat(c);
+            if (t != TypeDesc::HALF && t != TypeDesc::FLOAT
+                && t != TypeDesc::UINT)
+                return false;
+        }
+    }
+    return true;
+}
+
+
+
+// Translate one Imf::Header attribute into an OpenEXRCore attribute.
+static exr_result_t
+put_core_attribute(exr_context_t ctxt, int part, const char* name,
+                   const Imf::Attribute& attr)
+{
+    using namespace Imf;
+    if (auto a = dynamic_cast<const IntAttribute*>(&attr))
+        return exr_attr_set_int(ctxt, part, name, a->value());
+    if (auto a = dynamic_cast<const FloatAttribute*>(&attr))
+        return exr_attr_set_float(ctxt, part, name, a->value());
+    if (auto a = dynamic_cast<const DoubleAttribute*>(&attr))
+        return exr_attr_set_double(ctxt, part, name, a->value());
+    if (auto a = dynamic_cast<const StringAttribute*>(&attr))
+        return exr_attr_set_string(ctxt, part, name, a->value().c_str());
+    if (auto a = dynamic_cast<const StringVectorAttribute*>(&attr)) {
+        std::vector<const char*> strs;
+        for (const auto& s : a->value())
+            strs.push_back(s.c_str());
+        return exr_attr_set_string_vector(ctxt, part, name,
+                                          int32_t(strs.size()), strs.data());
+    }
+    if (auto a = dynamic_cast<const FloatVectorAttribute*>(&attr))
+        return exr_attr_set_float_vector(ctxt, part, name,
+                                         int32_t(a->value().size()),
+                                         a->value().data());
+    if (auto a = dynamic_cast<const V2iAttribute*>(&attr)) {
+        exr_attr_v2i_t v;
+        v.x = a->value().x;
+        v.y = a->value().y;
+        return exr_attr_set_v2i(ctxt, part, name, &v);
+    }
+    if (auto a = dynamic_cast<const V2fAttribute*>(&attr)) {
+        exr_attr_v2f_t v;
+        v.x = a->value().x;
+        v.y = a->value().y;
+        return exr_attr_set_v2f(ctxt, part, name, &v);
+    }
+    if (auto a = dynamic_cast<const V2dAttribute*>(&attr)) {
+        exr_attr_v2d_t v;
+        v.x = a->value().x;
+        v.y = a->value().y;
+        return exr_attr_set_v2d(ctxt, part, name, &v);
+    }
+    if (auto a = dynamic_cast<const V3iAttribute*>(&attr)) {
+        exr_attr_v3i_t v;
+        v.x = a->value().x;
+        v.y = a->value().y;
+        v.z = a->value().z;
+        return exr_attr_set_v3i(ctxt, part, name, &v);
+    }
+    if (auto a = dynamic_cast<const V3fAttribute*>(&attr)) {
+        exr_attr_v3f_t v;
+        v.x = a->value().x;
+        v.y = a->value().y;
+        v.z = a->value().z;
+        return exr_attr_set_v3f(ctxt, part, name, &v);
+    }
+    if (auto a = dynamic_cast<const V3dAttribute*>(&attr)) {
+        exr_attr_v3d_t v;
+        v.x = a->value().x;
+        v.y = a->value().y;
+        v.z = a->value().z;
+        return exr_attr_set_v3d(ctxt, part, name, &v);
+    }
+    if (auto a = dynamic_cast<const M33fAttribute*>(&attr)) {
+        exr_attr_m33f_t m;
+        std::copy_n(a->value().getValue(), 9, m.m);
+        return exr_attr_set_m33f(ctxt, part, name, &m);
+    }
+    if (auto a = dynamic_cast<const M33dAttribute*>(&attr)) {
+        exr_attr_m33d_t m;
+        std::copy_n(a->value().getValue(), 9, m.m);
+        return exr_attr_set_m33d(ctxt, part, name, &m);
+    }
+    if (auto a = dynamic_cast<const M44fAttribute*>(&attr)) {
+        exr_attr_m44f_t m;
+        std::copy_n(a->value().getValue(), 16, m.m);
+        return exr_attr_set_m44f(ctxt, part, name, &m);
+    }
+    if (auto a = dynamic_cast<const M44dAttribute*>(&attr)) {
+        exr_attr_m44d_t m;
+        std::copy_n(a->value().getValue(), 16, m.m);
+        return exr_attr_set_m44d(ctxt, part, name, &m);
+    }
+    if (auto a = dynamic_cast<const Box2iAttribute*>(&attr)) {
+        exr_attr_box2i_t b;
+        b.min.x = a->value().min.x;
+        b.min.y = a->value().min.y;
+        b.max.x = a->value().max.x;
+        b.max.y = a->value().max.y;
+        return exr_attr_set_box2i(ctxt, part, name, &b);
+    }
+    if (auto a = dynamic_cast<const Box2fAttribute*>(&attr)) {
+        exr_attr_box2f_t b;
+        b.min.x = a->value().min.x;
+        b.min.y = a->value().min.y;
+        b.max.x = a->value().max.x;
+        b.max.y = a->value().max.y;
+        return exr_attr_set_box2f(ctxt, part, name, &b);
+    }
+    if (auto a = dynamic_cast<const ChromaticitiesAttribute*>(&attr)) {
+        const Chromaticities& c(a->value());
+        exr_attr_chromaticities_t cc;
+        cc.red_x   = c.red.x;
+        cc.red_y   = c.red.y;
+        cc.green_x = c.green.x;
+        cc.green_y = c.green.y;
+        cc.blue_x  = c.blue.x;
+        cc.blue_y  = c.blue.y;
+        cc.white_x = c.white.x;
+        cc.white_y = c.white.y;
+        return exr_attr_set_chromaticities(ctxt, part, name, &cc);
+    }
+    if (auto a = dynamic_cast<const TimeCodeAttribute*>(&attr)) {
+        exr_attr_timecode_t tc;
+        tc.time_and_flags = a->value().timeAndFlags();
+        tc.user_data      = a->value().userData();
+        return exr_attr_set_timecode(ctxt, part, name, &tc);
+    }
+    if (auto a = dynamic_cast<const KeyCodeAttribute*>(&attr)) {
+        const KeyCode& k(a->value());
+        exr_attr_keycode_t kc;
+        kc.film_mfc_code   = k.filmMfcCode();
+        kc.film_type       = k.filmType();
+        kc.prefix          = k.prefix();
+        kc.count           = k.count();
+        kc.perf_offset     = k.perfOffset();
+        kc.perfs_per_frame = k.perfsPerFrame();
+        kc.perfs_per_count = k.perfsPerCount();
+        return exr_attr_set_keycode(ctxt, part, name, &kc);
+    }
+    if (auto a = dynamic_cast<const RationalAttribute*>(&attr)) {
+        exr_attr_rational_t r;
+        r.num   = a->value().n;
+        r.denom = a->value().d;
+        return exr_attr_set_rational(ctxt, part, name, &r);
+    }
+    if (auto a = dynamic_cast<const EnvmapAttribute*>(&attr))
+        return exr_attr_set_envmap(ctxt, part, name,
+                                   exr_envmap_t(a->value()));
+
+    // Anything else (e.g. idmanifest) is passed along as the serialized
+    // value bytes, which is exactly what ends up in the file.
+    StdOSStream os;
+    attr.writeValueTo(os, EXR_VERSION);
+    std::string bytes = os.str();
+    return exr_attr_set_user(ctxt, part, name, attr.typeName(),
+                             int32_t(bytes.size()), bytes.data());
+}
+
+
+
+bool
+OpenEXRCoreWriter::open(const std::string& name, Filesystem::IOProxy* io,
+                        const Imf::Header* headers, const ImageSpec* specs,
+                        int nparts)
+{
+    m_userdata->m_io = io;
+
+    exr_context_initializer_t cinit = EXR_DEFAULT_CONTEXT_INITIALIZER;
+    cinit.error_handler_fn          = &oiio_exr_write_error_handler;
+    cinit.write_fn                  = &oiio_exr_write_func;
+    cinit.user_data                 = m_userdata.get();
+    exr_result_t rv = exr_start_write(&m_ctxt, name.c_str(),
+                                      EXR_WRITE_FILE_DIRECTLY, &cinit);
+    if (rv != EXR_ERR_SUCCESS) {
+        m_ctxt = nullptr;
+        if (!post_errors())
+            m_userdata->m_img->errorfmt("Could not open \"{}\" for writing",
+                                        name);
+        return false;
+    }
+
+    static const char* required[] = { "channels",
+                                      "chunkCount",
+                                      "compression",
+                                      "dataWindow",
+                                      "displayWindow",
+                                      "lineOrder",
+                                      "name",
+                                      "pixelAspectRatio",
+                                      "screenWindowCenter",
+                                      "screenWindowWidth",
+                                      "tiles",
+                                      "type",
+                                      "version" };
+
+    m_parts.resize(nparts);
+    for (int p = 0; p < nparts && rv == EXR_ERR_SUCCESS; ++p) {
+        const Imf::Header& h(headers[p]);
+        bool tiled = h.hasTileDescription();
+        int part   = -1;
+        rv = exr_add_part(m_ctxt, h.hasName() ? h.name().c_str() : nullptr,
+                          tiled ? EXR_STORAGE_TILED : EXR_STORAGE_SCANLINE,
+                          &part);
+        if (rv != EXR_ERR_SUCCESS)
+            break;
+
+        const Imath::Box2i& dw(h.dataWindow());
+        const Imath::Box2i& disp(h.displayWindow());
+        exr_attr_box2i_t dataw, dispw;
+        dataw.min.x = dw.min.x;
+        dataw.min.y = dw.min.y;
+        dataw.max.x = dw.max.x;
+        dataw.max.y = dw.max.y;
+        dispw.min.x = disp.min.x;
+        dispw.min.y = disp.min.y;
+        dispw.max.x = disp.max.x;
+        dispw.max.y = disp.max.y;
+        exr_attr_v2f_t swc;
+        swc.x = h.screenWindowCenter().x;
+        swc.y = h.screenWindowCenter().y;
+        rv = exr_initialize_required_attr(m_ctxt, part, &dispw, &dataw,
+                                          h.pixelAspectRatio(), &swc,
+                                          h.screenWindowWidth(),
+                                          EXR_LINEORDER_INCREASING_Y,
+                                          exr_compression_t(h.compression()));
+        for (auto c = h.channels().begin();
+             c != h.channels().end() && rv == EXR_ERR_SUCCESS; ++c) {
+            const Imf::Channel& ch(c.channel());
+            rv = exr_add_channel(m_ctxt, part, c.name(),
+                                 exr_pixel_type_t(ch.type),
+                                 ch.pLinear ? EXR_PERCEPTUALLY_LINEAR
+                                            : EXR_PERCEPTUALLY_LOGARITHMIC,
+                                 ch.xSampling, ch.ySampling);
+        }
+        if (tiled && rv == EXR_ERR_SUCCESS) {
+            const Imf::TileDescription& td(h.tileDescription());
+            rv = exr_set_tile_descriptor(m_ctxt, part, td.xSize, td.ySize,
+                                         exr_tile_level_mode_t(td.mode),
+                                         exr_tile_round_mode_t(
+                                             td.roundingMode));
+        }
+#if OPENEXR_CODED_VERSION >= 30103
+        if (rv == EXR_ERR_SUCCESS)
+            rv = exr_set_zip_compression_level(m_ctxt, part,
+                                               h.zipCompressionLevel());
+        if (rv == EXR_ERR_SUCCESS)
+            rv = exr_set_dwa_compression_level(m_ctxt, part,
+                                               h.dwaCompressionLevel());
+#endif
+        for (auto a = h.begin(); a != h.end() && rv == EXR_ERR_SUCCESS; ++a) {
+            if (std::find_if(std::begin(required), std::end(required),
+                             [&](const char* r) {
+                                 return !strcmp(r, a.name());
+                             })
+                != std::end(required))
+                continue;
+            rv = put_core_attribute(m_ctxt, part, a.name(), a.attribute());
+        }
+
+        PartInfo& info(m_parts[p]);
+        info.tiled = tiled;
+        info.chanoffset.clear();
+        info.chanbytes.clear();
+        size_t offset = 0;
+        for (int c = 0; c < specs[p].nchannels; ++c) {
+            info.channames.push_back(specs[p].channelnames[c]);
+            info.chanoffset.push_back(offset);
+            info.chanbytes.push_back(specs[p].channelformat(c).size());
+            offset += info.chanbytes.back();
+        }
+        info.pixelbytes = offset;
+    }
+    if (rv == EXR_ERR_SUCCESS)
+        rv = exr_write_header(m_ctxt);
+
+    for (int p = 0; p < nparts && rv == EXR_ERR_SUCCESS; ++p) {
+        PartInfo& info(m_parts[p]);
+        rv = exr_get_chunk_count(m_ctxt, p, &info.nchunks);
+        if (rv == EXR_ERR_SUCCESS && !info.tiled)
+            rv = exr_get_scanlines_per_chunk(m_ctxt, p, &info.scansperchunk);
+    }
+    if (rv != EXR_ERR_SUCCESS) {
+        exr_finish(&m_ctxt);
+        m_ctxt = nullptr;
+        if (!post_errors())
+            m_userdata->m_img->errorfmt("EXR Error ({}): {}", name,
+                                        exr_get_error_code_as_string(rv));
+        return false;
+    }
+    return true;
+}
+
+
+
+bool
+OpenEXRCoreWriter::write_scanlines(int part, const ImageSpec& spec,
+                                   int ybegin, int yend, const void* data,
+                                   stride_t xstride, stride_t ystride)
+{
+    if (!m_ctxt || part < 0 || part >= int(m_parts.size())) {
+        m_userdata->m_img->errorfmt("EXR write of scanlines to unopened part");
+        return false;
+    }
+    PartInfo& info(m_parts[part]);
+    const int spc         = info.scansperchunk;
+    const int ylast       = spec.y + spec.height;
+    const size_t linesize = size_t(spec.width) * info.pixelbytes;
+
+    // Sort the chunks touched by [ybegin,yend) into those we were given in
+    // full, which are encoded straight from the caller's buffer, and those
+    // we only have part of, whose lines are stashed until they're complete.
+    std::vector<Job> jobs;
+    for (int cy = spec.y + round_down_to_multiple(ybegin - spec.y, spc);
+         cy < yend; cy += spc) {
+        int cyend = std::min(cy + spc, ylast);
+        Job job;
+        job.part = part;
+        job.x    = 0;
+        job.y    = cy;
+        if (ybegin <= cy && yend >= cyend) {
+            job.data    = (const char*)data + (cy - ybegin) * ystride;
+            job.xstride = xstride;
+            job.ystride = ystride;
+        } else {
+            Partial& pending(info.partial[cy]);
+            if (pending.pixels.empty())
+                pending.pixels.resize(size_t(cyend - cy) * linesize);
+            for (int y = std::max(cy, ybegin); y < std::min(cyend, yend);
+                 ++y) {
+                char* dst       = pending.pixels.data() + (y - cy) * linesize;
+                const char* src = (const char*)data + (y - ybegin) * ystride;
+                if (xstride == stride_t(info.pixelbytes))
+                    memcpy(dst, src, linesize);
+                else
+                    for (int x = 0; x < spec.width; ++x)
+                        memcpy(dst + x * info.pixelbytes, src + x * xstride,
+                               info.pixelbytes);
+                ++pending.nlines;
+            }
+            if (pending.nlines < cyend - cy)
+                continue;
+            job.owned   = std::move(pending.pixels);
+            job.data    = job.owned.data();
+            job.xstride = stride_t(info.pixelbytes);
+            job.ystride = stride_t(linesize);
+            info.partial.erase(cy);
+        }
+        jobs.push_back(std::move(job));
+    }
+    return run_jobs(jobs);
+}
+
+
+
+bool
+OpenEXRCoreWriter::write_tiles(int part, int miplevel, const ImageSpec& spec,
+                               int xbegin, int xend, int ybegin, int yend,
+                               const void* data, stride_t xstride,
+                               stride_t ystride)
+{
+    if (!m_ctxt || part < 0 || part >= int(m_parts.size())) {
+        m_userdata->m_img->errorfmt("EXR write of tiles to unopened part");
+        return false;
+    }
+    // Every tile is its own chunk. Edge tiles are clipped to the data
+    // window by the library, so no padding copy is needed.
+    std::vector<Job> jobs;
+    for (int y = ybegin; y < yend; y += spec.tile_height) {
+        for (int x = xbegin; x < xend; x += spec.tile_width) {
+            Job job;
+            job.part    = part;
+            job.tiled   = true;
+            job.level   = miplevel;
+            job.x       = (x - spec.x) / spec.tile_width;
+            job.y       = (y - spec.y) / spec.tile_height;
+            job.data    = (const char*)data + (y - ybegin) * ystride
+                       + (x - xbegin) * xstride;
+            job.xstride = xstride;
+            job.ystride = ystride;
+            jobs.push_back(std::move(job));
+        }
+    }
+    return run_jobs(jobs);
+}
+
+
+
+bool
+OpenEXRCoreWriter::run_jobs(std::vector<Job>& jobs)
+{
+    if (jobs.empty())
+        return true;
+
+    // Chunk info queries touch the context's chunk table, so do them up
+    // front, serially. Everything after that only reads the context.
+    std::vector<exr_chunk_info_t> cinfo(jobs.size());
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        const Job& job(jobs[j]);
+        exr_result_t rv
+            = job.tiled ? exr_write_tile_chunk_info(m_ctxt, job.part, job.x,
+                                                    job.y, job.level,
+                                                    job.level, &cinfo[j])
+                        : exr_write_scanline_chunk_info(m_ctxt, job.part,
+                                                        job.y, &cinfo[j]);
+        if (rv != EXR_ERR_SUCCESS) {
+            if (!post_errors()) {
+                if (job.tiled)
+                    m_userdata->m_img->errorfmt(
+                        "EXR Error: could not locate tile ({}, {}) of level {} in part {}: {}",
+                        job.x, job.y, job.level, job.part,
+                        exr_get_error_code_as_string(rv));
+                else
+                    m_userdata->m_img->errorfmt(
+                        "EXR Error: could not locate scanline {} in part {}: {}",
+                        job.y, job.part, exr_get_error_code_as_string(rv));
+            }
+            return false;
+        }
+    }
+
+    // Hand the jobs to the pool a window at a time, a few per thread. The
+    // window is written out before the next one starts, so the reorder
+    // buffer never holds more than one window's worth of encoded chunks
+    // for chunks written in order.
+    int nthreads = m_userdata->m_img->threads();
+    if (nthreads <= 0)
+        nthreads = default_thread_pool()->size() + 1;
+    const size_t window = size_t(4 * nthreads);
+    std::atomic<bool> ok(true);
+    for (size_t wbegin = 0; wbegin < jobs.size() && ok; wbegin += window) {
+        size_t wend = std::min(wbegin + window, jobs.size());
+        parallel_for_chunked(
+            int64_t(wbegin), int64_t(wend), 1,
+            [&](int64_t b, int64_t e) {
+                for (int64_t j = b; j < e && ok; ++j)
+                    if (!encode(jobs[j], cinfo[j]))
+                        ok = false;
+            },
+            paropt(nthreads));
+    }
+    if (post_errors())
+        ok = false;
+    else if (!ok)
+        m_userdata->m_img->errorfmt("EXR Error ({}): could not write chunks",
+                                    m_userdata->m_io
+                                        ? m_userdata->m_io->filename()
+                                        : std::string());
+    return ok;
+}
+
+
+
+bool
+OpenEXRCoreWriter::encode(const Job& job, exr_chunk_info_t& cinfo)
+{
+    const PartInfo& info(m_parts[job.part]);
+    std::unique_ptr<Chunk> chunk(new Chunk);
+    chunk->part  = job.part;
+    chunk->index = int(cinfo.idx);
+    chunk->x     = job.x;
+    chunk->y     = job.y;
+    chunk->level = job.level;
+    chunk->tiled = job.tiled;
+
+    exr_encode_pipeline_t encoder = EXR_ENCODE_PIPELINE_INITIALIZER;
+    exr_result_t rv = exr_encoding_initialize(m_ctxt, job.part, &cinfo,
+                                              &encoder);
+    if (rv == EXR_ERR_SUCCESS) {
+        for (int dc = 0; dc < encoder.channel_count; ++dc) {
+            exr_coding_channel_info_t& ch(encoder.channels[dc]);
+            for (size_t c = 0; c < info.channames.size(); ++c) {
+                if (info.channames[c] != ch.channel_name)
+                    continue;
+                ch.encode_from_ptr = (const uint8_t*)job.data
+                                     + info.chanoffset[c];
+                ch.user_pixel_stride      = int32_t(job.xstride);
+                ch.user_line_stride       = int32_t(job.ystride);
+                ch.user_bytes_per_element = ch.bytes_per_element;
+                ch.user_data_type         = ch.data_type;
+                break;
+            }
+        }
+        rv = exr_encoding_choose_default_routines(m_ctxt, job.part,
+                                                  &encoder);
+    }
+    if (rv == EXR_ERR_SUCCESS) {
+        encoder.write_fn           = &oiio_exr_capture_chunk;
+        encoder.encoding_user_data = chunk.get();
+        rv = exr_encoding_run(m_ctxt, job.part, &encoder);
+    }
+    exr_encoding_destroy(m_ctxt, &encoder);
+    return rv == EXR_ERR_SUCCESS && submit(std::move(chunk));
+}
+
+
+
+bool
+OpenEXRCoreWriter::submit(std::unique_ptr<Chunk> chunk)
+{
+    // The file's chunks must go out in order. Park this one in the reorder
+    // buffer, then write out whatever run of chunks is now ready.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ready[std::make_pair(chunk->part, chunk->index)] = std::move(chunk);
+    while (m_next_part < int(m_parts.size())) {
+        auto found = m_ready.find(std::make_pair(m_next_part, m_next_chunk));
+        if (found == m_ready.end())
+            break;
+        const Chunk& c(*found->second);
+        exr_result_t rv
+            = c.tiled ? exr_write_tile_chunk(m_ctxt, c.part, c.x, c.y, c.level,
+                                             c.level, c.bytes.data(),
+                                             c.bytes.size())
+                      : exr_write_scanline_chunk(m_ctxt, c.part, c.y,
+                                                 c.bytes.data(),
+                                                 c.bytes.size());
+        m_ready.erase(found);
+        if (rv != EXR_ERR_SUCCESS)
+            return false;
+        if (++m_next_chunk >= m_parts[m_next_part].nchunks) {
+            ++m_next_part;
+            m_next_chunk = 0;
+        }
+    }
+    return true;
+}
+
+
+
+bool
+OpenEXRCoreWriter::complete() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_next_part >= int(m_parts.size());
+}
+
+
+
+bool
+OpenEXRCoreWriter::finish()
+{
+    if (!m_ctxt)
+        return true;
+    bool ok = true;
+    if (!complete()) {
+        m_userdata->m_img->errorfmt(
+            "EXR file \"{}\" is incomplete: not all scanlines or tiles were written",
+            m_userdata->m_io ? m_userdata->m_io->filename() : std::string());
+        ok = false;
+    }
+    ok &= (exr_finish(&m_ctxt) == EXR_ERR_SUCCESS);
+    m_ctxt = nullptr;
+    if (post_errors())
+        ok = false;
+    m_ready.clear();
+    m_parts.clear();
+    return ok;
+}
+
+OIIO_PLUGIN_NAMESPACE_END
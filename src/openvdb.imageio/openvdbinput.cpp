@@ -211,11 +211,23 @@ template<typename GridType> struct VDBReader {
             if (bbox.min().x() != x || bbox.min().y() != y
                 || bbox.min().z() != z || bbox.dim() != Coord(LeafType::DIM))
                 return false;  // unaligned or unexpected tile dimensions
+            // A leaf holding a single value is filled the same way as a
+            // tile node, with no dense copy. The ImageCache then stores
+            // it, like any uniform tile, as that one value.
+            ValueType value;
+            bool state;
+            if (leaf->isConstant(value, state)) {
+                setTile(values, value);
+                return true;
+            }
             // Have OpenVDB fill the dense block, into the values pointer
             DenseT dense(bbox, values);
             leaf->copyToDense(bbox, dense);
-        } else
+        } else {
+            // Empty space and tile nodes have one value over the whole
+            // leaf-sized region.
             setTile(values, cache.getValue(xyz));
+        }
         return true;
     }
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <libpng16/png.h>
 #include <zlib.h>
 
@@ -13,6 +15,7 @@
 #include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/fmath.h>
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/parallel.h>
 #include <OpenImageIO/strutil.h>
 #include <OpenImageIO/sysutil.h>
 #include <OpenImageIO/tiffutils.h>
@@ -853,6 +856,469 @@ destroy_write_struct(png_structp& sp, png_infop& ip)
 }
 
 
+
+// The remainder of this file implements the parallel encode and decode
+// paths used by the PNG reader and writer for large images. libpng (and
+// zlib underneath it) is strictly serial, so instead we do the row
+// filtering and deflate ourselves and only rely on libpng for the header
+// chunks:
+//
+// * Encoding splits the image into bands of rows. Each band is filtered
+//   and deflated independently as a raw deflate stream that is primed with
+//   the last 32KB of the previous band (so compression barely suffers) and
+//   ended with a sync flush, exactly like pigz does. Concatenating them,
+//   with a zlib header in front and the combined adler32 at the end, gives
+//   one valid zlib stream that we emit as IDAT chunks.
+// * Decoding must inflate serially, but undoing the row filters can be
+//   split at any row whose filter is NONE or SUB, because those don't
+//   refer to the previous row. Our encoder always starts a band with one
+//   of those two filters (when allowed) to make its files decode in
+//   parallel.
+
+/// Approximate number of bytes of unfiltered pixel data per band for the
+/// parallel encoder. Band boundaries depend only on the image dimensions,
+/// never the thread count, so the output is deterministic.
+constexpr size_t parallel_band_bytes = 256 * 1024;
+
+/// Maximum payload size of the IDAT chunks we write ourselves.
+constexpr size_t idat_chunk_size = 1024 * 1024;
+
+
+
+/// Translate a "png:filter" value, with the same semantics as
+/// png_set_filter(), into a mask of PNG_FILTER_* flags.
+inline int
+filter_mask(int filters)
+{
+    switch (filters & (PNG_ALL_FILTERS | 0x07)) {
+    case PNG_FILTER_VALUE_SUB: return PNG_FILTER_SUB;
+    case PNG_FILTER_VALUE_UP: return PNG_FILTER_UP;
+    case PNG_FILTER_VALUE_AVG: return PNG_FILTER_AVG;
+    case PNG_FILTER_VALUE_PAETH: return PNG_FILTER_PAETH;
+    default: break;
+    }
+    filters &= PNG_ALL_FILTERS;
+    return filters ? filters : PNG_FILTER_NONE;
+}
+
+
+
+inline int
+paeth_predictor(int a, int b, int c)
+{
+    int p  = a + b - c;
+    int pa = std::abs(p - a);
+    int pb = std::abs(p - b);
+    int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc)
+        return a;
+    return (pb <= pc) ? b : c;
+}
+
+
+
+/// Apply PNG filter `type` (a PNG_FILTER_VALUE_*) to the row `cur`,
+/// storing the result in `out`. `prev` is the previous unfiltered row
+/// (all zeroes for the first row of the image), `bpp` the number of bytes
+/// per complete pixel.
+inline void
+filter_row(int type, const unsigned char* cur, const unsigned char* prev,
+           size_t rowbytes, size_t bpp, unsigned char* out)
+{
+    switch (type) {
+    case PNG_FILTER_VALUE_SUB:
+        for (size_t i = 0; i < bpp; ++i)
+            out[i] = cur[i];
+        for (size_t i = bpp; i < rowbytes; ++i)
+            out[i] = cur[i] - cur[i - bpp];
+        break;
+    case PNG_FILTER_VALUE_UP:
+        for (size_t i = 0; i < rowbytes; ++i)
+            out[i] = cur[i] - prev[i];
+        break;
+    case PNG_FILTER_VALUE_AVG:
+        for (size_t i = 0; i < bpp; ++i)
+            out[i] = cur[i] - (prev[i] >> 1);
+        for (size_t i = bpp; i < rowbytes; ++i)
+            out[i] = cur[i] - ((int(cur[i - bpp]) + int(prev[i])) >> 1);
+        break;
+    case PNG_FILTER_VALUE_PAETH:
+        for (size_t i = 0; i < bpp; ++i)
+            out[i] = cur[i] - prev[i];
+        for (size_t i = bpp; i < rowbytes; ++i)
+            out[i] = cur[i]
+                     - paeth_predictor(cur[i - bpp], prev[i], prev[i - bpp]);
+        break;
+    default: memcpy(out, cur, rowbytes); break;
+    }
+}
+
+
+
+/// Undo PNG filter `type` for one row: `in` is the filtered row, `prev`
+/// the previous reconstructed row (all zeroes for the first row), and the
+/// reconstructed row is written to `out`.
+inline bool
+unfilter_row(int type, const unsigned char* in, const unsigned char* prev,
+             size_t rowbytes, size_t bpp, unsigned char* out)
+{
+    switch (type) {
+    case PNG_FILTER_VALUE_NONE: memcpy(out, in, rowbytes); break;
+    case PNG_FILTER_VALUE_SUB:
+        for (size_t i = 0; i < bpp; ++i)
+            out[i] = in[i];
+        for (size_t i = bpp; i < rowbytes; ++i)
+            out[i] = in[i] + out[i - bpp];
+        break;
+    case PNG_FILTER_VALUE_UP:
+        for (size_t i = 0; i < rowbytes; ++i)
+            out[i] = in[i] + prev[i];
+        break;
+    case PNG_FILTER_VALUE_AVG:
+        for (size_t i = 0; i < bpp; ++i)
+            out[i] = in[i] + (prev[i] >> 1);
+        for (size_t i = bpp; i < rowbytes; ++i)
+            out[i] = in[i] + ((int(out[i - bpp]) + int(prev[i])) >> 1);
+        break;
+    case PNG_FILTER_VALUE_PAETH:
+        for (size_t i = 0; i < bpp; ++i)
+            out[i] = in[i] + prev[i];
+        for (size_t i = bpp; i < rowbytes; ++i)
+            out[i] = in[i]
+                     + paeth_predictor(out[i - bpp], prev[i], prev[i - bpp]);
+        break;
+    default: return false;  // corrupt filter type
+    }
+    return true;
+}
+
+
+
+/// Filter one row with the best of the filters allowed by `mask`, using
+/// libpng's heuristic of the minimum sum of absolute (signed) differences.
+/// The filtered row goes into `out`, `scratch` must have `rowbytes` of
+/// space, and the PNG_FILTER_VALUE_* that was chosen is returned.
+inline int
+filter_row_best(int mask, const unsigned char* cur, const unsigned char* prev,
+                size_t rowbytes, size_t bpp, unsigned char* out,
+                unsigned char* scratch)
+{
+    int best          = -1;
+    uint64_t bestcost = 0;
+    for (int type = PNG_FILTER_VALUE_NONE; type < PNG_FILTER_VALUE_LAST;
+         ++type) {
+        if (!(mask & (PNG_FILTER_NONE << type)))
+            continue;
+        if (best < 0 && !(mask & ~(PNG_FILTER_NONE << type))) {
+            // Only one filter allowed -- no need to evaluate the cost
+            filter_row(type, cur, prev, rowbytes, bpp, out);
+            return type;
+        }
+        filter_row(type, cur, prev, rowbytes, bpp, scratch);
+        uint64_t cost = 0;
+        for (size_t i = 0; i < rowbytes; ++i)
+            cost += scratch[i] < 128 ? scratch[i] : 256 - scratch[i];
+        if (best < 0 || cost < bestcost) {
+            best     = type;
+            bestcost = cost;
+            memcpy(out, scratch, rowbytes);
+        }
+    }
+    return best;
+}
+
+
+
+/// Filter and deflate a whole image of `height` rows of `rowbytes` bytes
+/// each (already in PNG byte order), storing the complete zlib stream that
+/// makes up the IDAT payload in `zdata`. Bands of rows are filtered and
+/// compressed concurrently. Return false upon a zlib error.
+inline bool
+compress_image_parallel(const unsigned char* pixels, int height,
+                        size_t rowbytes, size_t bpp, int filters, int level,
+                        int strategy, std::vector<unsigned char>& zdata,
+                        int nthreads = 0)
+{
+    const size_t frowbytes = rowbytes + 1;
+    const int band_rows    = std::max(1, int(parallel_band_bytes / rowbytes));
+    const int nbands       = (height + band_rows - 1) / band_rows;
+    const int mask         = filter_mask(filters);
+    const int rowstart_mask = mask & (PNG_FILTER_NONE | PNG_FILTER_SUB);
+    std::vector<unsigned char> filtered(size_t(height) * frowbytes);
+    std::vector<std::vector<unsigned char>> bandout(nbands);
+    std::vector<uLong> bandadler(nbands);
+    std::atomic<bool> ok(true);
+
+    // Filter all the rows. A band's first row is restricted to the filters
+    // that don't look at the previous row, if any of those are allowed.
+    parallel_for_chunked(
+        0, nbands, 1,
+        [&](int64_t bbegin, int64_t bend) {
+            std::vector<unsigned char> scratch(rowbytes);
+            std::vector<unsigned char> zerorow(rowbytes, 0);
+            for (int64_t b = bbegin; b < bend; ++b) {
+                int ybegin = int(b) * band_rows;
+                int yend   = std::min(height, ybegin + band_rows);
+                for (int y = ybegin; y < yend; ++y) {
+                    const unsigned char* cur  = pixels + size_t(y) * rowbytes;
+                    const unsigned char* prev = y ? cur - rowbytes
+                                                  : zerorow.data();
+                    int m = (y == ybegin && rowstart_mask) ? rowstart_mask
+                                                           : mask;
+                    unsigned char* out = &filtered[size_t(y) * frowbytes];
+                    out[0] = (unsigned char)filter_row_best(m, cur, prev,
+                                                            rowbytes, bpp,
+                                                            out + 1,
+                                                            scratch.data());
+                }
+            }
+        },
+        paropt(nthreads));
+
+    // Deflate each band as a raw deflate stream, primed with the tail end
+    // of the previous band as its dictionary. All but the last end with a
+    // sync flush so that they may simply be concatenated.
+    parallel_for_chunked(
+        0, nbands, 1,
+        [&](int64_t bbegin, int64_t bend) {
+            for (int64_t b = bbegin; b < bend && ok; ++b) {
+                size_t begin       = size_t(b) * band_rows * frowbytes;
+                size_t end         = std::min(filtered.size(),
+                                              begin + band_rows * frowbytes);
+                const Bytef* in    = filtered.data() + begin;
+                uInt inlen         = uInt(end - begin);
+                bandadler[b]       = adler32(adler32(0L, Z_NULL, 0), in, inlen);
+                z_stream strm      = {};
+                if (deflateInit2(&strm, level, Z_DEFLATED, -MAX_WBITS, 8,
+                                 strategy)
+                    != Z_OK) {
+                    ok = false;
+                    return;
+                }
+                if (b > 0) {
+                    uInt dictlen = uInt(std::min(begin, size_t(32768)));
+                    deflateSetDictionary(&strm, in - dictlen, dictlen);
+                }
+                std::vector<unsigned char>& out(bandout[b]);
+                out.resize(deflateBound(&strm, inlen) + 16);
+                strm.next_in   = const_cast<Bytef*>(in);
+                strm.avail_in  = inlen;
+                strm.next_out  = out.data();
+                strm.avail_out = uInt(out.size());
+                int flush      = (b == nbands - 1) ? Z_FINISH : Z_SYNC_FLUSH;
+                for (;;) {
+                    int r = deflate(&strm, flush);
+                    if (r == Z_STREAM_ERROR) {
+                        ok = false;
+                        break;
+                    }
+                    if (strm.avail_out != 0)
+                        break;  // all input consumed and flushed
+                    size_t used = out.size();
+                    out.resize(2 * used);
+                    strm.next_out  = out.data() + used;
+                    strm.avail_out = uInt(used);
+                }
+                out.resize(out.size() - strm.avail_out);
+                deflateEnd(&strm);
+            }
+        },
+        paropt(nthreads));
+    if (!ok)
+        return false;
+
+    // Assemble: zlib header, the band streams, then the combined adler32.
+    // The header's FLEVEL field is purely informational, but match what
+    // zlib itself would have written for this level and strategy.
+    int lev        = (level == Z_DEFAULT_COMPRESSION) ? 6 : level;
+    int levelflags = (strategy >= Z_HUFFMAN_ONLY || lev < 2) ? 0
+                     : lev < 6                               ? 1
+                     : lev == 6                              ? 2
+                                                             : 3;
+    unsigned int header = (0x78 << 8) | (levelflags << 6);
+    header += 31 - (header % 31);
+    size_t total = 6;
+    for (auto& b : bandout)
+        total += b.size();
+    zdata.clear();
+    zdata.reserve(total);
+    zdata.push_back((unsigned char)(header >> 8));
+    zdata.push_back((unsigned char)(header & 0xff));
+    uLong adler = adler32(0L, Z_NULL, 0);
+    for (int b = 0; b < nbands; ++b) {
+        zdata.insert(zdata.end(), bandout[b].begin(), bandout[b].end());
+        size_t begin = size_t(b) * band_rows * frowbytes;
+        size_t len   = std::min(filtered.size() - begin, band_rows * frowbytes);
+        adler        = adler32_combine(adler, bandadler[b], z_off_t(len));
+    }
+    for (int shift = 24; shift >= 0; shift -= 8)
+        zdata.push_back((unsigned char)(adler >> shift));
+    return true;
+}
+
+
+
+/// Append a complete PNG chunk (length, type, data, CRC) to `out`.
+inline void
+append_chunk(std::vector<unsigned char>& out, const char* type,
+             const unsigned char* data, size_t len)
+{
+    auto put32 = [&](uint32_t v) {
+        for (int shift = 24; shift >= 0; shift -= 8)
+            out.push_back((unsigned char)(v >> shift));
+    };
+    put32(uint32_t(len));
+    size_t typepos = out.size();
+    out.insert(out.end(), type, type + 4);
+    if (len)
+        out.insert(out.end(), data, data + len);
+    put32(uint32_t(crc32(crc32(0L, Z_NULL, 0), &out[typepos], uInt(4 + len))));
+}
+
+
+
+/// Scan the chunks of a PNG file, and if it is a non-interlaced 8- or
+/// 16-bit gray or RGB image (with or without alpha) lacking any tRNS chunk
+/// -- that is, one for which libpng would apply no transformations -- then
+/// gather its concatenated IDAT payload into `zdata` and return true.
+inline bool
+read_idat_stream(Filesystem::IOProxy* io, std::vector<unsigned char>& zdata,
+                 int& bit_depth, int& color_type)
+{
+    if (!io)
+        return false;
+    uint64_t filesize = io->size();
+    uint64_t offset   = 8;  // skip the signature
+    bool seen_ihdr    = false;
+    zdata.clear();
+    while (offset + 12 <= filesize) {
+        unsigned char hdr[8];
+        if (io->pread(hdr, 8, offset) != 8)
+            return false;
+        uint64_t len = (uint64_t(hdr[0]) << 24) | (uint64_t(hdr[1]) << 16)
+                       | (uint64_t(hdr[2]) << 8) | uint64_t(hdr[3]);
+        if (len > 0x7fffffff || offset + 12 + len > filesize)
+            return false;
+        string_view type((const char*)hdr + 4, 4);
+        if (type == "IHDR") {
+            unsigned char ihdr[13];
+            if (len != 13 || io->pread(ihdr, 13, offset + 8) != 13)
+                return false;
+            bit_depth      = ihdr[8];
+            color_type     = ihdr[9];
+            int interlace  = ihdr[12];
+            if ((bit_depth != 8 && bit_depth != 16) || interlace != 0
+                || (color_type != PNG_COLOR_TYPE_GRAY
+                    && color_type != PNG_COLOR_TYPE_GRAY_ALPHA
+                    && color_type != PNG_COLOR_TYPE_RGB
+                    && color_type != PNG_COLOR_TYPE_RGB_ALPHA))
+                return false;
+            seen_ihdr = true;
+        } else if (type == "tRNS") {
+            return false;  // libpng would expand this to an alpha channel
+        } else if (type == "IDAT") {
+            size_t pos = zdata.size();
+            zdata.resize(pos + len);
+            if (io->pread(zdata.data() + pos, len, offset + 8) != len)
+                return false;
+        } else if (type == "IEND") {
+            break;
+        }
+        offset += 12 + len;
+    }
+    return seen_ihdr && zdata.size();
+}
+
+
+
+/// Inflate the IDAT payload `zdata` and undo the row filters, storing the
+/// `height` reconstructed rows of `rowbytes` bytes each in `buffer`, with
+/// 16-bit samples swapped to native byte order. Inflation is inherently
+/// serial, but runs of rows beginning with a NONE or SUB filtered row are
+/// unfiltered concurrently. Return false if the data is not as expected.
+inline bool
+decompress_image_parallel(const std::vector<unsigned char>& zdata, int height,
+                          size_t rowbytes, size_t bpp, bool swap16,
+                          unsigned char* buffer, int nthreads = 0)
+{
+    const size_t frowbytes = rowbytes + 1;
+    std::vector<unsigned char> filtered(size_t(height) * frowbytes);
+    z_stream strm = {};
+    if (inflateInit(&strm) != Z_OK)
+        return false;
+    const size_t maxpiece = size_t(1) << 30;  // zlib counts are uInt
+    size_t inpos = 0, outpos = 0;
+    for (;;) {
+        if (strm.avail_in == 0) {
+            uInt n        = uInt(std::min(zdata.size() - inpos, maxpiece));
+            strm.next_in  = const_cast<Bytef*>(zdata.data() + inpos);
+            strm.avail_in = n;
+            inpos += n;
+        }
+        if (strm.avail_out == 0) {
+            uInt n         = uInt(std::min(filtered.size() - outpos, maxpiece));
+            strm.next_out  = filtered.data() + outpos;
+            strm.avail_out = n;
+            outpos += n;
+        }
+        int r = inflate(&strm, Z_NO_FLUSH);
+        if (r == Z_STREAM_END)
+            break;
+        if (r != Z_OK) {  // corrupt, truncated, or too much data
+            inflateEnd(&strm);
+            return false;
+        }
+    }
+    size_t produced = outpos - strm.avail_out;
+    inflateEnd(&strm);
+    if (produced != filtered.size())
+        return false;
+
+    // Find the rows where unfiltering can start independently, and group
+    // them into runs of a reasonable size to hand to the thread pool.
+    const int minrows = std::max(16, height / 256);
+    std::vector<int> runstart;
+    for (int y = 0; y < height; ++y) {
+        int type = filtered[size_t(y) * frowbytes];
+        if (type >= PNG_FILTER_VALUE_LAST)
+            return false;
+        if (y == 0
+            || ((type == PNG_FILTER_VALUE_NONE
+                 || type == PNG_FILTER_VALUE_SUB)
+                && y - runstart.back() >= minrows))
+            runstart.push_back(y);
+    }
+    runstart.push_back(height);
+
+    std::atomic<bool> ok(true);
+    parallel_for_chunked(
+        0, int64_t(runstart.size()) - 1, 1,
+        [&](int64_t rbegin, int64_t rend) {
+            std::vector<unsigned char> zerorow(rowbytes, 0);
+            for (int64_t r = rbegin; r < rend; ++r) {
+                for (int y = runstart[r]; y < runstart[r + 1]; ++y) {
+                    const unsigned char* in = &filtered[size_t(y) * frowbytes];
+                    unsigned char* out      = buffer + size_t(y) * rowbytes;
+                    const unsigned char* prev = y ? out - rowbytes
+                                                  : zerorow.data();
+                    if (!unfilter_row(in[0], in + 1, prev, rowbytes, bpp,
+                                      out))
+                        ok = false;
+                }
+                // Swap only once the whole run is done, since each row is
+                // the predictor for the next.
+                if (swap16) {
+                    for (int y = runstart[r]; y < runstart[r + 1]; ++y)
+                        swap_endian((uint16_t*)(buffer + size_t(y) * rowbytes),
+                                    int(rowbytes / 2));
+                }
+            }
+        },
+        paropt(nthreads));
+    return ok;
+}
+
+
 }  // namespace PNG_pvt
 
 OIIO_PLUGIN_NAMESPACE_END
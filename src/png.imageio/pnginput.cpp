@@ -39,6 +39,8 @@ public:
     }
     bool read_native_scanline(int subimage, int miplevel, int y, int z,
                               void* data) override;
+    bool read_native_scanlines(int subimage, int miplevel, int ybegin, int yend,
+                               int z, void* data) override;
 
 private:
     std::string m_filename;            ///< Stash the filename
@@ -53,6 +55,7 @@ private:
     int m_next_scanline;
     bool m_keep_unassociated_alpha;  ///< Do not convert unassociated alpha
     bool m_linear_premult;           ///< Do premult for sRGB images in linear
+    bool m_multithread;              ///< Allow parallel whole-image decode
     bool m_srgb   = false;           ///< It's an sRGB image (not gamma)
     bool m_err    = false;
     float m_gamma = 1.0f;
@@ -69,6 +72,7 @@ private:
         m_next_scanline           = 0;
         m_keep_unassociated_alpha = false;
         m_linear_premult = OIIO::get_int_attribute("png:linear_premult");
+        m_multithread    = OIIO::get_int_attribute("png:multithread");
         m_srgb           = false;
         m_err            = false;
         m_gamma          = 1.0;
@@ -80,6 +84,12 @@ private:
     ///
     bool readimg();
 
+    /// Helper function: read the whole image into m_buf, bypassing libpng
+    /// and undoing the row filters in parallel. Return false (without
+    /// registering an error) if the file isn't suitable, in which case the
+    /// caller should fall back to reading through libpng.
+    bool readimg_parallel();
+
     /// Extract the background color.
     ///
     bool get_background(float* red, float* green, float* blue);
@@ -213,6 +223,9 @@ PNGInput::open(const std::string& name, ImageSpec& newspec,
     m_linear_premult = config.get_int_attribute("png:linear_premult",
                                                 OIIO::get_int_attribute(
                                                     "png:linear_premult"));
+    m_multithread    = config.get_int_attribute("png:multithread",
+                                             OIIO::get_int_attribute(
+                                                 "png:multithread"));
     ioproxy_retrieve_from_config(config);
     m_config.reset(new ImageSpec(config));  // save config spec
     return open(name, newspec);
@@ -236,6 +249,37 @@ PNGInput::readimg()
 
 
 
+bool
+PNGInput::readimg_parallel()
+{
+    if (!m_multithread || threads() == 1)
+        return false;
+    std::vector<unsigned char> zdata;
+    int bit_depth = 0, color_type = 0;
+    if (!PNG_pvt::read_idat_stream(ioproxy(), zdata, bit_depth, color_type))
+        return false;
+    // Sanity check that what we found agrees with what libpng told us.
+    int nchannels = color_type == PNG_COLOR_TYPE_GRAY         ? 1
+                    : color_type == PNG_COLOR_TYPE_GRAY_ALPHA ? 2
+                    : color_type == PNG_COLOR_TYPE_RGB        ? 3
+                                                              : 4;
+    if (nchannels != m_spec.nchannels
+        || size_t(bit_depth) != 8 * m_spec.format.size())
+        return false;
+
+    std::vector<unsigned char> buf(m_spec.image_bytes());
+    bool swap16 = (bit_depth == 16 && littleendian());
+    if (!PNG_pvt::decompress_image_parallel(zdata, m_spec.height,
+                                            m_spec.scanline_bytes(),
+                                            m_spec.pixel_bytes(), swap16,
+                                            buf.data(), threads()))
+        return false;
+    m_buf.swap(buf);
+    return true;
+}
+
+
+
 bool
 PNGInput::close()
 {
@@ -309,12 +353,13 @@ PNGInput::read_native_scanline(int subimage, int miplevel, int y, int /*z*/,
     if (y < 0 || y >= m_spec.height)  // out of range scanline
         return false;
 
-    if (m_interlace_type != 0) {
+    if (m_interlace_type != 0 && m_buf.empty()) {
         // Interlaced.  Punt and read the whole image
-        if (m_buf.empty()) {
-            if (has_error() || !readimg())
-                return false;
-        }
+        if (has_error() || !readimg())
+            return false;
+    }
+    if (!m_buf.empty()) {
+        // Whole image already in memory
         size_t size = spec().scanline_bytes();
         memcpy(data, &m_buf[0] + y * size, size);
     } else {
@@ -362,4 +407,27 @@ PNGInput::read_native_scanline(int subimage, int miplevel, int y, int /*z*/,
     return true;
 }
 
+
+
+
+bool
+PNGInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
+                                int yend, int z, void* data)
+{
+    lock_guard lock(*this);
+    if (!seek_subimage(subimage, miplevel))
+        return false;
+
+    // If we're asked for many scanlines of a non-interlaced image that we
+    // have not yet started reading row by row, try decoding the whole
+    // image at once with the parallel path. If that isn't possible, just
+    // quietly fall back to libpng one row at a time.
+    if (m_buf.empty() && m_interlace_type == 0 && m_next_scanline == 0
+        && yend - ybegin > 1)
+        readimg_parallel();
+
+    return ImageInput::read_native_scanlines(subimage, miplevel, ybegin, yend,
+                                             z, data);
+}
+
 OIIO_PLUGIN_NAMESPACE_END
@@ -48,9 +48,14 @@ private:
     bool m_convert_alpha;   ///< Do we deassociate alpha?
     bool m_need_swap;       ///< Do we need to swap bytes?
     bool m_linear_premult;  ///< Do premult for sRGB images in linear
-    bool m_srgb   = false;  ///< It's an sRGB image (not gamma)
-    float m_gamma = 1.0f;   ///< Gamma to use for alpha conversion
+    bool m_srgb     = false;  ///< It's an sRGB image (not gamma)
+    float m_gamma   = 1.0f;   ///< Gamma to use for alpha conversion
+    bool m_parallel = false;  ///< Buffer and compress in parallel on close?
+    int m_filters   = 0;      ///< Requested "png:filter"
+    int m_zlevel    = 6;      ///< zlib compression level
+    int m_zstrategy = Z_DEFAULT_STRATEGY;  ///< zlib compression strategy
     std::vector<unsigned char> m_scratch;
+    std::vector<unsigned char> m_pixels;  ///< Whole image, if m_parallel
     std::vector<png_text> m_pngtext;
     bool m_err = false;
 
@@ -65,7 +70,13 @@ private:
         m_srgb           = false;
         m_err            = false;
         m_gamma          = 1.0;
+        m_parallel       = false;
+        m_filters        = 0;
+        m_zlevel         = 6;
+        m_zstrategy      = Z_DEFAULT_STRATEGY;
         m_pngtext.clear();
+        m_pixels.clear();
+        m_pixels.shrink_to_fit();
         ioproxy_clear();
     }
 
@@ -94,6 +105,14 @@ private:
     template<class T>
     void deassociateAlpha(T* data, size_t npixels, int channels,
                           int alpha_channel, bool srgb, float gamma);
+
+    // Hand finished native rows (already in PNG byte order) either to
+    // libpng, or to the buffer for parallel compression.
+    bool write_native_rows(int ybegin, int nrows, png_byte* data);
+
+    // Compress the buffered image in parallel and write the IDAT and IEND
+    // chunks, bypassing libpng.
+    bool write_parallel_idat();
 };
 
 
@@ -157,34 +176,29 @@ PNGOutput::open(const std::string& name, const ImageSpec& userspec,
 
     png_set_write_fn(m_png, this, PngWriteCallback, PngFlushCallback);
 
-    png_set_compression_level(
-        m_png, std::max(std::min(m_spec.get_int_attribute(
+    m_zlevel = std::max(std::min(m_spec.get_int_attribute(
                                      "png:compressionLevel",
                                      6 /* medium speed vs size tradeoff */),
                                  Z_BEST_COMPRESSION),
-                        Z_NO_COMPRESSION));
+                        Z_NO_COMPRESSION);
+    m_zstrategy             = Z_DEFAULT_STRATEGY;
     std::string compression = m_spec.get_string_attribute("compression");
-    if (compression.empty()) {
-        png_set_compression_strategy(m_png, Z_DEFAULT_STRATEGY);
-    } else if (Strutil::iequals(compression, "default")) {
-        png_set_compression_strategy(m_png, Z_DEFAULT_STRATEGY);
-    } else if (Strutil::iequals(compression, "filtered")) {
-        png_set_compression_strategy(m_png, Z_FILTERED);
+    if (Strutil::iequals(compression, "filtered")) {
+        m_zstrategy = Z_FILTERED;
     } else if (Strutil::iequals(compression, "huffman")) {
-        png_set_compression_strategy(m_png, Z_HUFFMAN_ONLY);
+        m_zstrategy = Z_HUFFMAN_ONLY;
     } else if (Strutil::iequals(compression, "rle")) {
-        png_set_compression_strategy(m_png, Z_RLE);
+        m_zstrategy = Z_RLE;
     } else if (Strutil::iequals(compression, "fixed")) {
-        png_set_compression_strategy(m_png, Z_FIXED);
+        m_zstrategy = Z_FIXED;
     } else if (Strutil::iequals(compression, "pngfast")) {
-        png_set_compression_strategy(m_png, Z_DEFAULT_STRATEGY);
-        png_set_compression_level(m_png, Z_BEST_SPEED);
+        m_zlevel = Z_BEST_SPEED;
     } else if (Strutil::iequals(compression, "none")) {
-        png_set_compression_strategy(m_png, Z_NO_COMPRESSION);
-        png_set_compression_level(m_png, 0);
-    } else {
-        png_set_compression_strategy(m_png, Z_DEFAULT_STRATEGY);
+        m_zstrategy = Z_NO_COMPRESSION;
+        m_zlevel    = 0;
     }
+    png_set_compression_level(m_png, m_zlevel);
+    png_set_compression_strategy(m_png, m_zstrategy);
 
     m_need_swap = (m_spec.format == TypeDesc::UINT16 && littleendian());
 
@@ -192,8 +206,8 @@ PNGOutput::open(const std::string& name, const ImageSpec& userspec,
                                                 OIIO::get_int_attribute(
                                                     "png:linear_premult"));
 
-    png_set_filter(m_png, 0,
-                   spec().get_int_attribute("png:filter", PNG_NO_FILTERS));
+    m_filters = spec().get_int_attribute("png:filter", PNG_NO_FILTERS);
+    png_set_filter(m_png, 0, m_filters);
     // https://www.w3.org/TR/PNG-Encoders.html#E.Filter-selection
     // https://www.w3.org/TR/PNG-Rationale.html#R.Filtering
     // The official advice is to PNG_NO_FILTER for palette or < 8 bpp
@@ -236,6 +250,17 @@ PNGOutput::open(const std::string& name, const ImageSpec& userspec,
     m_convert_alpha = m_spec.alpha_channel != -1
                       && !m_spec.get_int_attribute("oiio:UnassociatedAlpha", 0);
 
+    // libpng compresses serially. For images big enough to span several
+    // bands, instead collect the pixels and do the filtering and deflate
+    // ourselves, in parallel, when the file is closed.
+    m_parallel = m_spec.get_int_attribute("png:multithread",
+                                          OIIO::get_int_attribute(
+                                              "png:multithread"))
+                 && threads() != 1
+                 && m_spec.image_bytes() > PNG_pvt::parallel_band_bytes;
+    if (m_parallel)
+        m_pixels.resize(m_spec.image_bytes());
+
     return true;
 }
 
@@ -249,8 +274,12 @@ PNGOutput::close()
         return true;
     }
 
+    bool ok = true;
     if (m_png) {
-        PNG_pvt::write_end(m_png, m_info);
+        if (m_parallel)
+            ok = write_parallel_idat();
+        else
+            PNG_pvt::write_end(m_png, m_info);
         if (m_png || m_info)
             PNG_pvt::destroy_write_struct(m_png, m_info);
         m_png  = nullptr;
@@ -258,11 +287,66 @@ PNGOutput::close()
     }
 
     init();  // re-initialize
+    return ok;
+}
+
+
+
+bool
+PNGOutput::write_native_rows(int ybegin, int nrows, png_byte* data)
+{
+    size_t rowbytes = m_spec.scanline_bytes();
+    if (m_parallel) {
+        if (ybegin < m_spec.y || ybegin + nrows > m_spec.y + m_spec.height) {
+            errorfmt("Attempt to write scanlines {}-{} outside the image",
+                     ybegin, ybegin + nrows);
+            return false;
+        }
+        memcpy(m_pixels.data() + size_t(ybegin - m_spec.y) * rowbytes, data,
+               size_t(nrows) * rowbytes);
+        return true;
+    }
+    if (!PNG_pvt::write_rows(m_png, data, nrows, stride_t(rowbytes))) {
+        errorfmt("PNG library error");
+        return false;
+    }
     return true;
 }
 
 
 
+bool
+PNGOutput::write_parallel_idat()
+{
+    // libpng already wrote the signature and all the chunks preceding the
+    // image data (in write_info). Everything after it is ours to write:
+    // the IDAT chunks and the terminating IEND. No ancillary chunks are
+    // deferred until after IDAT by our write_info.
+    std::vector<unsigned char> zdata;
+    if (!PNG_pvt::compress_image_parallel(m_pixels.data(), m_spec.height,
+                                          m_spec.scanline_bytes(),
+                                          m_spec.pixel_bytes(), m_filters,
+                                          m_zlevel, m_zstrategy, zdata,
+                                          threads())) {
+        errorfmt("PNG compression error");
+        return false;
+    }
+    m_pixels.clear();
+    m_pixels.shrink_to_fit();
+
+    std::vector<unsigned char> chunks;
+    size_t nchunks = zdata.size() / PNG_pvt::idat_chunk_size + 2;
+    chunks.reserve(zdata.size() + 12 * nchunks);
+    for (size_t pos = 0; pos < zdata.size(); pos += PNG_pvt::idat_chunk_size)
+        PNG_pvt::append_chunk(chunks, "IDAT", zdata.data() + pos,
+                              std::min(PNG_pvt::idat_chunk_size,
+                                       zdata.size() - pos));
+    PNG_pvt::append_chunk(chunks, "IEND", nullptr, 0);
+    return iowrite(chunks.data(), chunks.size()) && !m_err;
+}
+
+
+
 template<class T>
 void
 PNGOutput::deassociateAlpha(T* data, size_t npixels, int channels,
@@ -359,12 +443,7 @@ PNGOutput::write_scanline(int y, int z, TypeDesc format, const void* data,
     if (m_need_swap)
         swap_endian((unsigned short*)data, m_spec.width * m_spec.nchannels);
 
-    if (!PNG_pvt::write_row(m_png, (png_byte*)data)) {
-        errorfmt("PNG library error");
-        return false;
-    }
-
-    return true;
+    return write_native_rows(y, 1, (png_byte*)data);
 }
 
 
@@ -426,15 +505,8 @@ PNGOutput::write_scanlines(int ybegin, int yend, int z, TypeDesc format,
     if (m_need_swap)
         swap_endian((unsigned short*)data, nvals);
 
-    if (!PNG_pvt::write_rows(m_png, (png_byte*)data, yend - ybegin,
-                             stride_t(m_spec.width) * m_spec.nchannels
-                                 * m_spec.format.size())) {
-        errorfmt("PNG library error");
-        return false;
-    }
+    return write_native_rows(ybegin, yend - ybegin, (png_byte*)data);
 #endif
-
-    return true;
 }
 
 
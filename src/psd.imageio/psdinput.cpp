@@ -37,7 +37,11 @@ public:
     int supports(string_view feature) const override
     {
         return (feature == "exif" || feature == "iptc" || feature == "thumbnail"
-                || feature == "ioproxy");
+                || feature == "ioproxy"
+                // channels are stored (and decoded) separately, but only
+                // some color modes can be decoded a few channels at a time
+                || (feature == "native_channel_subset"
+                    && decodes_channel_subset(m_subimage, 1)));
     }
     bool valid_file(Filesystem::IOProxy* ioproxy) const override;
     bool open(const std::string& name, ImageSpec& newspec) override;
@@ -48,6 +52,9 @@ public:
     bool seek_subimage(int subimage, int miplevel) override;
     bool read_native_scanline(int subimage, int miplevel, int y, int z,
                               void* data) override;
+    bool read_native_scanlines(int subimage, int miplevel, int ybegin, int yend,
+                               int z, int chbegin, int chend,
+                               void* data) override;
     bool get_thumbnail(ImageBuf& thumb, int subimage) override
     {
         thumb = m_thumbnail;
@@ -380,6 +387,14 @@ private:
                 }
     }
 
+    // Can read_native_scanlines() decode channels [chbegin,...) of this
+    // subimage without decoding all of them?
+    bool decodes_channel_subset(int subimage, int chbegin) const;
+
+    // Apply the alpha conversion that read_native_scanline does for this
+    // subimage to n pixels with nchannels channels.
+    void fix_alpha(int subimage, int n, void* data, int nchannels,
+                   int alpha_channel, TypeDesc format) const;
     void background_to_assocalpha(int n, void* data, int nchannels,
                                   int alpha_channel, TypeDesc format) const;
     void background_to_unassalpha(int n, void* data, int nchannels,
@@ -882,27 +897,138 @@ PSDInput::read_native_scanline(int subimage, int miplevel, int y, int /*z*/,
     // m_keep_unassociated_alpha false: convert to associated
     //
     //
-    if (spec.alpha_channel != -1) {
-        if (subimage == 0) {
-            if (m_keep_unassociated_alpha) {
-                background_to_unassalpha(spec.width, data, spec.nchannels,
-                                         spec.alpha_channel, spec.format);
-            } else {
-                background_to_assocalpha(spec.width, data, spec.nchannels,
-                                         spec.alpha_channel, spec.format);
-            }
+    if (spec.alpha_channel != -1)
+        fix_alpha(subimage, spec.width, data, spec.nchannels,
+                  spec.alpha_channel, spec.format);
+
+    return true;
+#undef DEB
+}
+
+
+
+void
+PSDInput::fix_alpha(int subimage, int n, void* data, int nchannels,
+                    int alpha_channel, TypeDesc format) const
+{
+    if (subimage == 0) {
+        if (m_keep_unassociated_alpha) {
+            background_to_unassalpha(n, data, nchannels, alpha_channel,
+                                     format);
         } else {
-            if (m_keep_unassociated_alpha) {
-                // do nothing - leave as it is
-            } else {
-                unassalpha_to_assocalpha(spec.width, data, spec.nchannels,
-                                         spec.alpha_channel, spec.format);
-            }
+            background_to_assocalpha(n, data, nchannels, alpha_channel,
+                                     format);
+        }
+    } else {
+        if (m_keep_unassociated_alpha) {
+            // do nothing - leave as it is
+        } else {
+            unassalpha_to_assocalpha(n, data, nchannels, alpha_channel,
+                                     format);
+        }
+    }
+}
+
+
+
+bool
+PSDInput::decodes_channel_subset(int subimage, int chbegin) const
+{
+    if (subimage < 0 || subimage >= m_subimage_count)
+        return false;
+    // Each channel is stored separately, so for the color modes where file
+    // channels are the spec's channels, we only need to decode the ones
+    // asked for (plus alpha, if the colors need it). The other modes need
+    // all the channels to compute any of them. The composite's background
+    // removal is indexed by channel, so needs the range to start at 0.
+    const ImageSpec& spec(m_specs[subimage]);
+    bool need_alpha = spec.alpha_channel >= 0
+                      && (subimage == 0 || !m_keep_unassociated_alpha);
+    return (m_WantRaw || m_header.color_mode == ColorMode_RGB
+            || m_header.color_mode == ColorMode_Multichannel
+            || m_header.color_mode == ColorMode_Grayscale)
+           && int(m_channels[subimage].size()) >= spec.nchannels
+           && !(need_alpha && subimage == 0 && chbegin != 0);
+}
+
+
+
+bool
+PSDInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
+                                int yend, int z, int chbegin, int chend,
+                                void* data)
+{
+    if (subimage < 0 || subimage >= m_subimage_count || miplevel != 0)
+        return false;
+    const ImageSpec& spec               = m_specs[subimage];
+    std::vector<ChannelInfo*>& channels = m_channels[subimage];
+    chend = clamp(chend, chbegin + 1, spec.nchannels);
+    yend  = std::min(yend, spec.y + spec.height);
+
+    int alpha       = spec.alpha_channel;
+    bool need_alpha = alpha >= 0
+                      && (subimage == 0 || !m_keep_unassociated_alpha);
+    if (!decodes_channel_subset(subimage, chbegin)
+        || (chbegin == 0 && chend == spec.nchannels))
+        return ImageInput::read_native_scanlines(subimage, miplevel, ybegin,
+                                                 yend, z, chbegin, chend,
+                                                 data);
+
+    // The channels to decode, and where alpha lands among them.
+    std::vector<int> chans;
+    for (int c = chbegin; c < chend; ++c)
+        chans.push_back(c);
+    int local_alpha = -1;
+    if (need_alpha) {
+        local_alpha = alpha - chbegin;
+        if (alpha < chbegin || alpha >= chend) {
+            local_alpha = int(chans.size());
+            chans.push_back(alpha);
         }
     }
+    int nlocal          = int(chans.size());
+    size_t bps          = spec.format.size();
+    size_t subset_bytes = size_t(chend - chbegin) * bps;
+    size_t local_bytes  = size_t(nlocal) * bps;
 
+    lock_guard lock(*this);
+    std::vector<std::vector<unsigned char>> channel_buffers(nlocal);
+    std::vector<unsigned char> pixels(local_bytes * spec.width);
+    char* dst = (char*)data;
+    for (int y = ybegin; y < yend; ++y, dst += subset_bytes * spec.width) {
+        for (int c = 0; c < nlocal; ++c) {
+            ChannelInfo& channel_info = *channels[chans[c]];
+            channel_buffers[c].resize(channel_info.row_length);
+            if (!read_channel_row(channel_info, y - spec.y,
+                                  (char*)channel_buffers[c].data()))
+                return false;
+        }
+        // Interleave straight into the caller's buffer unless alpha was
+        // added to the channel list.
+        unsigned char* row = nlocal == chend - chbegin ? (unsigned char*)dst
+                                                       : pixels.data();
+        switch (bps) {
+        case 4:
+            interleave_row((float*)row, channel_buffers, spec.width, nlocal);
+            break;
+        case 2:
+            interleave_row((unsigned short*)row, channel_buffers, spec.width,
+                           nlocal);
+            break;
+        default:
+            interleave_row(row, channel_buffers, spec.width, nlocal);
+            break;
+        }
+        if (local_alpha >= 0)
+            fix_alpha(subimage, spec.width, row, nlocal, local_alpha,
+                      spec.format);
+        if (row == pixels.data()) {
+            for (int x = 0; x < spec.width; ++x)
+                memcpy(dst + x * subset_bytes, row + x * local_bytes,
+                       subset_bytes);
+        }
+    }
     return true;
-#undef DEB
 }
 
 
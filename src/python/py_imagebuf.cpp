@@ -14,28 +14,31 @@ namespace PyOpenImageIO {
 
 
 
-static ImageBuf
-ImageBuf_from_buffer(const py::buffer& buffer)
+// Deduce the ImageSpec and strides of an image stored in a Python buffer
+// indexed as [y][x], [y][x][channel], or [z][y][x][channel]. Return false
+// (with `err` set if it was an unsupported layout rather than an unknown
+// data type) if the buffer can't be interpreted as an image.
+static bool
+buffer_image_layout(const py::buffer_info& info, ImageSpec& spec,
+                    stride_t& xstride, stride_t& ystride, stride_t& zstride,
+                    std::string& err)
 {
-    ImageBuf ib;
-    const py::buffer_info info = buffer.request();
     TypeDesc format;
     if (info.format.size())
         format = typedesc_from_python_array_code(info.format);
     if (format == TypeUnknown)
-        return ib;
+        return false;
     // Strutil::print("IB from {} buffer: dims = {}\n", format, info.ndim);
     // for (int i = 0; i < info.ndim; ++i)
     //     Strutil::print("IB from buffer: dim[{}]: size = {}, stride = {}\n", i,
     //                    info.shape[i], info.strides[i]);
     if (size_t(info.strides[info.ndim - 1]) != format.size()) {
-        ib.errorfmt(
-            "ImageBuf-from-numpy-array must have contiguous stride within pixels");
-        return ib;
+        err = "ImageBuf-from-numpy-array must have contiguous stride within pixels";
+        return false;
     }
 
     int width = 1, height = 1, depth = 1, nchans = 1;
-    stride_t xstride = AutoStride, ystride = AutoStride, zstride = AutoStride;
+    xstride = AutoStride, ystride = AutoStride, zstride = AutoStride;
     if (info.ndim == 3) {
         // Assume [y][x][c]
         width   = info.shape[1];
@@ -59,25 +62,135 @@ ImageBuf_from_buffer(const py::buffer& buffer)
         ystride = info.strides[1];
         zstride = info.strides[0];
     } else {
-        ib.errorfmt(
-            "ImageBuf-from-numpy-array must have 2, 3, or 4 dimensions");
-        return ib;
+        err = "ImageBuf-from-numpy-array must have 2, 3, or 4 dimensions";
+        return false;
     }
 
-    ImageSpec spec(width, height, nchans, format);
+    spec            = ImageSpec(width, height, nchans, format);
     spec.depth      = depth;
     spec.full_depth = depth;
+    return true;
+}
+
+
+
+static ImageBuf
+ImageBuf_from_buffer(const py::buffer& buffer)
+{
+    ImageBuf ib;
+    const py::buffer_info info = buffer.request();
+    ImageSpec spec;
+    stride_t xstride, ystride, zstride;
+    std::string err;
+    if (!buffer_image_layout(info, spec, xstride, ystride, zstride, err)) {
+        if (err.size())
+            ib.errorfmt("{}", err);
+        return ib;
+    }
     ib.reset(spec, InitializePixels::No);
     image_span<const std::byte> bufspan(reinterpret_cast<std::byte*>(info.ptr),
-                                        nchans, width, height, depth,
-                                        format.size(), xstride, ystride,
-                                        zstride, format.size());
-    ib.set_pixels(get_roi(spec), format, bufspan);
+                                        spec.nchannels, spec.width,
+                                        spec.height, spec.depth,
+                                        spec.format.size(), xstride, ystride,
+                                        zstride, spec.format.size());
+    ib.set_pixels(get_roi(spec), spec.format, bufspan);
     return ib;
 }
 
 
 
+// Make an APPBUFFER ImageBuf that wraps the buffer's memory without
+// copying it. It will be read-only if the buffer is. The caller is
+// responsible for keeping the buffer alive as long as the ImageBuf.
+static ImageBuf
+ImageBuf_wrap_buffer(const py::buffer& buffer)
+{
+    ImageBuf ib;
+    const py::buffer_info info = buffer.request();
+    ImageSpec spec;
+    stride_t xstride, ystride, zstride;
+    std::string err;
+    if (!buffer_image_layout(info, spec, xstride, ystride, zstride, err)) {
+        if (err.size())
+            ib.errorfmt("{}", err);
+        return ib;
+    }
+    std::byte* ptr = reinterpret_cast<std::byte*>(info.ptr);
+    size_t chansize = spec.format.size();
+    if (info.readonly)
+        ib.reset(spec, image_span<const std::byte>(ptr, spec.nchannels,
+                                                   spec.width, spec.height,
+                                                   spec.depth, chansize,
+                                                   xstride, ystride, zstride,
+                                                   chansize));
+    else
+        ib.reset(spec, image_span<std::byte>(ptr, spec.nchannels, spec.width,
+                                             spec.height, spec.depth,
+                                             chansize, xstride, ystride,
+                                             zstride, chansize));
+    return ib;
+}
+
+
+
+// Python buffer protocol: expose the ImageBuf's own pixel memory, without
+// copying, as [y][x][channel] (or [z][y][x][channel] for volumes). An
+// ImageCache-backed image is first read fully into local memory.
+static py::buffer_info
+ImageBuf_buffer_info(ImageBuf& self)
+{
+    if (!self.initialized())
+        throw std::runtime_error("ImageBuf is uninitialized");
+    if (self.deep())
+        throw std::runtime_error("Can't make a buffer view of a deep image");
+    if (!self.localpixels()) {
+        py::gil_scoped_release gil;
+        self.make_writable(true);
+    }
+    if (!self.localpixels())
+        throw std::runtime_error(
+            Strutil::fmt::format("ImageBuf has no local pixels: {}",
+                                 self.geterror()));
+
+    // Python struct-module format codes for each pixel type
+    static const std::pair<TypeDesc::BASETYPE, const char*> codes[] = {
+        { TypeDesc::UINT8, "B" },  { TypeDesc::INT8, "b" },
+        { TypeDesc::UINT16, "H" }, { TypeDesc::INT16, "h" },
+        { TypeDesc::UINT32, "I" }, { TypeDesc::INT32, "i" },
+        { TypeDesc::UINT64, "Q" }, { TypeDesc::INT64, "q" },
+        { TypeDesc::HALF, "e" },   { TypeDesc::FLOAT, "f" },
+        { TypeDesc::DOUBLE, "d" }
+    };
+    const char* code = nullptr;
+    for (auto& c : codes)
+        if (c.first == self.pixeltype().basetype)
+            code = c.second;
+    if (!code)
+        throw std::runtime_error(
+            Strutil::fmt::format("Can't make a buffer view of {} pixels",
+                                 self.pixeltype()));
+
+    const ImageSpec& spec(self.spec());
+    py::ssize_t chansize = py::ssize_t(self.pixeltype().size());
+    std::vector<py::ssize_t> shape, strides;
+    if (spec.depth > 1) {
+        shape.assign({ spec.depth, spec.height, spec.width, spec.nchannels });
+        strides.assign({ py::ssize_t(self.z_stride()),
+                         py::ssize_t(self.scanline_stride()),
+                         py::ssize_t(self.pixel_stride()), chansize });
+    } else {
+        shape.assign({ spec.height, spec.width, spec.nchannels });
+        strides.assign({ py::ssize_t(self.scanline_stride()),
+                         py::ssize_t(self.pixel_stride()), chansize });
+    }
+    bool readonly = !self.localpixels_as_writable_byte_image_span().data();
+    return py::buffer_info(self.pixeladdr(spec.x, spec.y, spec.z), chansize,
+                           code, py::ssize_t(shape.size()), shape, strides,
+                           readonly);
+}
+
+
+
 py::tuple
 ImageBuf_getpixel(const ImageBuf& buf, int x, int y, int z = 0,
                   const std::string& wrapname = "black")
@@ -289,7 +402,7 @@ declare_imagebuf(py::module& m)
 {
     using namespace pybind11::literals;
 
-    py::class_<ImageBuf>(m, "ImageBuf")
+    py::class_<ImageBuf>(m, "ImageBuf", py::buffer_protocol())
         .def(py::init<>())
         .def(py::init<const std::string&>())
         .def(py::init<const std::string&, int, int>())
@@ -307,6 +420,9 @@ declare_imagebuf(py::module& m)
                  return ImageBuf_from_buffer(buffer);
              }),
              "buffer"_a)
+        .def_static("wrap", &ImageBuf_wrap_buffer, "buffer"_a,
+                    py::keep_alive<0, 1>())
+        .def_buffer(&ImageBuf_buffer_info)
         .def("clear", &ImageBuf::clear)
         .def(
             "reset",
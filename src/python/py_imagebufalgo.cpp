@@ -1385,6 +1385,18 @@ IBA_computePixelHashSHA1(const ImageBuf& src, const std::string& extrainfo,
 
 
 
+std::string
+IBA_computePixelHash(const ImageBuf& src, const std::string& algorithm,
+                     const std::string& extrainfo, ROI roi = ROI::All(),
+                     int nthreads = 0)
+{
+    py::gil_scoped_release gil;
+    return ImageBufAlgo::computePixelHash(src, algorithm, extrainfo, roi,
+                                          nthreads);
+}
+
+
+
 bool
 IBA_warp(ImageBuf& dst, const ImageBuf& src, py::object values_M,
          const std::string& filtername = "", float filterwidth = 0.0f,
@@ -3038,6 +3050,10 @@ declare_imagebufalgo(py::module& m)
                     "extrainfo"_a = "", "roi"_a = ROI::All(), "blocksize"_a = 0,
                     "nthreads"_a = 0)
 
+        .def_static("computePixelHash", &IBA_computePixelHash, "src"_a,
+                    "algorithm"_a = "xxhash", "extrainfo"_a = "",
+                    "roi"_a = ROI::All(), "nthreads"_a = 0)
+
         .def_static("warp", &IBA_warp, "dst"_a, "src"_a, "M"_a,
                     "filtername"_a = "", "filterwidth"_a = 0.0f,
                     "recompute_roi"_a = false, "wrap"_a = "default",
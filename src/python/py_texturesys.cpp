@@ -4,6 +4,10 @@
 
 #include "py_oiio.h"
 
+#include <optional>
+
+#include <OpenImageIO/parallel.h>
+
 namespace PyOpenImageIO {
 
 
@@ -62,6 +66,131 @@ public:
 
 
 
+// Array-in/array-out texture lookups. The N points are split into chunks
+// that are looked up in parallel with the GIL released, each chunk in runs
+// of Tex::BatchWidth points using the batched (TextureOptBatch) API.
+
+using FloatArray
+    = py::array_t<float, py::array::c_style | py::array::forcecast>;
+using OptFloatArray = std::optional<FloatArray>;
+
+
+// Copy the options into a TextureOptBatch, with the same per-point options
+// for every lane.
+static void
+batch_options(TextureOptBatch& ob, const TextureOptWrap& opt)
+{
+    for (int i = 0; i < Tex::BatchWidth; ++i) {
+        ob.sblur[i]  = opt.sblur;
+        ob.tblur[i]  = opt.tblur;
+        ob.rblur[i]  = opt.rblur;
+        ob.swidth[i] = opt.swidth;
+        ob.twidth[i] = opt.twidth;
+        ob.rwidth[i] = opt.rwidth;
+        ob.rnd[i]    = opt.rnd;
+    }
+    ob.firstchannel        = opt.firstchannel;
+    ob.subimage            = opt.subimage;
+    ob.subimagename        = opt.subimagename;
+    ob.swrap               = decltype(ob.swrap)(opt.swrap);
+    ob.twrap               = decltype(ob.twrap)(opt.twrap);
+    ob.rwrap               = decltype(ob.rwrap)(opt.rwrap);
+    ob.mipmode             = decltype(ob.mipmode)(opt.mipmode);
+    ob.interpmode          = decltype(ob.interpmode)(opt.interpmode);
+    ob.anisotropic         = opt.anisotropic;
+    ob.conservative_filter = opt.conservative_filter;
+    ob.fill                = opt.fill;
+    ob.missingcolor        = opt.missingcolor;
+    ob.colortransformid    = opt.colortransformid;
+}
+
+
+
+// Check that `a` (if present) holds `n` points of `dims` floats each, and
+// return its data, or nullptr if it was not supplied.
+static const float*
+batch_input(const OptFloatArray& a, const char* name, py::ssize_t n, int dims)
+{
+    if (!a)
+        return nullptr;
+    if (a->size() != n * dims
+        || (dims > 1 && (a->ndim() != 2 || a->shape(1) != dims)))
+        throw std::invalid_argument(Strutil::fmt::format(
+            "{} must have {} values{}", name, n,
+            dims > 1 ? Strutil::fmt::format(" of {} floats", dims) : ""));
+    return a->data();
+}
+
+
+
+// Run `lookup(texsys, handle, thread_info, opt, mask, first, result)` for
+// successive batches of points [first, first+BatchWidth) (masked at the end
+// of each chunk), and scatter the SOA results into an (n, nchannels) array.
+template<typename LOOKUP>
+static py::object
+texture_batch_driver(const TextureSystemWrap& ts, const std::string& filename,
+                     const TextureOptWrap& options, py::ssize_t n,
+                     int nchannels, LOOKUP&& lookup)
+{
+    if (!ts.m_texsys || nchannels < 1)
+        return py::none();
+    TextureSystem& texsys(*ts.m_texsys);
+    TextureSystem::TextureHandle* handle = nullptr;
+    {
+        py::gil_scoped_release gil;
+        handle = texsys.get_texture_handle(ustring(filename));
+    }
+    if (!handle)
+        return py::none();
+    py::array_t<float> result({ n, py::ssize_t(nchannels) });
+    float* out = result.mutable_data();
+    {
+        py::gil_scoped_release gil;
+        TextureOptBatch optbatch;
+        batch_options(optbatch, options);
+        parallel_for_chunked(
+            0, int64_t(n), 64 * Tex::BatchWidth,
+            [&](int64_t begin, int64_t end) {
+                auto thread_info = texsys.get_perthread_info();
+                TextureOptBatch opt = optbatch;
+                std::vector<TextureOptBatch::simd_t> res(nchannels);
+                float* r = (float*)res.data();
+                for (int64_t first = begin; first < end;
+                     first += Tex::BatchWidth) {
+                    int count = int(std::min(int64_t(Tex::BatchWidth),
+                                             end - first));
+                    Tex::RunMask mask = count == Tex::BatchWidth
+                                            ? Tex::RunMaskOn
+                                            : (Tex::RunMask(1) << count) - 1;
+                    lookup(texsys, handle, thread_info, opt, mask, first,
+                           count, r);
+                    for (int i = 0; i < count; ++i)
+                        for (int c = 0; c < nchannels; ++c)
+                            out[(first + i) * nchannels + c]
+                                = r[c * Tex::BatchWidth + i];
+                }
+            });
+    }
+    return result;
+}
+
+
+
+// Gather `count` values of input `src` (dims floats per point, or all
+// zero if src is null) starting at point `first` into SOA `dst`, laid out
+// as float[dims][BatchWidth].
+static void
+batch_gather(float* dst, const float* src, int64_t first, int count,
+             int dims)
+{
+    for (int d = 0; d < dims; ++d)
+        for (int i = 0; i < Tex::BatchWidth; ++i)
+            dst[d * Tex::BatchWidth + i]
+                = (src && i < count) ? src[(first + i) * dims + d] : 0.0f;
+}
+
+
+
 void
 declare_wrap(py::module& m)
 {
@@ -224,6 +353,43 @@ declare_texturesystem(py::module& m)
             "filename"_a, "options"_a, "s"_a, "t"_a, "dsdx"_a, "dtdx"_a,
             "dsdy"_a, "dtdy"_a, "nchannels"_a)
 
+        .def(
+            "texture_batch",
+            [](const TextureSystemWrap& ts, const std::string& filename,
+               TextureOptWrap& options, const FloatArray& s,
+               const FloatArray& t, const OptFloatArray& dsdx,
+               const OptFloatArray& dtdx, const OptFloatArray& dsdy,
+               const OptFloatArray& dtdy, int nchannels) {
+                py::ssize_t n = s.size();
+                const float* S    = batch_input(s, "s", n, 1);
+                const float* T    = batch_input(t, "t", n, 1);
+                const float* DSDX = batch_input(dsdx, "dsdx", n, 1);
+                const float* DTDX = batch_input(dtdx, "dtdx", n, 1);
+                const float* DSDY = batch_input(dsdy, "dsdy", n, 1);
+                const float* DTDY = batch_input(dtdy, "dtdy", n, 1);
+                return texture_batch_driver(
+                    ts, filename, options, n, nchannels,
+                    [&](TextureSystem& texsys,
+                        TextureSystem::TextureHandle* handle,
+                        TextureSystem::Perthread* thread_info,
+                        TextureOptBatch& opt, Tex::RunMask mask, int64_t first,
+                        int count, float* result) {
+                        alignas(Tex::BatchAlign) float in[6][Tex::BatchWidth];
+                        batch_gather(in[0], S, first, count, 1);
+                        batch_gather(in[1], T, first, count, 1);
+                        batch_gather(in[2], DSDX, first, count, 1);
+                        batch_gather(in[3], DTDX, first, count, 1);
+                        batch_gather(in[4], DSDY, first, count, 1);
+                        batch_gather(in[5], DTDY, first, count, 1);
+                        texsys.texture(handle, thread_info, opt, mask, in[0],
+                                       in[1], in[2], in[3], in[4], in[5],
+                                       nchannels, result);
+                    });
+            },
+            "filename"_a, "options"_a, "s"_a, "t"_a, "dsdx"_a = py::none(),
+            "dtdx"_a = py::none(), "dsdy"_a = py::none(),
+            "dtdy"_a = py::none(), "nchannels"_a = 3)
+
 
         .def(
             "texture3d",
@@ -250,6 +416,38 @@ declare_texturesystem(py::module& m)
             "filename"_a, "options"_a, "P"_a, "dPdx"_a, "dPdy"_a, "dPdz"_a,
             "nchannels"_a)
 
+        .def(
+            "texture3d_batch",
+            [](const TextureSystemWrap& ts, const std::string& filename,
+               TextureOptWrap& options, const FloatArray& P,
+               const OptFloatArray& dPdx, const OptFloatArray& dPdy,
+               const OptFloatArray& dPdz, int nchannels) {
+                py::ssize_t n = P.size() / 3;
+                const float* PP   = batch_input(P, "P", n, 3);
+                const float* DPDX = batch_input(dPdx, "dPdx", n, 3);
+                const float* DPDY = batch_input(dPdy, "dPdy", n, 3);
+                const float* DPDZ = batch_input(dPdz, "dPdz", n, 3);
+                return texture_batch_driver(
+                    ts, filename, options, n, nchannels,
+                    [&](TextureSystem& texsys,
+                        TextureSystem::TextureHandle* handle,
+                        TextureSystem::Perthread* thread_info,
+                        TextureOptBatch& opt, Tex::RunMask mask, int64_t first,
+                        int count, float* result) {
+                        alignas(Tex::BatchAlign)
+                            float in[4][3 * Tex::BatchWidth];
+                        batch_gather(in[0], PP, first, count, 3);
+                        batch_gather(in[1], DPDX, first, count, 3);
+                        batch_gather(in[2], DPDY, first, count, 3);
+                        batch_gather(in[3], DPDZ, first, count, 3);
+                        texsys.texture3d(handle, thread_info, opt, mask, in[0],
+                                         in[1], in[2], in[3], nchannels,
+                                         result);
+                    });
+            },
+            "filename"_a, "options"_a, "P"_a, "dPdx"_a = py::none(),
+            "dPdy"_a = py::none(), "dPdz"_a = py::none(), "nchannels"_a = 3)
+
         .def(
             "environment",
             [](const TextureSystemWrap& ts, const std::string& filename,
@@ -275,6 +473,36 @@ declare_texturesystem(py::module& m)
             },
             "filename"_a, "options"_a, "R"_a, "dRdx"_a, "dRdy"_a, "nchannels"_a)
 
+        .def(
+            "environment_batch",
+            [](const TextureSystemWrap& ts, const std::string& filename,
+               TextureOptWrap& options, const FloatArray& R,
+               const OptFloatArray& dRdx, const OptFloatArray& dRdy,
+               int nchannels) {
+                py::ssize_t n = R.size() / 3;
+                const float* RR   = batch_input(R, "R", n, 3);
+                const float* DRDX = batch_input(dRdx, "dRdx", n, 3);
+                const float* DRDY = batch_input(dRdy, "dRdy", n, 3);
+                return texture_batch_driver(
+                    ts, filename, options, n, nchannels,
+                    [&](TextureSystem& texsys,
+                        TextureSystem::TextureHandle* handle,
+                        TextureSystem::Perthread* thread_info,
+                        TextureOptBatch& opt, Tex::RunMask mask, int64_t first,
+                        int count, float* result) {
+                        alignas(Tex::BatchAlign)
+                            float in[3][3 * Tex::BatchWidth];
+                        batch_gather(in[0], RR, first, count, 3);
+                        batch_gather(in[1], DRDX, first, count, 3);
+                        batch_gather(in[2], DRDY, first, count, 3);
+                        texsys.environment(handle, thread_info, opt, mask,
+                                           in[0], in[1], in[2], nchannels,
+                                           result);
+                    });
+            },
+            "filename"_a, "options"_a, "R"_a, "dRdx"_a = py::none(),
+            "dRdy"_a = py::none(), "nchannels"_a = 3)
+
         .def(
             "resolve_filename",
             [](TextureSystemWrap& ts, const std::string& filename) {
@@ -369,6 +369,8 @@ class ImageBuf:
     def spec(self) -> ImageSpec: ...
     def specmod(self) -> ImageSpec: ...
     def swap(self, arg0: ImageBuf, /) -> None: ...
+    @staticmethod
+    def wrap(buffer: typing_extensions.Buffer) -> ImageBuf: ...
     @overload
     def write(self, filename: str, dtype: TypeDesc | BASETYPE | str = ..., fileformat: str = ...) -> bool: ...
     @overload
@@ -576,6 +578,8 @@ class ImageBufAlgo:
     @staticmethod
     def complex_to_polar(src: ImageBuf, roi: ROI = ..., nthreads: typing.SupportsInt = ...) -> ImageBuf: ...
     @staticmethod
+    def computePixelHash(src: ImageBuf, algorithm: str = ..., extrainfo: str = ..., roi: ROI = ..., nthreads: typing.SupportsInt = ...) -> str: ...
+    @staticmethod
     def computePixelHashSHA1(src: ImageBuf, extrainfo: str = ..., roi: ROI = ..., blocksize: typing.SupportsInt = ..., nthreads: typing.SupportsInt = ...) -> str: ...
     @overload
     @staticmethod
@@ -1519,6 +1523,7 @@ class TextureSystem:
     @staticmethod
     def destroy(arg0: TextureSystem, /) -> None: ...
     def environment(self, filename: str, options: TextureOpt, R, dRdx, dRdy, nchannels: typing.SupportsInt) -> tuple[float, ...]: ...
+    def environment_batch(self, filename: str, options: TextureOpt, R: numpy.ndarray, dRdx: numpy.ndarray | None = ..., dRdy: numpy.ndarray | None = ..., nchannels: typing.SupportsInt = ...) -> numpy.ndarray | None: ...
     def getattribute(self, name: str, type: TypeDesc | BASETYPE | str = ...) -> typing.Any: ...
     def getattributetype(self, name: str) -> TypeDesc: ...
     def geterror(self, clear: bool = ...) -> str: ...
@@ -1533,7 +1538,9 @@ class TextureSystem:
     def resolve_filename(self, filename: str) -> str: ...
     def resolve_udim(self, filename: str, s: typing.SupportsFloat, t: typing.SupportsFloat) -> str: ...
     def texture(self, filename: str, options: TextureOpt, s: typing.SupportsFloat, t: typing.SupportsFloat, dsdx: typing.SupportsFloat, dtdx: typing.SupportsFloat, dsdy: typing.SupportsFloat, dtdy: typing.SupportsFloat, nchannels: typing.SupportsInt) -> tuple[float, ...]: ...
+    def texture_batch(self, filename: str, options: TextureOpt, s: numpy.ndarray, t: numpy.ndarray, dsdx: numpy.ndarray | None = ..., dtdx: numpy.ndarray | None = ..., dsdy: numpy.ndarray | None = ..., dtdy: numpy.ndarray | None = ..., nchannels: typing.SupportsInt = ...) -> numpy.ndarray | None: ...
     def texture3d(self, filename: str, options: TextureOpt, P, dPdx, dPdy, dPdz, nchannels: typing.SupportsInt) -> tuple[float, ...]: ...
+    def texture3d_batch(self, filename: str, options: TextureOpt, P: numpy.ndarray, dPdx: numpy.ndarray | None = ..., dPdy: numpy.ndarray | None = ..., dPdz: numpy.ndarray | None = ..., nchannels: typing.SupportsInt = ...) -> numpy.ndarray | None: ...
 
 class TypeDesc:
     aggregate: AGGREGATE
@@ -102,7 +102,10 @@ public:
     int supports(string_view feature) const override
     {
         return (feature == "exif" || feature == "iptc" || feature == "ioproxy"
-                || feature == "multiimage" || feature == "mipmap");
+                || feature == "multiimage" || feature == "mipmap"
+                // separate planarconfig decodes only the requested planes
+                || (feature == "native_channel_subset"
+                    && decodes_plane_subsets()));
         // N.B. No support for arbitrary metadata.
     }
     bool open(const std::string& name, ImageSpec& newspec) override;
@@ -129,6 +132,9 @@ public:
                               void* data) override;
     bool read_native_scanlines(int subimage, int miplevel, int ybegin, int yend,
                                int z, void* data) override;
+    bool read_native_scanlines(int subimage, int miplevel, int ybegin, int yend,
+                               int z, int chbegin, int chend,
+                               void* data) override;
     bool read_native_tile(int subimage, int miplevel, int x, int y, int z,
                           void* data) override;
     bool read_native_tiles(int subimage, int miplevel, int xbegin, int xend,
@@ -261,6 +267,19 @@ private:
 
     void invert_photometric(int n, void* data);
 
+    // Can read_native_scanlines() read a channel subset of the current
+    // subimage by decoding only those channels' planes? That takes
+    // "separate" planarconfig strips that need no color conversion.
+    bool decodes_plane_subsets() const
+    {
+        return m_tif && m_separate && !m_use_rgba_interface
+               && !m_spec.tile_width
+               && m_photometric != PHOTOMETRIC_SEPARATED
+               && m_photometric != PHOTOMETRIC_PALETTE
+               && m_spec.format.size() * 8 == m_bitspersample
+               && m_inputchannels == m_spec.nchannels;
+    }
+
     const TIFFField* find_field(int tifftag, TIFFDataType tifftype = TIFF_ANY)
     {
         return TIFFFindField(m_tif, tifftag, tifftype);
@@ -564,8 +583,8 @@ private:
     // horizontal predictor to each row. It is permitted for src and dst to
     // be the same.
     template<typename T>
-    void undo_horizontal_predictor(T* dst, const T* src, int chans, int width,
-                                   int height)
+    static void undo_horizontal_predictor(T* dst, const T* src, int chans,
+                                          int width, int height)
     {
         for (int y = 0; y < height;
              ++y, src += chans * width, dst += chans * width)
@@ -577,17 +596,22 @@ private:
             }
     }
 
-    void uncompress_one_strip(const void* compressed_buf, unsigned long csize,
-                              void* uncompressed_buf, size_t strip_bytes,
-                              int channels, int width, int height, bool* ok)
+    // Decompress one strip or tile and undo its predictor. Everything it
+    // needs to know about the subimage is passed in, so it may be called
+    // without holding the lock.
+    static void uncompress_raw(const void* compressed_buf, unsigned long csize,
+                               void* uncompressed_buf, size_t strip_bytes,
+                               int channels, int width, int height,
+                               int compression, int predictor,
+                               TypeDesc format, bool byte_swapped, bool* ok)
     {
-        OIIO_DASSERT (m_compression == COMPRESSION_ADOBE_DEFLATE /*||
-                      m_compression == COMPRESSION_NONE*/);
+        OIIO_DASSERT (compression == COMPRESSION_ADOBE_DEFLATE /*||
+                      compression == COMPRESSION_NONE*/);
         size_t nvals = size_t(width) * size_t(height) * size_t(channels);
-        if (m_compression == COMPRESSION_NONE) {
+        if (compression == COMPRESSION_NONE) {
             // just copy if there's no compression
             memcpy(uncompressed_buf, compressed_buf, csize);
-            if (m_is_byte_swapped && m_spec.format == TypeUInt16)
+            if (byte_swapped && format == TypeUInt16)
                 TIFFSwabArrayOfShort((unsigned short*)uncompressed_buf, nvals);
             return;
         }
@@ -598,20 +622,65 @@ private:
             *ok = false;
             return;
         }
-        if (m_is_byte_swapped && m_spec.format == TypeUInt16)
+        if (byte_swapped && format == TypeUInt16)
             TIFFSwabArrayOfShort((unsigned short*)uncompressed_buf, nvals);
-        if (m_predictor == PREDICTOR_HORIZONTAL) {
-            if (m_spec.format == TypeUInt8)
+        if (predictor == PREDICTOR_HORIZONTAL) {
+            if (format == TypeUInt8)
                 undo_horizontal_predictor((unsigned char*)uncompressed_buf,
                                           (unsigned char*)uncompressed_buf,
                                           channels, width, height);
-            else if (m_spec.format == TypeUInt16)
+            else if (format == TypeUInt16)
                 undo_horizontal_predictor((unsigned short*)uncompressed_buf,
                                           (unsigned short*)uncompressed_buf,
                                           channels, width, height);
         }
     }
 
+    void uncompress_one_strip(const void* compressed_buf, unsigned long csize,
+                              void* uncompressed_buf, size_t strip_bytes,
+                              int channels, int width, int height, bool* ok)
+    {
+        uncompress_raw(compressed_buf, csize, uncompressed_buf, strip_bytes,
+                       channels, width, height, m_compression, m_predictor,
+                       m_spec.format, m_is_byte_swapped, ok);
+    }
+
+    // A still-compressed tile fetched from the file, along with everything
+    // about its subimage needed to decode it after the lock is released.
+    struct RawTile {
+        std::unique_ptr<char[]> cbuf;
+        unsigned long csize = 0;
+        size_t tile_bytes   = 0;
+        int nchannels = 0, width = 0, height = 0;
+        int compression = 0, predictor = 0;
+        TypeDesc format;
+        bool byte_swapped = false;
+    };
+
+    // Can tiles of the current subimage be fetched raw and decompressed by
+    // us rather than by libtiff?
+    bool can_decode_raw_tiles() const
+    {
+        return m_spec.tile_width && m_compression == COMPRESSION_ADOBE_DEFLATE
+               && (m_predictor == PREDICTOR_HORIZONTAL
+                   || m_predictor == PREDICTOR_NONE)
+               && !m_separate && !m_use_rgba_interface
+               && (m_photometric != PHOTOMETRIC_SEPARATED
+                   && m_photometric != PHOTOMETRIC_PALETTE
+                   && m_photometric != PHOTOMETRIC_MINISWHITE)
+               && (m_spec.format == TypeUInt8 || m_spec.format == TypeUInt16)
+               && m_spec.format.size() * 8 == m_bitspersample
+               && m_inputchannels == m_spec.nchannels;
+    }
+
+    // With the lock held, fetch the compressed tile at x,y,z of the current
+    // subimage.
+    bool read_raw_tile(int x, int y, int z, RawTile& raw);
+
+    // Decompress a tile fetched by read_raw_tile. Needs no lock, so several
+    // threads may decode tiles of the same file at once.
+    static bool decode_raw_tile(const RawTile& raw, span<std::byte> data);
+
     int tile_index(int x, int y, int z)
     {
         int xtile   = (x - m_spec.x) / m_spec.tile_width;
@@ -1567,6 +1636,11 @@ TIFFInput::readspec(bool read_meta)
         m_spec.attribute("oiio:SHA-1", sha);
         updatedDesc = true;
     }
+    auto ph = Strutil::excise_string_after_head(desc, "oiio:PixelHash=");
+    if (ph.size()) {
+        m_spec.attribute("oiio:PixelHash", ph);
+        updatedDesc = true;
+    }
     std::string handed = Strutil::excise_string_after_head(desc,
                                                            "oiio:handed=");
     if (handed.size() && (handed == "left" || handed == "right")) {
@@ -2341,6 +2415,68 @@ TIFFInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
 
 
 
+bool
+TIFFInput::read_native_scanlines(int subimage, int miplevel, int ybegin,
+                                 int yend, int z, int chbegin, int chend,
+                                 void* data)
+{
+    lock_guard lock(*this);
+    if (!seek_subimage(subimage, miplevel))
+        return false;
+    chend = clamp(chend, chbegin + 1, m_spec.nchannels);
+    yend  = std::min(yend, m_spec.y + m_spec.height);
+
+    // With "separate" planarconfig, each channel lives in its own strips,
+    // so a channel subset can be read by decoding only those planes,
+    // rather than reading every channel and throwing most of them away.
+    // Anything else goes through the base class, which reads all channels
+    // and copies out the subset.
+    if (!decodes_plane_subsets() || (chbegin == 0 && chend == m_spec.nchannels))
+        return ImageInput::read_native_scanlines(subimage, miplevel, ybegin,
+                                                 yend, z, chbegin, chend,
+                                                 data);
+
+    int nsub             = chend - chbegin;
+    size_t chansize      = m_spec.format.size();
+    size_t plane_ystride = size_t(m_spec.width) * chansize;
+    size_t ystride       = plane_ystride * nsub;
+    int strips_in_file   = (m_spec.height + m_rowsperstrip - 1)
+                         / m_rowsperstrip;
+    std::unique_ptr<char[]> plane(new char[plane_ystride * m_rowsperstrip]);
+    for (int y = ybegin; y < yend;) {
+        tstrip_t strip  = (y - m_spec.y) / m_rowsperstrip;
+        int stripy      = m_spec.y + int(strip) * m_rowsperstrip;
+        int striprows   = std::min(m_rowsperstrip,
+                                   m_spec.y + m_spec.height - stripy);
+        int stripend    = std::min(stripy + striprows, yend);
+        int rows        = stripend - y;
+        const char* src = plane.get() + plane_ystride * (y - stripy);
+        char* dst       = (char*)data + ystride * (y - ybegin);
+        for (int c = chbegin; c < chend; ++c) {
+            tstrip_t stripnum = strip + c * strips_in_file;
+            if (TIFFReadEncodedStrip(m_tif, stripnum, plane.get(),
+                                     tmsize_t(plane_ystride * striprows))
+                < 0) {
+                std::string err = oiio_tiff_last_error();
+                errorfmt("TIFFReadEncodedStrip failed reading line y={}: {}",
+                         y, err.size() ? err.c_str() : "unknown error");
+                return false;
+            }
+            if (m_photometric == PHOTOMETRIC_MINISWHITE)
+                invert_photometric(m_spec.width * striprows, plane.get());
+            copy_image(1, m_spec.width, rows, 1, src, chansize, chansize,
+                       plane_ystride, AutoStride,
+                       dst + (c - chbegin) * chansize, nsub * chansize,
+                       ystride, AutoStride);
+        }
+        y = stripend;
+    }
+    m_next_scanline = yend - m_spec.y;
+    return true;
+}
+
+
+
 bool
 TIFFInput::read_native_tile_locked(int subimage, int miplevel, int x, int y,
                                    int z, span<std::byte> data)
@@ -2477,13 +2613,28 @@ bool
 TIFFInput::read_native_tile(int subimage, int miplevel, int x, int y, int z,
                             void* data)
 {
-    lock_guard lock(*this);
-    if (!seek_subimage(subimage, miplevel))
+    // libtiff is serialized, but for the common zip-compressed tiles we
+    // only need it (and the lock) to fetch the raw bytes. Decompressing
+    // after the lock is released lets threads that are reading different
+    // tiles of the same file, as the ImageCache does, decode them at the
+    // same time rather than taking turns.
+    RawTile raw;
+    {
+        lock_guard lock(*this);
+        if (!seek_subimage(subimage, miplevel))
+            return false;
+        if (!can_decode_raw_tiles()) {
+            auto tile = as_writable_bytes(data, m_spec.tile_bytes(true));
+            return read_native_tile_locked(subimage, miplevel, x, y, z, tile);
+        }
+        if (!read_raw_tile(x, y, z, raw))
+            return false;
+    }
+    if (!decode_raw_tile(raw, as_writable_bytes(data, raw.tile_bytes))) {
+        errorfmt("Failed to decompress tile x={},y={},z={}", x, y, z);
         return false;
-
-    auto native_tile_bytes = m_spec.tile_bytes(true);
-    return read_native_tile_locked(subimage, miplevel, x, y, z,
-                                   as_writable_bytes(data, native_tile_bytes));
+    }
+    return true;
 }
 
 
@@ -2493,21 +2644,67 @@ TIFFInput::read_native_tiles(int subimage, int miplevel, int xbegin, int xend,
                              int ybegin, int yend, int zbegin, int zend,
                              void* data)
 {
-    lock_guard lock(*this);
-    if (!seek_subimage(subimage, miplevel))
-        return false;
-    if (!m_spec.valid_tile_range(xbegin, xend, ybegin, yend, zbegin, zend))
+    {
+        lock_guard lock(*this);
+        if (!seek_subimage(subimage, miplevel))
+            return false;
+        if (!m_spec.valid_tile_range(xbegin, xend, ybegin, yend, zbegin, zend))
+            return false;
+
+        OIIO_DASSERT(m_spec.tile_depth >= 1);
+        size_t ntiles = size_t(
+            (xend - xbegin + m_spec.tile_width - 1) / m_spec.tile_width
+            * (yend - ybegin + m_spec.tile_height - 1) / m_spec.tile_height
+            * (zend - zbegin + m_spec.tile_depth - 1) / m_spec.tile_depth);
+        if (ntiles > 1 || !can_decode_raw_tiles()) {
+            auto native_tile_bytes = m_spec.tile_bytes(true);
+            return read_native_tiles_locked(
+                subimage, miplevel, xbegin, xend, ybegin, yend, zbegin, zend,
+                ntiles, as_writable_bytes(data, ntiles * native_tile_bytes));
+        }
+    }
+    // Just one tile (the usual ImageCache request): decompress it without
+    // holding the lock.
+    return read_native_tile(subimage, miplevel, xbegin, ybegin, zbegin, data);
+}
+
+
+
+bool
+TIFFInput::read_raw_tile(int x, int y, int z, RawTile& raw)
+{
+    raw.tile_bytes   = m_spec.tile_bytes(true);
+    raw.nchannels    = m_spec.nchannels;
+    raw.width        = m_spec.tile_width;
+    raw.height       = m_spec.tile_height * std::max(1, m_spec.tile_depth);
+    raw.compression  = m_compression;
+    raw.predictor    = m_predictor;
+    raw.format       = m_spec.format;
+    raw.byte_swapped = m_is_byte_swapped;
+    size_t cbound    = compressBound((uLong)raw.tile_bytes);
+    raw.cbuf.reset(new char[cbound]);
+    tsize_t csize = TIFFReadRawTile(m_tif, tile_index(x, y, z), raw.cbuf.get(),
+                                    tmsize_t(cbound));
+    if (csize < 0) {
+        std::string err = oiio_tiff_last_error();
+        errorfmt("TIFFReadRawTile failed reading tile x={},y={},z={}: {}", x, y,
+                 z, err.size() ? err.c_str() : "unknown error");
         return false;
+    }
+    raw.csize = (unsigned long)csize;
+    return true;
+}
 
-    OIIO_DASSERT(m_spec.tile_depth >= 1);
-    size_t ntiles = size_t(
-        (xend - xbegin + m_spec.tile_width - 1) / m_spec.tile_width
-        * (yend - ybegin + m_spec.tile_height - 1) / m_spec.tile_height
-        * (zend - zbegin + m_spec.tile_depth - 1) / m_spec.tile_depth);
-    auto native_tile_bytes = m_spec.tile_bytes(true);
-    return read_native_tiles_locked(
-        subimage, miplevel, xbegin, xend, ybegin, yend, zbegin, zend, ntiles,
-        as_writable_bytes(data, ntiles * native_tile_bytes));
+
+
+bool
+TIFFInput::decode_raw_tile(const RawTile& raw, span<std::byte> data)
+{
+    bool ok = true;
+    uncompress_raw(raw.cbuf.get(), raw.csize, data.data(), raw.tile_bytes,
+                   raw.nchannels, raw.width, raw.height, raw.compression,
+                   raw.predictor, raw.format, raw.byte_swapped, &ok);
+    return ok;
 }
 
 
@@ -4,6 +4,8 @@
 # SPDX-License-Identifier: Apache-2.0
 # https://github.com/AcademySoftwareFoundation/OpenImageIO
 
+import os
+
 failureok = 1
 
 outputs = [ ]
@@ -172,6 +174,16 @@ command += oiiotool (" --pattern constant:color=.25,.25,.25,.5 64x64 4 "
 command += maketx_command ("gray64srgb.tif", "gray64linsrgb.tx",
                            "--colorconvert srgb lin_srgb --unpremult")
 
+# Test batch mode: one maketx converts several inputs, naming each output
+# after its input in the -o directory. A missing input fails by itself
+# without stopping the others, and is counted in the summary.
+os.makedirs ("batch", exist_ok=True)
+command += (oiio_app("maketx") + " checker.tif gray.tif pink.tif missing.tif"
+            + " -o batch 2>&1 | grep \"^maketx:\"" + redirect + " ;\n")
+command += info_command ("batch/checker.tx", verbose=False, hash=False)
+command += info_command ("batch/gray.tx", verbose=False, hash=False)
+command += info_command ("batch/pink.tx", verbose=False, hash=False)
+
 outputs += [ "out.txt" ]
 
 
@@ -0,0 +1,10 @@
+#!/usr/bin/env python
+
+# Copyright Contributors to the OpenImageIO project.
+# SPDX-License-Identifier: Apache-2.0
+# https://github.com/AcademySoftwareFoundation/OpenImageIO
+
+
+# The PSD files of the psd-colormodes test cover several color modes.
+imagedir = OIIO_TESTSUITE_ROOT + "/psd-colormodes/src"
+command += pythonbin + " src/test_channel_subsets.py " + imagedir + " > out.txt"
@@ -257,6 +257,23 @@ try:
     print (" from 4D, shape is", b.spec().format, b.roi)
     print ("")
 
+    print ("Zero-copy numpy views:")
+    a = numpy.zeros((3, 2, 4), dtype="f")
+    b = oiio.ImageBuf.wrap(a)
+    a[1,0,:] = (0.25, 0.5, 0.75, 1.0)
+    print (" wrapped array, pixel (0,1) =", b.getpixel(0,1))
+    b.setpixel(1, 2, (1.0, 0.0, 0.0, 1.0))
+    print (" array after setpixel:", a[2,1].tolist())
+    v = numpy.asarray(b)
+    print (" view of wrapped:", v.shape, v.dtype, numpy.shares_memory(v, a))
+    c = oiio.ImageBuf(oiio.ImageSpec(4, 3, 3, "uint8"))
+    v = numpy.asarray(c)
+    v[2,3,:] = 255
+    print (" view of ImageBuf:", v.shape, v.dtype, c.getpixel(3,2))
+    del c
+    print (" view outlives ImageBuf:", v[2,3].tolist())
+    print ("")
+
     # Test reading from disk
     print ("Testing read of ../common/textures/grid.tx:")
     b = oiio.ImageBuf ("../common/textures/grid.tx")
@@ -58,6 +58,40 @@ diff = oiio.ImageBufAlgo.compare(checker_buf, render_buf, 0, 0)
 
 print("top mip pixel differences when streaming =", diff.nfail)
 
+# The same lookups, all at once from numpy arrays
+ys, xs = numpy.mgrid[0:512, 0:512]
+batch_pixels = texture_sys.texture_batch(checker, texture_opt,
+                                         (xs.ravel() + 0.5) / 512.0,
+                                         (ys.ravel() + 0.5) / 512.0,
+                                         nchannels=3)
+print("batch lookup shape =", batch_pixels.shape)
+print("batch lookup matches single lookups =",
+      numpy.array_equal(batch_pixels, numpy.array(image_pixels, dtype=numpy.float32)))
+
+# texture3d and environment lookups from numpy arrays, against the same
+# lookups one at a time
+zero = (0.0, 0.0, 0.0)
+points = numpy.array([((x + 0.5) / 16.0, (y + 0.5) / 16.0, 0.5)
+                      for y in range(16) for x in range(16)],
+                     dtype=numpy.float32)
+single3d = [texture_sys.texture3d(checker, texture_opt, tuple(p), zero, zero, zero, 3)
+            for p in points]
+batch3d = texture_sys.texture3d_batch(checker, texture_opt, points, nchannels=3)
+print("texture3d batch lookup shape =", batch3d.shape)
+print("texture3d batch lookup matches single lookups =",
+      numpy.array_equal(batch3d, numpy.array(single3d, dtype=numpy.float32)))
+
+theta, phi = numpy.mgrid[0.1:3.1:12j, 0.0:6.2:24j]
+directions = numpy.stack((numpy.sin(theta) * numpy.cos(phi),
+                          numpy.sin(theta) * numpy.sin(phi),
+                          numpy.cos(theta)), axis=-1).reshape(-1, 3).astype(numpy.float32)
+singleenv = [texture_sys.environment(checker, texture_opt, tuple(R), zero, zero, 3)
+             for R in directions]
+batchenv = texture_sys.environment_batch(checker, texture_opt, directions, nchannels=3)
+print("environment batch lookup shape =", batchenv.shape)
+print("environment batch lookup matches single lookups =",
+      numpy.array_equal(batchenv, numpy.array(singleenv, dtype=numpy.float32)))
+
 print ("")
 
 # Test udim